@@ -0,0 +1,191 @@
+#pragma once
+
+/*
+    Name: Biquad_cascade.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#ifdef ARM_MATH_CM4
+#include <arm_math.h>
+#endif // ARM_MATH_CM4
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/dsp/fixed_point.hpp>
+
+namespace cml {
+namespace dsp {
+
+/*
+    Cascade of direct form I biquads, same arithmetic as the CMSIS arm_biquad_cascade_df1_q15/q31 kernels
+    (used on the Cortex-M4):
+    y[n] = (b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] + a1 * y[n-1] + a2 * y[n-2]) << post_shift
+    Note the sign of a1 and a2 (negated comparing to the usual 1 + a1 * z^-1 + a2 * z^-2 denominator).
+    Coefficients in the range [-2^post_shift, 2^post_shift) are scaled by 2^-post_shift, q15 outputs saturate.
+    Input and output may be the same buffer.
+    Cortex-M4 builds compile externals/CMSIS/DSP_Lib/Source/FilteringFunctions/arm_biquad_cascade_df1_q15.c
+    and arm_biquad_cascade_df1_q31.c.
+*/
+template<typename Type_t, uint32_t stages>
+class Biquad_cascade
+{
+public:
+
+    struct Coefficients
+    {
+        Type_t b0 = 0;
+        Type_t b1 = 0;
+        Type_t b2 = 0;
+        Type_t a1 = 0;
+        Type_t a2 = 0;
+    };
+
+public:
+
+    Biquad_cascade()
+        : post_shift(0)
+        , coefficients{}
+        , state{}
+    {
+        static_assert(stages > 0, "at least one stage is needed");
+    }
+
+    Biquad_cascade(Biquad_cascade&&)      = default;
+    Biquad_cascade(const Biquad_cascade&) = default;
+    ~Biquad_cascade()                     = default;
+
+    Biquad_cascade& operator = (Biquad_cascade&&)      = default;
+    Biquad_cascade& operator = (const Biquad_cascade&) = default;
+
+    void set_coefficients(const Coefficients* a_p_coefficients, uint32_t a_post_shift)
+    {
+        assert(nullptr != a_p_coefficients);
+        assert(a_post_shift < fixed_point<Type_t>::fraction_bits);
+
+        this->post_shift = a_post_shift;
+
+        for (uint32_t i = 0; i < stages; i++)
+        {
+            Type_t* p_stage = &(this->coefficients[i * coefficients_per_stage]);
+
+            *(p_stage++) = a_p_coefficients[i].b0;
+
+            if (6 == coefficients_per_stage)
+            {
+                *(p_stage++) = 0;
+            }
+
+            *(p_stage++) = a_p_coefficients[i].b1;
+            *(p_stage++) = a_p_coefficients[i].b2;
+            *(p_stage++) = a_p_coefficients[i].a1;
+            *(p_stage++) = a_p_coefficients[i].a2;
+        }
+
+        this->reset();
+    }
+
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count)
+    {
+        assert(nullptr != a_p_input);
+        assert(nullptr != a_p_output);
+
+#ifdef ARM_MATH_CM4
+        this->process_cmsis(a_p_input, a_p_output, a_count);
+#else
+        const Type_t* p_input = a_p_input;
+        const uint32_t shift  = fixed_point<Type_t>::fraction_bits - this->post_shift;
+
+        for (uint32_t s = 0; s < stages; s++)
+        {
+            const Type_t* p_coefficients = &(this->coefficients[s * coefficients_per_stage]);
+            Type_t* p_state              = &(this->state[s * 4]);
+
+            const Type_t b0 = p_coefficients[0];
+            const Type_t b1 = p_coefficients[coefficients_per_stage - 4];
+            const Type_t b2 = p_coefficients[coefficients_per_stage - 3];
+            const Type_t a1 = p_coefficients[coefficients_per_stage - 2];
+            const Type_t a2 = p_coefficients[coefficients_per_stage - 1];
+
+            for (uint32_t i = 0; i < a_count; i++)
+            {
+                const Type_t x = p_input[i];
+
+                const int64_t accumulator = static_cast<int64_t>(b0) * x +
+                                            static_cast<int64_t>(b1) * p_state[0] +
+                                            static_cast<int64_t>(b2) * p_state[1] +
+                                            static_cast<int64_t>(a1) * p_state[2] +
+                                            static_cast<int64_t>(a2) * p_state[3];
+
+                const Type_t y = this->get_output(accumulator >> shift);
+
+                p_state[1] = p_state[0];
+                p_state[0] = x;
+                p_state[3] = p_state[2];
+                p_state[2] = y;
+
+                a_p_output[i] = y;
+            }
+
+            p_input = a_p_output;
+        }
+#endif // ARM_MATH_CM4
+
+        return a_count;
+    }
+
+    void reset()
+    {
+        for (uint32_t i = 0; i < stages * 4; i++)
+        {
+            this->state[i] = 0;
+        }
+    }
+
+private:
+
+#ifdef ARM_MATH_CM4
+    void process_cmsis(const q15* a_p_input, q15* a_p_output, uint32_t a_count)
+    {
+        arm_biquad_casd_df1_inst_q15 instance = { static_cast<int8_t>(stages),
+                                                  this->state,
+                                                  this->coefficients,
+                                                  static_cast<int8_t>(this->post_shift) };
+
+        arm_biquad_cascade_df1_q15(&instance, const_cast<q15*>(a_p_input), a_p_output, a_count);
+    }
+
+    void process_cmsis(const q31* a_p_input, q31* a_p_output, uint32_t a_count)
+    {
+        arm_biquad_casd_df1_inst_q31 instance = { stages,
+                                                  this->state,
+                                                  this->coefficients,
+                                                  static_cast<uint8_t>(this->post_shift) };
+
+        arm_biquad_cascade_df1_q31(&instance, const_cast<q31*>(a_p_input), a_p_output, a_count);
+    }
+#else
+    static constexpr Type_t get_output(int64_t a_value)
+    {
+        return 2 == sizeof(Type_t) ? fixed_point<Type_t>::saturate(a_value) : static_cast<Type_t>(a_value);
+    }
+#endif // ARM_MATH_CM4
+
+private:
+
+    // CMSIS layout, q15 stages have a padding 0 after b0 (SIMD)
+    static constexpr uint32_t coefficients_per_stage = 2 == sizeof(Type_t) ? 6 : 5;
+
+    uint32_t post_shift;
+
+    alignas(4) Type_t coefficients[stages * coefficients_per_stage];
+    alignas(4) Type_t state[stages * 4];
+};
+
+} // namespace dsp
+} // namespace cml
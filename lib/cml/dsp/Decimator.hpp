@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+    Name: Decimator.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace cml {
+namespace dsp {
+
+/*
+    Keeps every factor-th sample, the phase is preserved between blocks. Put a low-pass stage (Moving_average,
+    Biquad_cascade) before it. Returns the number of output samples, input and output may be the same buffer.
+*/
+template<typename Type_t, uint32_t factor>
+class Decimator
+{
+public:
+
+    Decimator()
+        : phase(0)
+    {
+        static_assert(factor > 1, "factor has to be greater than 1");
+    }
+
+    Decimator(Decimator&&)      = default;
+    Decimator(const Decimator&) = default;
+    ~Decimator()                = default;
+
+    Decimator& operator = (Decimator&&)      = default;
+    Decimator& operator = (const Decimator&) = default;
+
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count)
+    {
+        assert(nullptr != a_p_input);
+        assert(nullptr != a_p_output);
+
+        uint32_t ret = 0;
+
+        for (uint32_t i = (factor - this->phase) % factor; i < a_count; i += factor)
+        {
+            a_p_output[ret++] = a_p_input[i];
+        }
+
+        this->phase = (this->phase + a_count) % factor;
+
+        return ret;
+    }
+
+    void reset()
+    {
+        this->phase = 0;
+    }
+
+private:
+
+    uint32_t phase;
+};
+
+} // namespace dsp
+} // namespace cml
@@ -0,0 +1,127 @@
+#pragma once
+
+/*
+    Name: Median.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace cml {
+namespace dsp {
+
+/*
+    Running median of the last window samples (odd, small windows). The window is kept twice: in arrival order
+    (ring) and sorted, every sample removes the oldest value from the sorted array and inserts the new one,
+    O(window) per sample with no sorting. Until the window fills up the median of the received samples is returned.
+    Input and output may be the same buffer.
+*/
+template<typename Type_t, uint32_t window>
+class Median
+{
+public:
+
+    Median()
+        : index(0)
+        , count(0)
+        , ring{}
+        , sorted{}
+    {
+        static_assert(window > 2 && window <= 63 && 1 == (window & 0x1u), "window has to be odd, 3 - 63");
+    }
+
+    Median(Median&&)      = default;
+    Median(const Median&) = default;
+    ~Median()             = default;
+
+    Median& operator = (Median&&)      = default;
+    Median& operator = (const Median&) = default;
+
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count)
+    {
+        assert(nullptr != a_p_input);
+        assert(nullptr != a_p_output);
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            const Type_t sample = a_p_input[i];
+            uint32_t position   = this->count;
+
+            if (window == this->count)
+            {
+                position = this->find(this->ring[this->index]);
+            }
+            else
+            {
+                this->count++;
+            }
+
+            while (position > 0 && this->sorted[position - 1] > sample)
+            {
+                this->sorted[position] = this->sorted[position - 1];
+                position--;
+            }
+
+            while (position + 1 < this->count && this->sorted[position + 1] < sample)
+            {
+                this->sorted[position] = this->sorted[position + 1];
+                position++;
+            }
+
+            this->sorted[position]   = sample;
+            this->ring[this->index] = sample;
+            this->index             = window - 1 == this->index ? 0 : this->index + 1;
+
+            a_p_output[i] = this->sorted[this->count / 2];
+        }
+
+        return a_count;
+    }
+
+    void reset()
+    {
+        this->index = 0;
+        this->count = 0;
+    }
+
+private:
+
+    uint32_t find(const Type_t& a_value) const
+    {
+        uint32_t first = 0;
+        uint32_t last  = window - 1;
+
+        while (first < last)
+        {
+            const uint32_t middle = (first + last) / 2;
+
+            if (this->sorted[middle] < a_value)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+
+        return first;
+    }
+
+private:
+
+    uint32_t index;
+    uint32_t count;
+
+    Type_t ring[window];
+    Type_t sorted[window];
+};
+
+} // namespace dsp
+} // namespace cml
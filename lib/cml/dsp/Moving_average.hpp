@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+    Name: Moving_average.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/dsp/fixed_point.hpp>
+
+namespace cml {
+namespace dsp {
+
+/*
+    Boxcar average of the last window samples, O(1) per sample (running sum). The window is a power of two,
+    so the division is a shift. Input and output may be the same buffer.
+*/
+template<typename Type_t, uint32_t window>
+class Moving_average
+{
+public:
+
+    Moving_average()
+        : sum(0)
+        , index(0)
+        , history{}
+    {
+        static_assert(window > 1 && 0 == (window & (window - 1)), "window has to be a power of two");
+    }
+
+    Moving_average(Moving_average&&)      = default;
+    Moving_average(const Moving_average&) = default;
+    ~Moving_average()                     = default;
+
+    Moving_average& operator = (Moving_average&&)      = default;
+    Moving_average& operator = (const Moving_average&) = default;
+
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count)
+    {
+        assert(nullptr != a_p_input);
+        assert(nullptr != a_p_output);
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            const Type_t sample = a_p_input[i];
+
+            this->sum += static_cast<Accumulator>(sample) - this->history[this->index];
+            this->history[this->index] = sample;
+            this->index                = (this->index + 1) & (window - 1);
+
+            a_p_output[i] = static_cast<Type_t>(this->sum >> shift);
+        }
+
+        return a_count;
+    }
+
+    void reset()
+    {
+        this->sum   = 0;
+        this->index = 0;
+
+        for (uint32_t i = 0; i < window; i++)
+        {
+            this->history[i] = 0;
+        }
+    }
+
+private:
+
+    using Accumulator = typename fixed_point<Type_t>::Accumulator;
+
+    static constexpr uint32_t get_shift()
+    {
+        uint32_t ret = 0;
+
+        while ((1u << ret) < window)
+        {
+            ret++;
+        }
+
+        return ret;
+    }
+
+private:
+
+    static constexpr uint32_t shift = get_shift();
+
+    Accumulator sum;
+    uint32_t index;
+
+    Type_t history[window];
+};
+
+} // namespace dsp
+} // namespace cml
@@ -0,0 +1,91 @@
+#pragma once
+
+/*
+    Name: Pipeline.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+namespace cml {
+namespace dsp {
+
+/*
+    Chain of block stages (Moving_average, Biquad_cascade, Median, Decimator, ...). Every stage provides
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count) returning the output count
+    and supports in place processing. The first stage reads the input buffer, the rest work in place in the
+    output buffer, so no scratch memory is needed.
+
+    Pipeline<Median<q15, 5>, Biquad_cascade<q15, 2>, Decimator<q15, 4>> pipeline;
+    pipeline.get<1>().set_coefficients(coefficients, 1);
+    uint32_t count = pipeline.process(p_samples, p_filtered, samples_count);
+*/
+template<typename... Stages_t>
+class Pipeline
+{
+public:
+
+    template<typename Type_t>
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count)
+    {
+        for (uint32_t i = 0; i < a_count && a_p_input != a_p_output; i++)
+        {
+            a_p_output[i] = a_p_input[i];
+        }
+
+        return a_count;
+    }
+
+    void reset() {}
+};
+
+template<typename Stage_t, typename... Next_t>
+class Pipeline<Stage_t, Next_t...>
+{
+public:
+
+    Pipeline()                = default;
+    Pipeline(Pipeline&&)      = default;
+    Pipeline(const Pipeline&) = default;
+    ~Pipeline()               = default;
+
+    Pipeline& operator = (Pipeline&&)      = default;
+    Pipeline& operator = (const Pipeline&) = default;
+
+    template<typename Type_t>
+    uint32_t process(const Type_t* a_p_input, Type_t* a_p_output, uint32_t a_count)
+    {
+        const uint32_t count = this->stage.process(a_p_input, a_p_output, a_count);
+        return this->next.process(a_p_output, a_p_output, count);
+    }
+
+    void reset()
+    {
+        this->stage.reset();
+        this->next.reset();
+    }
+
+    template<uint32_t index>
+    auto& get()
+    {
+        if constexpr (0 == index)
+        {
+            return this->stage;
+        }
+        else
+        {
+            return this->next.template get<index - 1>();
+        }
+    }
+
+private:
+
+    Stage_t stage;
+    Pipeline<Next_t...> next;
+};
+
+} // namespace dsp
+} // namespace cml
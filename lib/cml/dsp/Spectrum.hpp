@@ -0,0 +1,406 @@
+#pragma once
+
+/*
+    Name: Spectrum.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#ifdef ARM_MATH_CM4
+#include <arm_math.h>
+#endif // ARM_MATH_CM4
+
+//cml
+#include <cml/frequency.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/dsp/fixed_point.hpp>
+
+namespace cml {
+namespace dsp {
+
+enum class Window : uint32_t
+{
+    rectangular,
+    hann,
+    hamming
+};
+
+/*
+    Magnitude spectrum of blocks of size real q15 samples: window, real FFT, size / 2 magnitude bins
+    (bin k at k * sample_rate / size). A sine of amplitude A (q15) centered in a bin gives a magnitude of
+    A * window coherent gain (1 rectangular, 0.5 hann, 0.54 hamming), DC bins are doubled and saturate.
+    Cortex-M4: CMSIS arm_rfft_q15 and arm_cmplx_mag_q15. Elsewhere: radix-2 size / 2 points complex FFT of the
+    even/odd packed samples with a split step, scaled by 1/2 in every stage. Window and twiddle tables are
+    computed at compile time (flash), RAM: 3.5 * size q15 and the arm_rfft_instance_q15 (CMSIS)
+    or 1.5 * size q15 (portable).
+    Cortex-M4 builds compile arm_rfft_q15.c, arm_rfft_init_q15.c, arm_cfft_radix4_q15.c, arm_bitreversal.c
+    (TransformFunctions), arm_cmplx_mag_q15.c (ComplexMathFunctions) and CommonTables from
+    externals/CMSIS/DSP_Lib/Source.
+*/
+template<uint32_t size, Window window = Window::hann>
+class Spectrum
+{
+public:
+
+    struct Peak
+    {
+        uint32_t bin  = 0;
+        q15 magnitude = 0;
+    };
+
+public:
+
+    Spectrum()
+        : work{}
+        , magnitudes{}
+    {
+        static_assert(size >= 32 && size <= 4096 && 0 == (size & (size - 1)), "size has to be a power of two, 32 - 4096");
+
+#ifdef ARM_MATH_CM4
+        const arm_status status = arm_rfft_init_q15(&(this->instance), size, 0, 1);
+        assert(ARM_MATH_SUCCESS == status);
+        static_cast<void>(status);
+#endif // ARM_MATH_CM4
+    }
+
+    Spectrum(Spectrum&&)      = delete;
+    Spectrum(const Spectrum&) = delete;
+    ~Spectrum()               = default;
+
+    Spectrum& operator = (Spectrum&&)      = delete;
+    Spectrum& operator = (const Spectrum&) = delete;
+
+    void process(const q15* a_p_samples)
+    {
+        assert(nullptr != a_p_samples);
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            this->work[i] = a_p_samples[i];
+        }
+
+        this->transform();
+    }
+
+    // right aligned, unsigned ADC samples, the mid-scale offset is removed
+    void process(const uint16_t* a_p_samples, uint32_t a_resolution_bits)
+    {
+        assert(nullptr != a_p_samples);
+        assert(a_resolution_bits > 0 && a_resolution_bits <= 16);
+
+        const int32_t offset = 1 << (a_resolution_bits - 1);
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            this->work[i] = static_cast<q15>((a_p_samples[i] - offset) * (1 << (16 - a_resolution_bits)));
+        }
+
+        this->transform();
+    }
+
+    // local maxima above a_threshold, highest first, returns the number of peaks found
+    uint32_t find_peaks(Peak* a_p_peaks, uint32_t a_capacity, q15 a_threshold) const
+    {
+        assert(nullptr != a_p_peaks);
+        assert(a_capacity > 0);
+
+        uint32_t ret = 0;
+
+        for (uint32_t i = 1; i < bins; i++)
+        {
+            const q15 magnitude = this->magnitudes[i];
+
+            if (magnitude > a_threshold &&
+                magnitude > this->magnitudes[i - 1] &&
+                (bins - 1 == i || magnitude >= this->magnitudes[i + 1]))
+            {
+                uint32_t position = ret < a_capacity ? ret++ : a_capacity;
+
+                while (position > 0 && a_p_peaks[position - 1].magnitude < magnitude)
+                {
+                    if (position < a_capacity)
+                    {
+                        a_p_peaks[position] = a_p_peaks[position - 1];
+                    }
+
+                    position--;
+                }
+
+                if (position < a_capacity)
+                {
+                    a_p_peaks[position] = { i, magnitude };
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    const q15* get_magnitudes() const
+    {
+        return this->magnitudes;
+    }
+
+    q15 get_magnitude(uint32_t a_bin) const
+    {
+        assert(a_bin < bins);
+        return this->magnitudes[a_bin];
+    }
+
+    static constexpr frequency get_bin_frequency_hz(frequency a_sample_rate_hz, uint32_t a_bin)
+    {
+        return static_cast<frequency>((static_cast<uint64_t>(a_sample_rate_hz) * a_bin + size / 2) / size);
+    }
+
+public:
+
+    static constexpr uint32_t bins = size / 2;
+
+private:
+
+    struct Table
+    {
+        q15 window_coefficients[size];
+        q15 sine[size / 4 + 1]; // sin(2 * pi * i / size)
+    };
+
+    static constexpr double pi = 3.14159265358979323846;
+
+    static constexpr double sine(double a_x)
+    {
+        while (a_x > pi)
+        {
+            a_x -= 2 * pi;
+        }
+
+        while (a_x < -pi)
+        {
+            a_x += 2 * pi;
+        }
+
+        a_x = a_x > pi / 2 ? pi - a_x : a_x < -pi / 2 ? -pi - a_x : a_x;
+
+        double term = a_x;
+        double ret  = a_x;
+
+        for (uint32_t i = 1; i < 12; i++)
+        {
+            term *= -a_x * a_x / static_cast<double>((2 * i) * (2 * i + 1));
+            ret  += term;
+        }
+
+        return ret;
+    }
+
+    static constexpr q15 to_q15(double a_value)
+    {
+        return fixed_point<q15>::saturate(static_cast<int64_t>(a_value * 32768.0 + (a_value >= 0 ? 0.5 : -0.5)));
+    }
+
+    static constexpr Table get_table()
+    {
+        Table ret = {};
+
+        for (uint32_t i = 0; i < size; i++)
+        {
+            const double s = sine(pi * i / size);
+
+            switch (window)
+            {
+                case Window::rectangular:
+                {
+                    ret.window_coefficients[i] = to_q15(1.0);
+                }
+                break;
+
+                case Window::hann:
+                {
+                    ret.window_coefficients[i] = to_q15(s * s);
+                }
+                break;
+
+                case Window::hamming:
+                {
+                    ret.window_coefficients[i] = to_q15(0.08 + 0.92 * s * s);
+                }
+                break;
+            }
+        }
+
+        for (uint32_t i = 0; i <= size / 4; i++)
+        {
+            ret.sine[i] = to_q15(sine(2 * pi * i / size));
+        }
+
+        return ret;
+    }
+
+#ifdef ARM_MATH_CM4
+    void transform()
+    {
+        if (Window::rectangular != window)
+        {
+            arm_mult_q15(this->work, const_cast<q15*>(table.window_coefficients), this->work, size);
+        }
+
+        arm_rfft_q15(&(this->instance), this->work, this->spectrum);
+        arm_cmplx_mag_q15(this->spectrum, this->magnitudes, bins);
+        arm_shift_q15(this->magnitudes, 1, this->magnitudes, bins);
+    }
+#else
+    // angle 2 * pi * a_index / size, a_index in [0, size / 2]
+    static int32_t get_cos(uint32_t a_index)
+    {
+        return a_index <= size / 4 ? table.sine[size / 4 - a_index] : -table.sine[a_index - size / 4];
+    }
+
+    static int32_t get_sin(uint32_t a_index)
+    {
+        return a_index <= size / 4 ? table.sine[a_index] : table.sine[size / 2 - a_index];
+    }
+
+    static q15 get_modulus(int32_t a_real, int32_t a_imag)
+    {
+        const uint32_t real = static_cast<uint32_t>(a_real < 0 ? -a_real : a_real);
+        const uint32_t imag = static_cast<uint32_t>(a_imag < 0 ? -a_imag : a_imag);
+
+        uint32_t ret = numeric_traits<q15>::get_max();
+
+        if (real <= 0x7FFFu && imag <= 0x7FFFu)
+        {
+            const uint32_t square = real * real + imag * imag;
+
+            uint32_t bit = 1u << 30u;
+            ret          = 0;
+
+            while (bit > square)
+            {
+                bit >>= 2u;
+            }
+
+            for (uint32_t rest = square; 0 != bit; bit >>= 2u)
+            {
+                if (rest >= ret + bit)
+                {
+                    rest -= ret + bit;
+                    ret   = (ret >> 1u) + bit;
+                }
+                else
+                {
+                    ret >>= 1u;
+                }
+            }
+        }
+
+        return fixed_point<q15>::saturate(ret);
+    }
+
+    void transform()
+    {
+        constexpr uint32_t points = size / 2;
+
+        q15* p_data = this->work;
+
+        if (Window::rectangular != window)
+        {
+            for (uint32_t i = 0; i < size; i++)
+            {
+                p_data[i] = static_cast<q15>((static_cast<int32_t>(p_data[i]) * table.window_coefficients[i]) >> 15);
+            }
+        }
+
+        for (uint32_t i = 1, j = 0; i < points; i++)
+        {
+            uint32_t bit = points >> 1u;
+
+            for (; 0 != (j & bit); bit >>= 1u)
+            {
+                j ^= bit;
+            }
+
+            j ^= bit;
+
+            if (i < j)
+            {
+                const q15 real = p_data[2 * i];
+                const q15 imag = p_data[2 * i + 1];
+
+                p_data[2 * i]     = p_data[2 * j];
+                p_data[2 * i + 1] = p_data[2 * j + 1];
+                p_data[2 * j]     = real;
+                p_data[2 * j + 1] = imag;
+            }
+        }
+
+        for (uint32_t length = 2; length <= points; length <<= 1u)
+        {
+            const uint32_t step = size / length;
+
+            for (uint32_t first = 0; first < points; first += length)
+            {
+                for (uint32_t k = 0; k < length / 2; k++)
+                {
+                    const int32_t c = get_cos(k * step);
+                    const int32_t s = get_sin(k * step);
+
+                    q15* p_a = &(p_data[2 * (first + k)]);
+                    q15* p_b = &(p_data[2 * (first + k + length / 2)]);
+
+                    // (b_real + j b_imag) * (c - j s)
+                    const int32_t t_real = (p_b[0] * c + p_b[1] * s) >> 15;
+                    const int32_t t_imag = (p_b[1] * c - p_b[0] * s) >> 15;
+
+                    const int32_t a_real = p_a[0];
+                    const int32_t a_imag = p_a[1];
+
+                    p_a[0] = static_cast<q15>((a_real + t_real) >> 1);
+                    p_a[1] = static_cast<q15>((a_imag + t_imag) >> 1);
+                    p_b[0] = static_cast<q15>((a_real - t_real) >> 1);
+                    p_b[1] = static_cast<q15>((a_imag - t_imag) >> 1);
+                }
+            }
+        }
+
+        this->magnitudes[0] = get_modulus(p_data[0] + p_data[1], 0);
+
+        for (uint32_t k = 1; k < bins; k++)
+        {
+            const int32_t a_real = p_data[2 * k];
+            const int32_t a_imag = p_data[2 * k + 1];
+            const int32_t b_real = p_data[2 * (points - k)];
+            const int32_t b_imag = -p_data[2 * (points - k) + 1];
+
+            const int32_t even_real = (a_real + b_real) >> 1;
+            const int32_t even_imag = (a_imag + b_imag) >> 1;
+            const int32_t odd_real  = (a_imag - b_imag) >> 1;
+            const int32_t odd_imag  = (b_real - a_real) >> 1;
+
+            const int32_t c = get_cos(k);
+            const int32_t s = get_sin(k);
+
+            this->magnitudes[k] = get_modulus(even_real + ((odd_real * c + odd_imag * s) >> 15),
+                                              even_imag + ((odd_imag * c - odd_real * s) >> 15));
+        }
+    }
+#endif // ARM_MATH_CM4
+
+private:
+
+    static constexpr Table table = get_table();
+
+#ifdef ARM_MATH_CM4
+    arm_rfft_instance_q15 instance;
+    q15 spectrum[size * 2];
+#endif // ARM_MATH_CM4
+
+    q15 work[size];
+    q15 magnitudes[bins];
+};
+
+} // namespace dsp
+} // namespace cml
@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+    Name: fixed_point.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/numeric_traits.hpp>
+
+namespace cml {
+namespace dsp {
+
+using q15 = int16_t;
+using q31 = int32_t;
+
+template<typename Type_t>
+class fixed_point
+{
+public:
+
+    fixed_point()                   = delete;
+    fixed_point(fixed_point&&)      = delete;
+    fixed_point(const fixed_point&) = delete;
+    ~fixed_point()                  = delete;
+
+    fixed_point& operator = (fixed_point&&)      = delete;
+    fixed_point& operator = (const fixed_point&) = delete;
+};
+
+template<>
+class fixed_point<q15>
+{
+public:
+
+    using Accumulator = int64_t;
+
+    fixed_point()                   = delete;
+    fixed_point(fixed_point&&)      = delete;
+    fixed_point(const fixed_point&) = delete;
+    ~fixed_point()                  = delete;
+
+    fixed_point& operator = (fixed_point&&)      = delete;
+    fixed_point& operator = (const fixed_point&) = delete;
+
+    static constexpr q15 saturate(int64_t a_value)
+    {
+        return static_cast<q15>(a_value > numeric_traits<q15>::get_max() ? numeric_traits<q15>::get_max() :
+                                a_value < numeric_traits<q15>::get_min() ? numeric_traits<q15>::get_min() :
+                                a_value);
+    }
+
+    static constexpr q15 from_float(float a_value)
+    {
+        return saturate(static_cast<int64_t>(a_value * 32768.0f + (a_value >= 0.0f ? 0.5f : -0.5f)));
+    }
+
+public:
+
+    static constexpr uint32_t fraction_bits = 15;
+};
+
+template<>
+class fixed_point<q31>
+{
+public:
+
+    using Accumulator = int64_t;
+
+    fixed_point()                   = delete;
+    fixed_point(fixed_point&&)      = delete;
+    fixed_point(const fixed_point&) = delete;
+    ~fixed_point()                  = delete;
+
+    fixed_point& operator = (fixed_point&&)      = delete;
+    fixed_point& operator = (const fixed_point&) = delete;
+
+    static constexpr q31 saturate(int64_t a_value)
+    {
+        return static_cast<q31>(a_value > numeric_traits<q31>::get_max() ? numeric_traits<q31>::get_max() :
+                                a_value < numeric_traits<q31>::get_min() ? numeric_traits<q31>::get_min() :
+                                a_value);
+    }
+
+    static constexpr q31 from_float(float a_value)
+    {
+        return saturate(static_cast<int64_t>(static_cast<double>(a_value) * 2147483648.0 + (a_value >= 0.0f ? 0.5 : -0.5)));
+    }
+
+public:
+
+    static constexpr uint32_t fraction_bits = 31;
+};
+
+} // namespace dsp
+} // namespace cml
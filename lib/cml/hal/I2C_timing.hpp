@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Name: I2C_timing.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <soc/I2C_timing.hpp>
+
+namespace cml {
+namespace hal {
+
+using I2C_timing = soc::I2C_timing;
+
+} // namespace hal
+} // namespace cml
@@ -0,0 +1,25 @@
+#pragma once
+
+/*
+    Name: Basic_timer.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#ifdef STM32L452xx
+#include <soc/stm32l452xx/peripherals/Basic_timer.hpp>
+#endif // STM32L452xx
+
+namespace cml {
+namespace hal {
+namespace peripherals {
+
+#ifdef STM32L452xx
+using Basic_timer = soc::stm32l452xx::peripherals::Basic_timer;
+#endif // STM32L452xx
+
+} // namespace peripherals
+} // namespace hal
+} // namespace cml
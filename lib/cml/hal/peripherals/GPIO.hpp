@@ -22,11 +22,19 @@ namespace peripherals {
 #ifdef STM32L452xx
 using GPIO = soc::stm32l452xx::peripherals::GPIO;
 using pin  = soc::stm32l452xx::peripherals::pin;
+
+template<GPIO::Id port_id, uint32_t id> using Static_out = soc::stm32l452xx::peripherals::Static_out<port_id, id>;
+template<GPIO::Id port_id, uint32_t id> using Static_in  = soc::stm32l452xx::peripherals::Static_in<port_id, id>;
+template<typename... Pins_t> inline constexpr bool unique_pins_v = soc::stm32l452xx::peripherals::unique_pins_v<Pins_t...>;
 #endif // STM32L452xx
 
 #ifdef STM32L011xx
 using GPIO = soc::stm32l011xx::peripherals::GPIO;
 using pin  = soc::stm32l011xx::peripherals::pin;
+
+template<GPIO::Id port_id, uint32_t id> using Static_out = soc::stm32l011xx::peripherals::Static_out<port_id, id>;
+template<GPIO::Id port_id, uint32_t id> using Static_in  = soc::stm32l011xx::peripherals::Static_in<port_id, id>;
+template<typename... Pins_t> inline constexpr bool unique_pins_v = soc::stm32l011xx::peripherals::unique_pins_v<Pins_t...>;
 #endif // STM32L011xx
 
 } // namespace peripherals
@@ -0,0 +1,25 @@
+#pragma once
+
+/*
+    Name: I2C_scheduler.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#ifdef STM32L452xx
+#include <soc/stm32l452xx/peripherals/I2C_scheduler.hpp>
+#endif // STM32L452xx
+
+namespace cml {
+namespace hal {
+namespace peripherals {
+
+#ifdef STM32L452xx
+using I2C_scheduler = soc::stm32l452xx::peripherals::I2C_scheduler;
+#endif // STM32L452xx
+
+} // namespace peripherals
+} // namespace hal
+} // namespace cml
@@ -0,0 +1,37 @@
+#pragma once
+
+/*
+    Name: TIM.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#ifdef STM32L452xx
+#include <soc/stm32l452xx/peripherals/TIM.hpp>
+#include <soc/stm32l452xx/peripherals/LPTIM.hpp>
+#endif // STM32L452xx
+
+#ifdef STM32L011xx
+#include <soc/stm32l011xx/peripherals/TIM.hpp>
+#include <soc/stm32l011xx/peripherals/LPTIM.hpp>
+#endif // STM32L011xx
+
+namespace cml {
+namespace hal {
+namespace peripherals {
+
+#ifdef STM32L452xx
+using TIM   = soc::stm32l452xx::peripherals::TIM;
+using LPTIM = soc::stm32l452xx::peripherals::LPTIM;
+#endif // STM32L452xx
+
+#ifdef STM32L011xx
+using TIM   = soc::stm32l011xx::peripherals::TIM;
+using LPTIM = soc::stm32l011xx::peripherals::LPTIM;
+#endif // STM32L011xx
+
+} // namespace peripherals
+} // namespace hal
+} // namespace cml
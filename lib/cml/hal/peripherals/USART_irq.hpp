@@ -0,0 +1,26 @@
+#pragma once
+
+/*
+    Name: USART_irq.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#ifdef STM32L452xx
+#include <soc/stm32l452xx/peripherals/USART_irq.hpp>
+#endif // STM32L452xx
+
+namespace cml {
+namespace hal {
+namespace peripherals {
+
+#ifdef STM32L452xx
+template<soc::stm32l452xx::peripherals::USART::Id id, typename Handle_t>
+using USART_irq = soc::stm32l452xx::peripherals::USART_irq<id, Handle_t>;
+#endif // STM32L452xx
+
+} // namespace peripherals
+} // namespace hal
+} // namespace cml
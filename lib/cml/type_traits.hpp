@@ -19,4 +19,16 @@ bool is_pod()
 
 #endif // GNUG
 
+template<typename Type_1_t, typename Type_2_t>
+struct is_same
+{
+    static constexpr bool value = false;
+};
+
+template<typename Type_t>
+struct is_same<Type_t, Type_t>
+{
+    static constexpr bool value = true;
+};
+
 } // namespace cml
\ No newline at end of file
@@ -0,0 +1,137 @@
+#pragma once
+
+/*
+    Name: ADC_converter.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/hal/peripherals/ADC.hpp>
+
+namespace cml {
+namespace utils {
+
+/*
+    Batch conversion of 12-bit right aligned ADC samples, calibrated with the factory values:
+    VDDA = 3000 mV * VREFINT_CAL / voltage_reference_raw, TS_CAL1 at 30 C and TS_CAL2 at 130 C (VDDA = 3000 mV).
+    Coefficients are precomputed once per voltage reference reading, conversions are fixed-point
+    (millivolts: Q15, temperature: Q8) with rounding.
+
+    ADC_converter<> converter(adc.get_calibration_data(), voltage_reference_raw);
+    converter.to_temperature(p_raw, p_centidegrees, count);
+*/
+template<typename ADC_t = hal::peripherals::ADC>
+class ADC_converter
+{
+public:
+
+    using Calibration_data = typename ADC_t::Calibration_data;
+
+public:
+
+    ADC_converter(const Calibration_data& a_calibration_data, uint16_t a_voltage_reference_raw)
+        : calibration_data(a_calibration_data)
+    {
+        assert(a_calibration_data.temperature_sensor_data_2 > a_calibration_data.temperature_sensor_data_1);
+
+        this->set_voltage_reference(a_voltage_reference_raw);
+    }
+
+    ADC_converter()                     = delete;
+    ADC_converter(ADC_converter&&)      = default;
+    ADC_converter(const ADC_converter&) = default;
+    ~ADC_converter()                    = default;
+
+    ADC_converter& operator = (ADC_converter&&)      = default;
+    ADC_converter& operator = (const ADC_converter&) = default;
+
+    void set_voltage_reference(uint16_t a_voltage_reference_raw)
+    {
+        assert(a_voltage_reference_raw > 0);
+
+        const int64_t vrefint_cal = this->calibration_data.internal_voltage_reference;
+        const int64_t ts_cal_1    = this->calibration_data.temperature_sensor_data_1;
+        const int64_t ts_cal_2    = this->calibration_data.temperature_sensor_data_2;
+        const int64_t vref_raw    = a_voltage_reference_raw;
+
+        this->vdda_mV = static_cast<uint32_t>(div_round(calibration_vdda_mV * vrefint_cal, vref_raw));
+
+        this->millivolts_factor = static_cast<int32_t>(div_round((calibration_vdda_mV * vrefint_cal) << 15u,
+                                                                  4095 * vref_raw));
+
+        this->temperature_factor = static_cast<int32_t>(div_round((10000 * vrefint_cal) << 8u,
+                                                                   vref_raw * (ts_cal_2 - ts_cal_1)));
+
+        this->temperature_offset = static_cast<int32_t>((3000 << 8u) -
+                                                        div_round((10000 * ts_cal_1) << 8u, ts_cal_2 - ts_cal_1) +
+                                                        (1 << 7u));
+
+        assert(this->millivolts_factor <= INT16_MAX && this->temperature_factor <= INT16_MAX);
+    }
+
+    uint32_t get_vdda_mV() const
+    {
+        return this->vdda_mV;
+    }
+
+    uint16_t to_millivolts(uint16_t a_raw) const
+    {
+        return static_cast<uint16_t>((a_raw * this->millivolts_factor + (1 << 14u)) >> 15u);
+    }
+
+    // 0.01 C units
+    int16_t to_temperature(uint16_t a_raw) const
+    {
+        return static_cast<int16_t>((a_raw * this->temperature_factor + this->temperature_offset) >> 8u);
+    }
+
+    void to_millivolts(const uint16_t* a_p_raw, uint16_t* a_p_millivolts, uint32_t a_count) const
+    {
+        assert(nullptr != a_p_raw);
+        assert(nullptr != a_p_millivolts);
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            a_p_millivolts[i] = this->to_millivolts(a_p_raw[i]);
+        }
+    }
+
+    void to_temperature(const uint16_t* a_p_raw, int16_t* a_p_centidegrees, uint32_t a_count) const
+    {
+        assert(nullptr != a_p_raw);
+        assert(nullptr != a_p_centidegrees);
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            a_p_centidegrees[i] = this->to_temperature(a_p_raw[i]);
+        }
+    }
+
+private:
+
+    static constexpr int64_t div_round(int64_t a_dividend, int64_t a_divisor)
+    {
+        return (a_dividend + a_divisor / 2) / a_divisor;
+    }
+
+private:
+
+    static constexpr int64_t calibration_vdda_mV = 3000;
+
+    Calibration_data calibration_data;
+
+    uint32_t vdda_mV;
+
+    int32_t millivolts_factor;
+    int32_t temperature_factor;
+    int32_t temperature_offset;
+};
+
+} // namespace utils
+} // namespace cml
@@ -0,0 +1,185 @@
+#pragma once
+
+/*
+    Name: Debouncer.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+#include <cml/collection/Ring.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/counter.hpp>
+#include <cml/hal/mcu.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+
+namespace cml {
+namespace utils {
+
+/*
+    Debounce of up to 16 pins of one port, sampled together (IDR) from a periodic tick. Every pin has a 2-bit
+    vertical counter: a pin changes its debounced level after 4 consecutive samples different from it,
+    any sample equal to the debounced level restarts the count. All pins are updated with a few bitwise
+    operations per tick, debounced edges are queued with the tick of the sample.
+
+    Debouncer<16> buttons(&gpio_port_c, 0x2000);
+    buttons.reset();
+    systick::register_tick_callback({ Debouncer<16>::update, &buttons });
+    ...
+    Debouncer<16>::Event event;
+    while (true == buttons.read_event(&event)) { ... }
+*/
+template<uint32_t events_capacity, typename GPIO_t = hal::peripherals::GPIO>
+class Debouncer : private Non_copyable
+{
+public:
+
+    using Level = hal::peripherals::pin::Level;
+
+    struct Event
+    {
+        uint8_t id           = 0xFF;
+        Level level          = Level::low;
+        time::tick timestamp = 0;
+    };
+
+public:
+
+    Debouncer(GPIO_t* a_p_port, uint16_t a_mask)
+        : p_port(a_p_port)
+        , mask(a_mask)
+        , state(0)
+        , counter_low(0)
+        , counter_high(0)
+        , dropped_events(0)
+        , events(this->events_buffer, events_capacity)
+    {
+        assert(nullptr != a_p_port);
+        assert(0 != a_mask);
+    }
+
+    Debouncer()                 = delete;
+    Debouncer(Debouncer&&)      = delete;
+    Debouncer(const Debouncer&) = delete;
+    ~Debouncer()                = default;
+
+    Debouncer& operator = (Debouncer&&)      = delete;
+    Debouncer& operator = (const Debouncer&) = delete;
+
+    // current levels become the debounced state, pending events are dropped
+    void reset()
+    {
+        this->reset(static_cast<uint16_t>(static_cast<GPIO_TypeDef*>(*(this->p_port))->IDR));
+    }
+
+    void reset(uint16_t a_state)
+    {
+        hal::mcu::Interrupt_guard interrupt_guard;
+
+        this->state          = a_state & this->mask;
+        this->counter_low    = 0;
+        this->counter_high   = 0;
+        this->dropped_events = 0;
+        this->events.clear();
+    }
+
+    void update()
+    {
+        this->update(static_cast<uint16_t>(static_cast<GPIO_TypeDef*>(*(this->p_port))->IDR), hal::counter::get());
+    }
+
+    // returns mask of pins which changed their debounced level
+    uint16_t update(uint16_t a_sample, time::tick a_timestamp)
+    {
+        const uint32_t delta = (a_sample ^ this->state) & this->mask;
+
+        this->counter_high = (this->counter_high ^ this->counter_low) & delta;
+        this->counter_low  = ~(this->counter_low) & delta;
+
+        const uint32_t changed = delta & ~(this->counter_low | this->counter_high);
+
+        this->state ^= changed;
+
+        for (uint32_t pending = changed; 0 != pending; pending &= pending - 1)
+        {
+            const uint8_t id = static_cast<uint8_t>(__builtin_ctz(pending));
+
+            Event event;
+            event.id        = id;
+            event.level     = static_cast<Level>(is_bit(this->state, id));
+            event.timestamp = a_timestamp;
+
+            if (false == this->events.push(event))
+            {
+                this->dropped_events++;
+            }
+        }
+
+        return static_cast<uint16_t>(changed);
+    }
+
+    // Tick_callback compatible, a_p_user_data: Debouncer*
+    static void update(void* a_p_user_data)
+    {
+        static_cast<Debouncer*>(a_p_user_data)->update();
+    }
+
+    bool read_event(Event* a_p_event)
+    {
+        assert(nullptr != a_p_event);
+
+        hal::mcu::Interrupt_guard interrupt_guard;
+
+        const bool ret = false == this->events.is_empty();
+
+        if (true == ret)
+        {
+            (*a_p_event) = this->events.read();
+        }
+
+        return ret;
+    }
+
+    Level get_level(uint8_t a_id) const
+    {
+        assert(a_id < 16 && true == is_bit(this->mask, a_id));
+        return static_cast<Level>(is_bit(this->state, a_id));
+    }
+
+    uint16_t get_state() const
+    {
+        return static_cast<uint16_t>(this->state);
+    }
+
+    uint16_t get_mask() const
+    {
+        return this->mask;
+    }
+
+    uint32_t get_dropped_events_count() const
+    {
+        return this->dropped_events;
+    }
+
+private:
+
+    GPIO_t* p_port;
+    uint16_t mask;
+
+    volatile uint32_t state;
+    uint32_t counter_low;
+    uint32_t counter_high;
+    volatile uint32_t dropped_events;
+
+    Event events_buffer[events_capacity];
+    collection::Ring<Event> events;
+};
+
+} // namespace utils
+} // namespace cml
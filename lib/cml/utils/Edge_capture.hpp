@@ -0,0 +1,299 @@
+#pragma once
+
+/*
+    Name: Edge_capture.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/frequency.hpp>
+#include <cml/Non_copyable.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/mcu.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+
+#include <cml/hal/peripherals/TIM.hpp>
+
+#ifdef STM32L452xx
+#include <cml/hal/system/exti_controller.hpp>
+#endif // STM32L452xx
+
+namespace cml {
+namespace utils {
+
+/*
+    Ring of the last capacity timestamped edges of one signal and estimators over them (averages of every
+    complete interval in the ring). Timestamps are ticks of a free running counter of counter_max + 1 values,
+    differences are taken modulo the counter range, so an interval has to be shorter than one counter period.
+    latency_ticks is subtracted from every timestamp: the fixed interrupt entry latency for EXTI
+    timestamps, 0 for timer input capture.
+    Readers never mask interrupts: head is sampled before and after the entries are read, the read is repeated
+    when push() overwrote any of them meanwhile.
+
+    Sources:
+    - EXTI (Cortex-M4): exti_callback with the DWT cycle counter latched at the interrupt entry (mcu::enable_dwt),
+    - timer input capture (jitter-free): capture_callback, rising edges on one channel and falling edges
+      on the second (PWM input) or a single channel for the period only.
+
+    Edge_capture<32> capture(14);
+    exti_controller::register_callback(&pin, rising | falling, { Edge_capture<32>::exti_callback, &capture });
+*/
+template<uint32_t capacity>
+class Edge_capture : private Non_copyable
+{
+public:
+
+    using Level = hal::peripherals::pin::Level;
+
+    struct Edge
+    {
+        Level level        = Level::low;
+        uint32_t timestamp = 0;
+    };
+
+public:
+
+    Edge_capture(uint32_t a_latency_ticks, uint32_t a_counter_max = 0xFFFFFFFFu)
+        : latency_ticks(a_latency_ticks)
+        , counter_max(a_counter_max)
+        , head(0)
+    {
+        static_assert(capacity >= 2 && 0 == (capacity & (capacity - 1)), "capacity has to be a power of two");
+        assert(0 != a_counter_max && 0 == (a_counter_max & (a_counter_max + 1)));
+    }
+
+    Edge_capture()                    = delete;
+    Edge_capture(Edge_capture&&)      = delete;
+    Edge_capture(const Edge_capture&) = delete;
+    ~Edge_capture()                   = default;
+
+    Edge_capture& operator = (Edge_capture&&)      = delete;
+    Edge_capture& operator = (const Edge_capture&) = delete;
+
+    // interrupt context
+    void push(Level a_level, uint32_t a_timestamp)
+    {
+        const uint32_t head = this->head;
+
+        this->edges[head % capacity] = { a_level, (a_timestamp - this->latency_ticks) & this->counter_max };
+        __DMB();
+        this->head = head + 1;
+    }
+
+    void clear()
+    {
+        hal::mcu::Interrupt_guard interrupt_guard;
+
+        this->head = 0;
+    }
+
+    uint32_t get_count() const
+    {
+        return this->head < capacity ? this->head : capacity;
+    }
+
+    // a_index: 0 - the newest edge
+    Edge get_edge(uint32_t a_index) const
+    {
+        assert(a_index < this->get_count());
+
+        Edge ret;
+        bool valid = false;
+
+        while (false == valid)
+        {
+            const uint32_t head = this->head;
+
+            __DMB();
+            ret = this->edges[(head - 1 - a_index) % capacity];
+            __DMB();
+
+            // the entry is overwritten by the push of capacity - a_index newer edges
+            valid = this->head - head < capacity - a_index;
+        }
+
+        return ret;
+    }
+
+    // average rising to rising edge interval, false: less than two rising edges
+    bool get_period(uint32_t* a_p_ticks) const
+    {
+        assert(nullptr != a_p_ticks);
+
+        const Statistics statistics = this->get_statistics();
+        const bool ret              = statistics.periods > 0;
+
+        if (true == ret)
+        {
+            (*a_p_ticks) = static_cast<uint32_t>((statistics.period_sum + statistics.periods / 2) / statistics.periods);
+        }
+
+        return ret;
+    }
+
+    // average rising to falling edge interval, false: no rising edge followed by a falling edge
+    bool get_high_time(uint32_t* a_p_ticks) const
+    {
+        assert(nullptr != a_p_ticks);
+
+        const Statistics statistics = this->get_statistics();
+        const bool ret              = statistics.highs > 0;
+
+        if (true == ret)
+        {
+            (*a_p_ticks) = static_cast<uint32_t>((statistics.high_sum + statistics.highs / 2) / statistics.highs);
+        }
+
+        return ret;
+    }
+
+    // 0.01 % units
+    bool get_duty_cycle(uint32_t* a_p_duty_cycle) const
+    {
+        assert(nullptr != a_p_duty_cycle);
+
+        const Statistics statistics = this->get_statistics();
+        const bool ret              = statistics.periods > 0 && statistics.highs > 0 && statistics.period_sum > 0;
+
+        if (true == ret)
+        {
+            const uint64_t numerator   = 10000u * statistics.high_sum * statistics.periods;
+            const uint64_t denominator = statistics.period_sum * statistics.highs;
+
+            (*a_p_duty_cycle) = static_cast<uint32_t>((numerator + denominator / 2) / denominator);
+        }
+
+        return ret;
+    }
+
+    // a_tick_frequency_hz: counter clock (SYSCLK for the DWT, timer clock / (prescaler + 1) for capture)
+    bool get_frequency_hz(frequency a_tick_frequency_hz, frequency* a_p_frequency_hz) const
+    {
+        assert(nullptr != a_p_frequency_hz);
+
+        const Statistics statistics = this->get_statistics();
+        const bool ret              = statistics.periods > 0 && statistics.period_sum > 0;
+
+        if (true == ret)
+        {
+            const uint64_t numerator = static_cast<uint64_t>(a_tick_frequency_hz) * statistics.periods;
+
+            (*a_p_frequency_hz) = static_cast<frequency>((numerator + statistics.period_sum / 2) / statistics.period_sum);
+        }
+
+        return ret;
+    }
+
+#ifdef STM32L452xx
+    // exti_controller::Callback, a_p_user_data: Edge_capture*
+    static bool exti_callback(Level a_level, void* a_p_user_data)
+    {
+        static_cast<Edge_capture*>(a_p_user_data)->push(a_level, hal::system::exti_controller::get_entry_cycles());
+        return true;
+    }
+#endif // STM32L452xx
+
+    // TIM::Capture_callback, a_p_user_data: Edge_capture*, both edges capture toggles the last level
+    static void capture_callback(hal::peripherals::TIM::Channel,
+                                 uint32_t a_value,
+                                 hal::peripherals::TIM::Capture::Edge a_edge,
+                                 void* a_p_user_data)
+    {
+        using Capture = hal::peripherals::TIM::Capture;
+
+        Edge_capture* p_this = static_cast<Edge_capture*>(a_p_user_data);
+        Level level          = Capture::Edge::rising == a_edge ? Level::high : Level::low;
+
+        if (Capture::Edge::both == a_edge)
+        {
+            level = 0 != p_this->head && Level::low == p_this->edges[(p_this->head - 1) % capacity].level ?
+                    Level::high :
+                    Level::low;
+        }
+
+        p_this->push(level, a_value);
+    }
+
+private:
+
+    struct Statistics
+    {
+        uint64_t period_sum = 0;
+        uint64_t high_sum   = 0;
+        uint32_t periods    = 0;
+        uint32_t highs      = 0;
+    };
+
+    // oldest to newest, repeated when the oldest entries were overwritten during the pass over the ring
+    Statistics get_statistics() const
+    {
+        Statistics ret;
+        bool valid = false;
+
+        while (false == valid)
+        {
+            const uint32_t head  = this->head;
+            const uint32_t count = head < capacity ? head : capacity;
+
+            __DMB();
+            ret = this->calculate_statistics(head - count, count);
+            __DMB();
+
+            valid = this->head - head <= capacity - count;
+        }
+
+        return ret;
+    }
+
+    Statistics calculate_statistics(uint32_t a_first, uint32_t a_count) const
+    {
+        Statistics ret;
+
+        bool rising   = false;
+        bool high     = false;
+        uint32_t rise = 0;
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            const Edge& edge = this->edges[(a_first + i) % capacity];
+
+            if (Level::high == edge.level)
+            {
+                if (true == rising)
+                {
+                    ret.period_sum += (edge.timestamp - rise) & this->counter_max;
+                    ret.periods++;
+                }
+
+                rising = true;
+                high   = true;
+                rise   = edge.timestamp;
+            }
+            else if (true == high)
+            {
+                ret.high_sum += (edge.timestamp - rise) & this->counter_max;
+                ret.highs++;
+
+                high = false;
+            }
+        }
+
+        return ret;
+    }
+
+private:
+
+    const uint32_t latency_ticks;
+    const uint32_t counter_max;
+
+    volatile uint32_t head;
+    Edge edges[capacity];
+};
+
+} // namespace utils
+} // namespace cml
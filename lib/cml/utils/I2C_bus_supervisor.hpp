@@ -0,0 +1,226 @@
+#pragma once
+
+/*
+    Name: I2C_bus_supervisor.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+#include <cml/hal/peripherals/I2C.hpp>
+#include <cml/utils/delay.hpp>
+
+namespace cml {
+namespace utils {
+
+/*
+    Polling I2C master transactions with per-bus error accounting and a retry policy.
+    A failed attempt is retried after a backoff (growing by backoff_factor up to max_backoff_ms).
+    Timeouts and bus errors (misplaced START/STOP) recover the bus first: peripheral reset,
+    SCL pulses until SDA is released and a STOP condition.
+    Delay_t::ms(time::tick) waits the backoff.
+*/
+template<typename I2C_master_t = hal::peripherals::I2C_master,
+         typename Pin_t        = hal::peripherals::pin::Af,
+         typename Delay_t      = delay>
+class I2C_bus_supervisor : private Non_copyable
+{
+public:
+
+    using Bus_status_flag = typename I2C_master_t::Bus_status_flag;
+    using Result          = typename I2C_master_t::Result;
+
+    struct Retry_policy
+    {
+        uint32_t attempts         = 3;
+        time::tick backoff_ms     = 1;
+        uint32_t backoff_factor   = 2;
+        time::tick max_backoff_ms = 50;
+        bool retry_on_nack        = true;
+    };
+
+    struct Error_counters
+    {
+        uint32_t nack             = 0;
+        uint32_t arbitration_lost = 0;
+        uint32_t misplaced        = 0;
+        uint32_t buffer_error     = 0;
+        uint32_t crc_error        = 0;
+        uint32_t timeout          = 0;
+
+        uint32_t retries             = 0;
+        uint32_t recoveries          = 0;
+        uint32_t failed_recoveries   = 0;
+        uint32_t failed_transactions = 0;
+    };
+
+public:
+
+    I2C_bus_supervisor(I2C_master_t* a_p_i2c, Pin_t* a_p_scl, Pin_t* a_p_sda, const Retry_policy& a_retry_policy)
+        : p_i2c(a_p_i2c)
+        , p_scl(a_p_scl)
+        , p_sda(a_p_sda)
+        , retry_policy(a_retry_policy)
+    {
+        assert(nullptr != a_p_i2c);
+        assert(nullptr != a_p_scl);
+        assert(nullptr != a_p_sda);
+        assert(a_retry_policy.attempts > 0);
+    }
+
+    I2C_bus_supervisor()                          = delete;
+    I2C_bus_supervisor(I2C_bus_supervisor&&)      = delete;
+    I2C_bus_supervisor(const I2C_bus_supervisor&) = delete;
+    ~I2C_bus_supervisor()                         = default;
+
+    I2C_bus_supervisor& operator = (I2C_bus_supervisor&&)      = delete;
+    I2C_bus_supervisor& operator = (const I2C_bus_supervisor&) = delete;
+
+    Result transmit_bytes(uint16_t a_slave_address,
+                          const void* a_p_data,
+                          uint32_t a_data_size_in_bytes,
+                          time::tick a_timeout)
+    {
+        return this->execute([&]() {
+            return this->p_i2c->transmit_bytes_polling(a_slave_address, a_p_data, a_data_size_in_bytes, a_timeout);
+        });
+    }
+
+    Result receive_bytes(uint16_t a_slave_address,
+                         void* a_p_data,
+                         uint32_t a_data_size_in_bytes,
+                         time::tick a_timeout)
+    {
+        return this->execute([&]() {
+            return this->p_i2c->receive_bytes_polling(a_slave_address, a_p_data, a_data_size_in_bytes, a_timeout);
+        });
+    }
+
+    Result write_read(uint16_t a_slave_address,
+                      const void* a_p_tx_data,
+                      uint32_t a_tx_data_size_in_bytes,
+                      void* a_p_rx_data,
+                      uint32_t a_rx_data_size_in_bytes,
+                      time::tick a_timeout)
+    {
+        return this->execute([&]() {
+            return this->p_i2c->write_read_polling(a_slave_address,
+                                                   a_p_tx_data,
+                                                   a_tx_data_size_in_bytes,
+                                                   a_p_rx_data,
+                                                   a_rx_data_size_in_bytes,
+                                                   a_timeout);
+        });
+    }
+
+    bool recover()
+    {
+        const bool ret = this->p_i2c->recover_bus(this->p_scl, this->p_sda);
+
+        this->error_counters.recoveries++;
+        this->error_counters.failed_recoveries += false == ret ? 1 : 0;
+
+        return ret;
+    }
+
+    void set_retry_policy(const Retry_policy& a_retry_policy)
+    {
+        assert(a_retry_policy.attempts > 0);
+
+        this->retry_policy = a_retry_policy;
+    }
+
+    const Retry_policy& get_retry_policy() const
+    {
+        return this->retry_policy;
+    }
+
+    const Error_counters& get_error_counters() const
+    {
+        return this->error_counters;
+    }
+
+    void reset_error_counters()
+    {
+        this->error_counters = Error_counters();
+    }
+
+private:
+
+    template<typename Transaction_t>
+    Result execute(const Transaction_t& a_transaction)
+    {
+        Result ret         = a_transaction();
+        time::tick backoff = this->retry_policy.backoff_ms;
+
+        this->count(ret.bus_status);
+
+        for (uint32_t attempt = 1; attempt < this->retry_policy.attempts && true == this->is_retry_needed(ret); attempt++)
+        {
+            if (true == is_status(ret.bus_status, Bus_status_flag::timeout) ||
+                true == is_status(ret.bus_status, Bus_status_flag::misplaced))
+            {
+                this->recover();
+            }
+
+            if (backoff > 0)
+            {
+                Delay_t::ms(backoff);
+                backoff = backoff * this->retry_policy.backoff_factor > this->retry_policy.max_backoff_ms ?
+                          this->retry_policy.max_backoff_ms :
+                          backoff * this->retry_policy.backoff_factor;
+            }
+
+            this->error_counters.retries++;
+
+            ret = a_transaction();
+            this->count(ret.bus_status);
+        }
+
+        this->error_counters.failed_transactions += Bus_status_flag::ok != ret.bus_status ? 1 : 0;
+
+        return ret;
+    }
+
+    bool is_retry_needed(const Result& a_result) const
+    {
+        return Bus_status_flag::ok != a_result.bus_status &&
+               (Bus_status_flag::nack != a_result.bus_status || true == this->retry_policy.retry_on_nack);
+    }
+
+    void count(Bus_status_flag a_bus_status)
+    {
+        this->error_counters.nack             += is_status(a_bus_status, Bus_status_flag::nack) ? 1 : 0;
+        this->error_counters.arbitration_lost += is_status(a_bus_status, Bus_status_flag::arbitration_lost) ? 1 : 0;
+        this->error_counters.misplaced        += is_status(a_bus_status, Bus_status_flag::misplaced) ? 1 : 0;
+        this->error_counters.buffer_error     += is_status(a_bus_status, Bus_status_flag::buffer_error) ? 1 : 0;
+        this->error_counters.crc_error        += is_status(a_bus_status, Bus_status_flag::crc_error) ? 1 : 0;
+        this->error_counters.timeout          += is_status(a_bus_status, Bus_status_flag::timeout) ? 1 : 0;
+    }
+
+    static constexpr bool is_status(Bus_status_flag a_bus_status, Bus_status_flag a_flag)
+    {
+        return 0 != (static_cast<uint32_t>(a_bus_status) & static_cast<uint32_t>(a_flag));
+    }
+
+private:
+
+    I2C_master_t* p_i2c;
+
+    Pin_t* p_scl;
+    Pin_t* p_sda;
+
+    Retry_policy retry_policy;
+    Error_counters error_counters;
+};
+
+} // namespace utils
+} // namespace cml
@@ -0,0 +1,267 @@
+#pragma once
+
+/*
+    Name: I2C_register_device.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/peripherals/I2C.hpp>
+
+namespace cml {
+namespace utils {
+
+/*
+    Cached view of an I2C device with 8-bit registers and auto-incremented register address.
+
+    Register_map_t:
+    struct Register_map
+    {
+        static constexpr uint8_t first  = 0x20;  // address of the first mapped register
+        static constexpr uint32_t count = 16;    // number of mapped registers
+
+        static constexpr bool is_volatile(uint8_t a_register); // status/data registers, never cached
+    };
+
+    Non-volatile registers are kept in a shadow copy: writes which do not change a value are skipped,
+    changed values are marked dirty and flush() sends every contiguous dirty run as one burst.
+    Volatile registers are always read from and written to the bus.
+*/
+template<typename Register_map_t, typename I2C_master_t = hal::peripherals::I2C_master>
+class I2C_register_device : private Non_copyable
+{
+public:
+
+    I2C_register_device(I2C_master_t* a_p_i2c, uint16_t a_slave_address, time::tick a_timeout)
+        : p_i2c(a_p_i2c)
+        , slave_address(a_slave_address)
+        , timeout(a_timeout)
+        , bus_transactions(0)
+    {
+        assert(nullptr != a_p_i2c);
+        assert(a_timeout > 0);
+
+        this->invalidate();
+    }
+
+    I2C_register_device()                           = delete;
+    I2C_register_device(I2C_register_device&&)      = delete;
+    I2C_register_device(const I2C_register_device&) = delete;
+    ~I2C_register_device()                          = default;
+
+    I2C_register_device& operator = (I2C_register_device&&)      = delete;
+    I2C_register_device& operator = (const I2C_register_device&) = delete;
+
+    bool read(uint8_t a_register, uint8_t* a_p_value)
+    {
+        assert(true == is_mapped(a_register));
+        assert(nullptr != a_p_value);
+
+        const uint32_t index = a_register - Register_map_t::first;
+        bool ret             = true;
+
+        if (true == Register_map_t::is_volatile(a_register) || false == this->valid[index])
+        {
+            ret = this->read_from_bus(a_register, 1);
+        }
+
+        (*a_p_value) = this->shadow[index];
+
+        return ret;
+    }
+
+    bool read(uint8_t a_first_register, uint8_t* a_p_values, uint32_t a_count)
+    {
+        assert(true == is_mapped(a_first_register));
+        assert(true == is_mapped(a_first_register + a_count - 1));
+        assert(nullptr != a_p_values);
+        assert(a_count > 0);
+
+        const uint32_t index = a_first_register - Register_map_t::first;
+        bool cached          = true;
+
+        for (uint32_t i = 0; i < a_count && true == cached; i++)
+        {
+            cached = false == Register_map_t::is_volatile(a_first_register + i) && true == this->valid[index + i];
+        }
+
+        bool ret = true == cached || true == this->read_from_bus(a_first_register, a_count);
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            a_p_values[i] = this->shadow[index + i];
+        }
+
+        return ret;
+    }
+
+    bool write(uint8_t a_register, uint8_t a_value)
+    {
+        assert(true == is_mapped(a_register));
+
+        const uint32_t index = a_register - Register_map_t::first;
+        bool ret             = true;
+
+        if (true == Register_map_t::is_volatile(a_register))
+        {
+            const uint8_t data[] = { a_register, a_value };
+
+            this->bus_transactions++;
+            ret = I2C_master_t::Bus_status_flag::ok ==
+                  this->p_i2c->transmit_bytes_polling(this->slave_address, data, sizeof(data), this->timeout).bus_status;
+        }
+        else if (false == this->valid[index] || a_value != this->shadow[index])
+        {
+            this->shadow[index] = a_value;
+            this->valid[index]  = true;
+            this->dirty[index]  = true;
+        }
+
+        return ret;
+    }
+
+    bool modify(uint8_t a_register, uint8_t a_clear_mask, uint8_t a_set_mask)
+    {
+        uint8_t value = 0;
+        bool ret      = this->read(a_register, &value);
+
+        if (true == ret)
+        {
+            ret = this->write(a_register, static_cast<uint8_t>((value & ~a_clear_mask) | a_set_mask));
+        }
+
+        return ret;
+    }
+
+    bool flush()
+    {
+        bool ret       = true;
+        uint32_t index = 0;
+
+        while (index < Register_map_t::count)
+        {
+            if (true == this->dirty[index])
+            {
+                uint32_t length = 0;
+
+                this->burst[0] = static_cast<uint8_t>(Register_map_t::first + index);
+
+                while (index + length < Register_map_t::count && true == this->dirty[index + length])
+                {
+                    this->burst[1 + length] = this->shadow[index + length];
+                    length++;
+                }
+
+                this->bus_transactions++;
+
+                if (I2C_master_t::Bus_status_flag::ok ==
+                    this->p_i2c->transmit_bytes_polling(this->slave_address, this->burst, length + 1, this->timeout).bus_status)
+                {
+                    for (uint32_t i = 0; i < length; i++)
+                    {
+                        this->dirty[index + i] = false;
+                    }
+                }
+                else
+                {
+                    ret = false;
+                }
+
+                index += length;
+            }
+            else
+            {
+                index++;
+            }
+        }
+
+        return ret;
+    }
+
+    void invalidate()
+    {
+        for (uint32_t i = 0; i < Register_map_t::count; i++)
+        {
+            this->shadow[i] = 0;
+            this->valid[i]  = false;
+            this->dirty[i]  = false;
+        }
+    }
+
+    bool is_dirty() const
+    {
+        bool ret = false;
+
+        for (uint32_t i = 0; i < Register_map_t::count && false == ret; i++)
+        {
+            ret = this->dirty[i];
+        }
+
+        return ret;
+    }
+
+    uint32_t get_bus_transactions() const
+    {
+        return this->bus_transactions;
+    }
+
+private:
+
+    static constexpr bool is_mapped(uint32_t a_register)
+    {
+        return a_register >= Register_map_t::first && a_register < Register_map_t::first + Register_map_t::count;
+    }
+
+    bool read_from_bus(uint8_t a_first_register, uint32_t a_count)
+    {
+        const uint32_t index = a_first_register - Register_map_t::first;
+
+        this->bus_transactions++;
+
+        bool ret = I2C_master_t::Bus_status_flag::ok == this->p_i2c->write_read_polling(this->slave_address,
+                                                                                         &a_first_register,
+                                                                                         1,
+                                                                                         &(this->burst[1]),
+                                                                                         a_count,
+                                                                                         this->timeout).bus_status;
+
+        for (uint32_t i = 0; i < a_count && true == ret; i++)
+        {
+            if (false == this->dirty[index + i])
+            {
+                this->shadow[index + i] = this->burst[1 + i];
+                this->valid[index + i]  = false == Register_map_t::is_volatile(a_first_register + i);
+            }
+        }
+
+        return ret;
+    }
+
+private:
+
+    static_assert(Register_map_t::count > 0);
+    static_assert(Register_map_t::first + Register_map_t::count <= 0x100);
+
+    I2C_master_t* p_i2c;
+    uint16_t slave_address;
+    time::tick timeout;
+
+    uint8_t shadow[Register_map_t::count];
+    bool valid[Register_map_t::count];
+    bool dirty[Register_map_t::count];
+
+    uint8_t burst[Register_map_t::count + 1];
+
+    uint32_t bus_transactions;
+};
+
+} // namespace utils
+} // namespace cml
@@ -0,0 +1,326 @@
+#pragma once
+
+/*
+    Name: I2C_register_file.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/peripherals/I2C.hpp>
+
+namespace cml {
+namespace utils {
+
+/*
+    Exposes user memory as the register file of one or more I2C slave devices (use the slave address_2 with
+    a mask to answer to several addresses). Master writes: first byte sets the register pointer, following
+    bytes are stored at the pointer, which auto-increments and wraps at the end of the device memory.
+    Master reads: bytes are sent from the pointer, the pointer persists between transactions.
+    SMBus PEC is not handled: with the slave crc_enable a trailing PEC byte is written as a register.
+
+    Registers outside of the ranges are read-write without notification. Write-only registers read as 0xFF,
+    writes to read-only registers are ignored. Range write callbacks are called (from the interrupt) at stop
+    or repeated start with the part of the range written in the transaction.
+
+    Snapshot ranges (p_snapshot != nullptr) are double buffered: the application fills p_snapshot and calls
+    publish(), the engine copies it into the device memory at the next address match, so a master never reads
+    a half updated value. p_snapshot must not be modified while is_publish_pending().
+*/
+template<typename I2C_slave_t = hal::peripherals::I2C_slave>
+class I2C_register_file : private Non_copyable
+{
+public:
+
+    enum class Access : uint32_t
+    {
+        read_write,
+        read_only,
+        write_only
+    };
+
+    struct Write_callback
+    {
+        using Function = void(*)(uint8_t a_first_register, uint32_t a_count, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    struct Range
+    {
+        uint8_t first  = 0;
+        uint32_t count = 0;
+        Access access  = Access::read_write;
+
+        Write_callback write_callback;
+        uint8_t* p_snapshot = nullptr;
+
+        volatile bool publish_pending = false; // managed by I2C_register_file
+    };
+
+    struct Device
+    {
+        uint16_t address = 0;
+
+        uint8_t* p_memory    = nullptr;
+        uint32_t memory_size = 0; // up to 256 registers
+
+        Range* p_ranges       = nullptr;
+        uint32_t ranges_count = 0;
+
+        uint8_t register_pointer = 0; // managed by I2C_register_file
+    };
+
+public:
+
+    I2C_register_file(I2C_slave_t* a_p_slave, Device* a_p_devices, uint32_t a_devices_count)
+        : p_slave(a_p_slave)
+        , p_devices(a_p_devices)
+        , devices_count(a_devices_count)
+        , p_active(nullptr)
+        , pointer_expected(false)
+        , written_first(0)
+        , written_count(0)
+    {
+        assert(nullptr != a_p_slave);
+        assert(nullptr != a_p_devices);
+        assert(a_devices_count > 0);
+
+        for (uint32_t i = 0; i < a_devices_count; i++)
+        {
+            assert(nullptr != a_p_devices[i].p_memory);
+            assert(a_p_devices[i].memory_size > 0 && a_p_devices[i].memory_size <= 0x100);
+            assert(0 == a_p_devices[i].ranges_count || nullptr != a_p_devices[i].p_ranges);
+
+            for (uint32_t r = 0; r < a_p_devices[i].ranges_count; r++)
+            {
+                assert(a_p_devices[i].p_ranges[r].first + a_p_devices[i].p_ranges[r].count <= a_p_devices[i].memory_size);
+            }
+        }
+    }
+
+    I2C_register_file()                         = delete;
+    I2C_register_file(I2C_register_file&&)      = delete;
+    I2C_register_file(const I2C_register_file&) = delete;
+    ~I2C_register_file()                        = default;
+
+    I2C_register_file& operator = (I2C_register_file&&)      = delete;
+    I2C_register_file& operator = (const I2C_register_file&) = delete;
+
+    void enable()
+    {
+        this->p_slave->register_event_callback({ on_address, on_receive, on_transmit, on_stop, this });
+    }
+
+    void disable()
+    {
+        this->p_slave->unregister_event_callback();
+
+        this->p_active = nullptr;
+    }
+
+    void publish(uint32_t a_device, uint32_t a_range)
+    {
+        assert(a_device < this->devices_count);
+        assert(a_range < this->p_devices[a_device].ranges_count);
+        assert(nullptr != this->p_devices[a_device].p_ranges[a_range].p_snapshot);
+
+        this->p_devices[a_device].p_ranges[a_range].publish_pending = true;
+    }
+
+    bool is_publish_pending(uint32_t a_device, uint32_t a_range) const
+    {
+        assert(a_device < this->devices_count);
+        assert(a_range < this->p_devices[a_device].ranges_count);
+
+        return this->p_devices[a_device].p_ranges[a_range].publish_pending;
+    }
+
+private:
+
+    static void on_address(uint16_t a_address, bool a_read, void* a_p_user_data)
+    {
+        I2C_register_file* p_this = reinterpret_cast<I2C_register_file*>(a_p_user_data);
+
+        p_this->end_write();
+        p_this->p_active = nullptr;
+
+        for (uint32_t i = 0; i < p_this->devices_count && nullptr == p_this->p_active; i++)
+        {
+            if (a_address == p_this->p_devices[i].address)
+            {
+                p_this->p_active = &(p_this->p_devices[i]);
+            }
+        }
+
+        if (nullptr != p_this->p_active)
+        {
+            p_this->apply_published();
+        }
+
+        p_this->pointer_expected = false == a_read;
+    }
+
+    static void on_receive(uint8_t a_data, void* a_p_user_data)
+    {
+        I2C_register_file* p_this = reinterpret_cast<I2C_register_file*>(a_p_user_data);
+        Device* p_device          = p_this->p_active;
+
+        if (nullptr != p_device)
+        {
+            if (true == p_this->pointer_expected)
+            {
+                p_device->register_pointer = static_cast<uint8_t>(a_data % p_device->memory_size);
+                p_this->pointer_expected   = false;
+            }
+            else
+            {
+                const uint8_t reg = p_device->register_pointer;
+
+                if (Access::read_only != p_this->get_access(reg))
+                {
+                    if (0 == p_this->written_count)
+                    {
+                        p_this->written_first = reg;
+                    }
+
+                    p_device->p_memory[reg] = a_data;
+                    p_this->written_count++;
+                }
+                else
+                {
+                    p_this->end_write();
+                }
+
+                p_this->increment_pointer();
+
+                if (0 == p_device->register_pointer)
+                {
+                    p_this->end_write();
+                }
+            }
+        }
+    }
+
+    static uint8_t on_transmit(void* a_p_user_data)
+    {
+        I2C_register_file* p_this = reinterpret_cast<I2C_register_file*>(a_p_user_data);
+        uint8_t ret               = 0xFF;
+
+        if (nullptr != p_this->p_active)
+        {
+            const uint8_t reg = p_this->p_active->register_pointer;
+
+            if (Access::write_only != p_this->get_access(reg))
+            {
+                ret = p_this->p_active->p_memory[reg];
+            }
+
+            p_this->increment_pointer();
+        }
+
+        return ret;
+    }
+
+    static void on_stop(bool a_tx_discarded, void* a_p_user_data)
+    {
+        I2C_register_file* p_this = reinterpret_cast<I2C_register_file*>(a_p_user_data);
+
+        if (nullptr != p_this->p_active && true == a_tx_discarded)
+        {
+            Device* p_device = p_this->p_active;
+
+            p_device->register_pointer = static_cast<uint8_t>((p_device->register_pointer + p_device->memory_size - 1) %
+                                                              p_device->memory_size);
+        }
+
+        p_this->end_write();
+        p_this->p_active = nullptr;
+    }
+
+    Access get_access(uint8_t a_register) const
+    {
+        Access ret = Access::read_write;
+        bool found = false;
+
+        for (uint32_t i = 0; i < this->p_active->ranges_count && false == found; i++)
+        {
+            const Range& range = this->p_active->p_ranges[i];
+
+            found = a_register >= range.first && a_register < range.first + range.count;
+            ret   = true == found ? range.access : ret;
+        }
+
+        return ret;
+    }
+
+    void increment_pointer()
+    {
+        this->p_active->register_pointer = static_cast<uint8_t>((this->p_active->register_pointer + 1) %
+                                                                this->p_active->memory_size);
+    }
+
+    void apply_published()
+    {
+        for (uint32_t i = 0; i < this->p_active->ranges_count; i++)
+        {
+            Range& range = this->p_active->p_ranges[i];
+
+            if (true == range.publish_pending)
+            {
+                for (uint32_t b = 0; b < range.count; b++)
+                {
+                    this->p_active->p_memory[range.first + b] = range.p_snapshot[b];
+                }
+
+                range.publish_pending = false;
+            }
+        }
+    }
+
+    void end_write()
+    {
+        if (nullptr != this->p_active && 0 != this->written_count)
+        {
+            const uint32_t written_end = this->written_first + this->written_count;
+
+            for (uint32_t i = 0; i < this->p_active->ranges_count; i++)
+            {
+                const Range& range = this->p_active->p_ranges[i];
+
+                const uint32_t first = range.first > this->written_first ? range.first : this->written_first;
+                const uint32_t end   = range.first + range.count < written_end ? range.first + range.count : written_end;
+
+                if (nullptr != range.write_callback.function && first < end)
+                {
+                    range.write_callback.function(static_cast<uint8_t>(first), end - first, range.write_callback.p_user_data);
+                }
+            }
+        }
+
+        this->written_count = 0;
+    }
+
+private:
+
+    I2C_slave_t* p_slave;
+
+    Device* p_devices;
+    uint32_t devices_count;
+
+    Device* p_active;
+    bool pointer_expected;
+
+    uint32_t written_first;
+    uint32_t written_count;
+};
+
+} // namespace utils
+} // namespace cml
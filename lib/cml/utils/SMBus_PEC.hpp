@@ -0,0 +1,73 @@
+#pragma once
+
+/*
+    Name: SMBus_PEC.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace cml {
+namespace utils {
+
+/*
+    Software SMBus packet error code (CRC-8, x^8 + x^2 + x + 1, initial value 0), for buses or transfers
+    without hardware PEC. The PEC covers every byte of the transaction, address bytes included:
+
+    uint8_t pec = SMBus_PEC::update(0, SMBus_PEC::get_address_byte(0x0B, false));
+    pec         = SMBus_PEC::update(pec, &command, 1);
+    pec         = SMBus_PEC::update(pec, SMBus_PEC::get_address_byte(0x0B, true));
+    pec         = SMBus_PEC::update(pec, p_data, size);
+*/
+class SMBus_PEC
+{
+public:
+
+    SMBus_PEC()                 = delete;
+    SMBus_PEC(SMBus_PEC&&)      = delete;
+    SMBus_PEC(const SMBus_PEC&) = delete;
+    ~SMBus_PEC()                = delete;
+
+    SMBus_PEC& operator = (SMBus_PEC&&)      = delete;
+    SMBus_PEC& operator = (const SMBus_PEC&) = delete;
+
+    static constexpr uint8_t update(uint8_t a_pec, uint8_t a_byte)
+    {
+        uint8_t ret = a_pec ^ a_byte;
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            ret = static_cast<uint8_t>(0 != (ret & 0x80u) ? (ret << 1u) ^ 0x07u : ret << 1u);
+        }
+
+        return ret;
+    }
+
+    static uint8_t update(uint8_t a_pec, const void* a_p_data, uint32_t a_data_size_in_bytes)
+    {
+        assert(nullptr != a_p_data || 0 == a_data_size_in_bytes);
+
+        uint8_t ret = a_pec;
+
+        for (uint32_t i = 0; i < a_data_size_in_bytes; i++)
+        {
+            ret = update(ret, static_cast<const uint8_t*>(a_p_data)[i]);
+        }
+
+        return ret;
+    }
+
+    static constexpr uint8_t get_address_byte(uint16_t a_slave_address, bool a_read)
+    {
+        return static_cast<uint8_t>((a_slave_address << 1u) | (true == a_read ? 0x1u : 0x0u));
+    }
+};
+
+} // namespace utils
+} // namespace cml
@@ -0,0 +1,393 @@
+#pragma once
+
+/*
+    Name: Timer_wheel.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/mcu.hpp>
+
+namespace cml {
+namespace utils {
+
+template<uint32_t levels, uint32_t slot_bits> class Timer_wheel;
+
+/*
+    Timer of a Timer_wheel, owned by the user (no allocation). Has to be stopped before it is destroyed.
+*/
+class Software_timer : private Non_copyable
+{
+public:
+
+    enum class Context : uint32_t
+    {
+        interrupt, // callback called from Timer_wheel::update
+        deferred   // callback called from Timer_wheel::process_deferred
+    };
+
+    struct Callback
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    Software_timer()
+        : link{ this, nullptr, nullptr }
+        , deferred_link{ this, nullptr, nullptr }
+        , expires(0)
+        , period(0)
+        , context(Context::interrupt)
+        , overruns(0)
+    {}
+
+    Software_timer(Software_timer&&)      = delete;
+    Software_timer(const Software_timer&) = delete;
+    ~Software_timer()                     = default;
+
+    Software_timer& operator = (Software_timer&&)      = delete;
+    Software_timer& operator = (const Software_timer&) = delete;
+
+    bool is_active() const
+    {
+        return nullptr != this->link.p_next;
+    }
+
+    // deferred callback waiting for Timer_wheel::process_deferred
+    bool is_pending() const
+    {
+        return nullptr != this->deferred_link.p_next;
+    }
+
+    // deferred expirations lost because the previous one was not processed yet
+    uint32_t get_overruns_count() const
+    {
+        return this->overruns;
+    }
+
+private:
+
+    // circular, doubly linked, the list head (sentinel) has no timer
+    struct Link
+    {
+        Software_timer* p_timer;
+
+        Link* p_next;
+        Link* p_prev;
+    };
+
+private:
+
+    Link link;
+    Link deferred_link;
+
+    time::tick expires;
+    time::tick period;
+
+    Callback callback;
+    Context context;
+
+    uint32_t overruns;
+
+private:
+
+    template<uint32_t levels, uint32_t slot_bits> friend class Timer_wheel;
+};
+
+/*
+    Hierarchical timing wheel: levels of 2^slot_bits slots, a slot of level n spans 2^(slot_bits * n) ticks.
+    Start and stop are O(1) (list insert/unlink), a tick processes the timers expiring in it and, every
+    2^slot_bits ticks, moves the timers of one slot of the next level down (cascading).
+    Delays up to 2^(slot_bits * levels) - 1 ticks are placed directly, longer ones are cascaded again
+    from the last level. RAM: 2^slot_bits * levels * 3 words.
+
+    Timer_wheel<> timers;
+    Software_timer led_timer;
+
+    systick::register_tick_callback({ [](void* a_p_user_data) { counter::update(nullptr);
+                                                               Timer_wheel<>::update(a_p_user_data); },
+                                      &timers });
+
+    timers.start(&led_timer, 500, 500, Software_timer::Context::deferred, { toggle_led, &led });
+    while (true) { timers.process_deferred(); }
+*/
+template<uint32_t levels = 4, uint32_t slot_bits = 6>
+class Timer_wheel : private Non_copyable
+{
+public:
+
+    Timer_wheel()
+        : now(0)
+    {
+        static_assert(levels > 0 && slot_bits > 0 && levels * slot_bits < 32, "invalid wheel size");
+
+        for (uint32_t level = 0; level < levels; level++)
+        {
+            for (uint32_t slot = 0; slot < slots_count; slot++)
+            {
+                initialize(&(this->slots[level][slot]));
+            }
+        }
+
+        initialize(&(this->deferred));
+    }
+
+    Timer_wheel(Timer_wheel&&)      = delete;
+    Timer_wheel(const Timer_wheel&) = delete;
+    ~Timer_wheel()                  = default;
+
+    Timer_wheel& operator = (Timer_wheel&&)      = delete;
+    Timer_wheel& operator = (const Timer_wheel&) = delete;
+
+    // a_period: 0 - one shot, periodic timers are rescheduled from the expiration time (no drift)
+    void start(Software_timer* a_p_timer,
+               time::tick a_delay,
+               time::tick a_period,
+               Software_timer::Context a_context,
+               const Software_timer::Callback& a_callback)
+    {
+        assert(nullptr != a_p_timer);
+        assert(nullptr != a_callback.function);
+
+        hal::mcu::Interrupt_guard interrupt_guard;
+
+        this->cancel(a_p_timer);
+
+        a_p_timer->expires  = this->now + (a_delay > 0 ? a_delay : 1);
+        a_p_timer->period   = a_period;
+        a_p_timer->context  = a_context;
+        a_p_timer->callback = a_callback;
+        a_p_timer->overruns = 0;
+
+        this->insert(a_p_timer);
+    }
+
+    // pending deferred callback is dropped
+    void stop(Software_timer* a_p_timer)
+    {
+        assert(nullptr != a_p_timer);
+
+        hal::mcu::Interrupt_guard interrupt_guard;
+
+        this->cancel(a_p_timer);
+    }
+
+    // one tick, interrupt context
+    void update()
+    {
+        this->now++;
+
+        for (uint32_t level = 1;
+             level < levels && 0 == (this->now & ((0x1u << (slot_bits * level)) - 1u));
+             level++)
+        {
+            this->cascade(level, (this->now >> (slot_bits * level)) & slot_mask);
+        }
+
+        Software_timer::Link expired;
+        move(&(this->slots[0][this->now & slot_mask]), &expired);
+
+        while (expired.p_next != &expired)
+        {
+            Software_timer* p_timer = expired.p_next->p_timer;
+
+            unlink(&(p_timer->link));
+
+            if (p_timer->expires != this->now)
+            {
+                this->insert(p_timer);
+            }
+            else
+            {
+                this->expire(p_timer);
+            }
+        }
+    }
+
+    // systick::Tick_callback compatible, a_p_user_data: Timer_wheel*
+    static void update(void* a_p_user_data)
+    {
+        static_cast<Timer_wheel*>(a_p_user_data)->update();
+    }
+
+    // main loop, returns number of called callbacks
+    uint32_t process_deferred()
+    {
+        uint32_t ret = 0;
+        bool empty   = false;
+
+        while (false == empty)
+        {
+            Software_timer::Callback callback;
+
+            {
+                hal::mcu::Interrupt_guard interrupt_guard;
+
+                empty = this->deferred.p_next == &(this->deferred);
+
+                if (false == empty)
+                {
+                    Software_timer* p_timer = this->deferred.p_next->p_timer;
+
+                    unlink(&(p_timer->deferred_link));
+                    callback = p_timer->callback;
+                }
+            }
+
+            if (false == empty)
+            {
+                callback.function(callback.p_user_data);
+                ret++;
+            }
+        }
+
+        return ret;
+    }
+
+    time::tick get_time() const
+    {
+        return this->now;
+    }
+
+    // ticks to the expiration, 0 - not active
+    time::tick get_remaining(const Software_timer& a_timer) const
+    {
+        return true == a_timer.is_active() ? a_timer.expires - this->now : 0;
+    }
+
+public:
+
+    static constexpr uint32_t slots_count = 0x1u << slot_bits;
+    static constexpr time::tick max_delay = (0x1u << (slot_bits * levels)) - 1u;
+
+private:
+
+    static constexpr uint32_t slot_mask = slots_count - 1u;
+
+    static void initialize(Software_timer::Link* a_p_head)
+    {
+        a_p_head->p_timer = nullptr;
+        a_p_head->p_next  = a_p_head;
+        a_p_head->p_prev  = a_p_head;
+    }
+
+    static void push_back(Software_timer::Link* a_p_head, Software_timer::Link* a_p_link)
+    {
+        a_p_link->p_next         = a_p_head;
+        a_p_link->p_prev         = a_p_head->p_prev;
+        a_p_head->p_prev->p_next = a_p_link;
+        a_p_head->p_prev         = a_p_link;
+    }
+
+    static void unlink(Software_timer::Link* a_p_link)
+    {
+        a_p_link->p_prev->p_next = a_p_link->p_next;
+        a_p_link->p_next->p_prev = a_p_link->p_prev;
+
+        a_p_link->p_next = nullptr;
+        a_p_link->p_prev = nullptr;
+    }
+
+    // all links of a_p_from to (empty) a_p_to, O(1)
+    static void move(Software_timer::Link* a_p_from, Software_timer::Link* a_p_to)
+    {
+        initialize(a_p_to);
+
+        if (a_p_from->p_next != a_p_from)
+        {
+            a_p_to->p_next         = a_p_from->p_next;
+            a_p_to->p_prev         = a_p_from->p_prev;
+            a_p_to->p_next->p_prev = a_p_to;
+            a_p_to->p_prev->p_next = a_p_to;
+
+            initialize(a_p_from);
+        }
+    }
+
+    void insert(Software_timer* a_p_timer)
+    {
+        const time::tick delta = a_p_timer->expires - this->now;
+        const time::tick slot_time = delta > max_delay ? this->now + max_delay : a_p_timer->expires;
+        const time::tick span      = delta > max_delay ? max_delay : delta;
+
+        uint32_t level = 0;
+
+        while (level + 1 < levels && span >= (0x1u << (slot_bits * (level + 1))))
+        {
+            level++;
+        }
+
+        push_back(&(this->slots[level][(slot_time >> (slot_bits * level)) & slot_mask]), &(a_p_timer->link));
+    }
+
+    void cancel(Software_timer* a_p_timer)
+    {
+        if (true == a_p_timer->is_active())
+        {
+            unlink(&(a_p_timer->link));
+        }
+
+        if (true == a_p_timer->is_pending())
+        {
+            unlink(&(a_p_timer->deferred_link));
+        }
+    }
+
+    void cascade(uint32_t a_level, uint32_t a_slot)
+    {
+        Software_timer::Link timers;
+        move(&(this->slots[a_level][a_slot]), &timers);
+
+        while (timers.p_next != &timers)
+        {
+            Software_timer* p_timer = timers.p_next->p_timer;
+
+            unlink(&(p_timer->link));
+            this->insert(p_timer);
+        }
+    }
+
+    void expire(Software_timer* a_p_timer)
+    {
+        if (a_p_timer->period > 0)
+        {
+            a_p_timer->expires += a_p_timer->period;
+            this->insert(a_p_timer);
+        }
+
+        if (Software_timer::Context::interrupt == a_p_timer->context)
+        {
+            a_p_timer->callback.function(a_p_timer->callback.p_user_data);
+        }
+        else if (false == a_p_timer->is_pending())
+        {
+            push_back(&(this->deferred), &(a_p_timer->deferred_link));
+        }
+        else
+        {
+            a_p_timer->overruns++;
+        }
+    }
+
+private:
+
+    volatile time::tick now;
+
+    Software_timer::Link slots[levels][slots_count];
+    Software_timer::Link deferred;
+};
+
+} // namespace utils
+} // namespace cml
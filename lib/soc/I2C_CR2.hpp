@@ -0,0 +1,75 @@
+#pragma once
+
+/*
+    Name: I2C_CR2.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#ifdef STM32L452xx
+#include <stm32l4xx.h>
+#endif // STM32L452xx
+
+#ifdef STM32L011xx
+#include <stm32l0xx.h>
+#endif // STM32L011xx
+
+//cml
+#include <cml/bit.hpp>
+
+namespace soc {
+
+/*
+    NBYTES/RELOAD/PECBYTE fields of the I2C v2 CR2 register (STM32L0/L4).
+    Transfers above 255 bytes are sent in reload segments: get_NBYTES() takes the next segment out of
+    a_p_bytes_to_reload and sets RELOAD while bytes are left, reload_NBYTES() programs it at TCR.
+    With PEC enabled (CR1.PECEN) the PEC byte is counted in the last segment.
+*/
+class I2C_CR2
+{
+public:
+
+    I2C_CR2()               = delete;
+    I2C_CR2(I2C_CR2&&)      = delete;
+    I2C_CR2(const I2C_CR2&) = delete;
+    ~I2C_CR2()              = delete;
+
+    I2C_CR2& operator = (I2C_CR2&&)      = delete;
+    I2C_CR2& operator = (const I2C_CR2&) = delete;
+
+    static constexpr uint32_t get_NBYTES(uint32_t* a_p_bytes_to_reload)
+    {
+        const uint32_t nbytes = *a_p_bytes_to_reload > 255 ? 255 : *a_p_bytes_to_reload;
+
+        (*a_p_bytes_to_reload) -= nbytes;
+
+        return ((nbytes << I2C_CR2_NBYTES_Pos) & I2C_CR2_NBYTES_Msk) | (*a_p_bytes_to_reload > 0 ? I2C_CR2_RELOAD : 0);
+    }
+
+    static constexpr uint32_t get_NBYTES_PECBYTE(bool a_pec, uint32_t* a_p_bytes_to_reload)
+    {
+        if (true == a_pec)
+        {
+            (*a_p_bytes_to_reload)++;
+        }
+
+        return get_NBYTES(a_p_bytes_to_reload) | (true == a_pec ? I2C_CR2_PECBYTE : 0);
+    }
+
+    static uint32_t get_NBYTES_PECBYTE(const I2C_TypeDef* a_p_registers, uint32_t* a_p_bytes_to_reload)
+    {
+        return get_NBYTES_PECBYTE(cml::is_flag(a_p_registers->CR1, I2C_CR1_PECEN), a_p_bytes_to_reload);
+    }
+
+    static void reload_NBYTES(I2C_TypeDef* a_p_registers, uint32_t* a_p_bytes_to_reload)
+    {
+        cml::set_flag(&(a_p_registers->CR2), I2C_CR2_NBYTES | I2C_CR2_RELOAD, get_NBYTES(a_p_bytes_to_reload));
+    }
+};
+
+} // namespace soc
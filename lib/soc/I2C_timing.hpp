@@ -0,0 +1,224 @@
+#pragma once
+
+/*
+    Name: I2C_timing.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/frequency.hpp>
+
+namespace soc {
+
+/*
+    TIMINGR solver for the I2C v2 peripheral (STM32L0/L4), see RM "I2C timings" and AN4235.
+    Times are given in nanoseconds. calculate() returns the setting with the highest SCL frequency
+    which does not exceed the mode limit and meets the mode tLOW/tHIGH/tSU;DAT/tVD;DAT requirements.
+    The arithmetic is exact: times are kept in ns * kernel clock frequency (a kernel clock period is 10^9),
+    so tI2CCLK is not rounded. Without rise/fall times the typical values of the mode are assumed
+    (Sm: 640/20 ns, Fm: 250/100 ns, Fm+: 60/100 ns).
+
+    constexpr uint32_t timingr = I2C_timing::calculate(MHz(16), I2C_timing::Mode::fast).get_TIMINGR();
+*/
+class I2C_timing
+{
+public:
+
+    enum class Mode : uint32_t
+    {
+        standard,
+        fast,
+        fast_plus
+    };
+
+    struct Result
+    {
+        uint32_t presc  = 0;
+        uint32_t scldel = 0;
+        uint32_t sdadel = 0;
+        uint32_t sclh   = 0;
+        uint32_t scll   = 0;
+
+        cml::frequency scl_frequency_hz = 0;
+        bool valid                      = false;
+
+        constexpr uint32_t get_TIMINGR() const
+        {
+            return (this->presc << 28u) | (this->scldel << 20u) | (this->sdadel << 16u) | (this->sclh << 8u) | this->scll;
+        }
+    };
+
+public:
+
+    I2C_timing()                  = delete;
+    I2C_timing(I2C_timing&&)      = delete;
+    I2C_timing(const I2C_timing&) = delete;
+    ~I2C_timing()                 = delete;
+
+    I2C_timing& operator = (I2C_timing&&)      = delete;
+    I2C_timing& operator = (const I2C_timing&) = delete;
+
+    static constexpr Result calculate(cml::frequency a_clock_frequency_hz, Mode a_mode)
+    {
+        const Specification specification = get_specification(a_mode);
+        return calculate(a_clock_frequency_hz, a_mode, specification.rise, specification.fall);
+    }
+
+    static constexpr Result calculate(cml::frequency a_clock_frequency_hz,
+                                      Mode a_mode,
+                                      uint32_t a_rise_time_ns,
+                                      uint32_t a_fall_time_ns,
+                                      bool a_analog_filter      = true,
+                                      uint32_t a_digital_filter = 0)
+    {
+        Result ret;
+
+        const Specification specification = get_specification(a_mode);
+
+        if (0 != a_clock_frequency_hz && a_digital_filter <= 15)
+        {
+            const int64_t f = static_cast<int64_t>(a_clock_frequency_hz);
+
+            // ns to ns * f, one kernel clock period is 10^9
+            auto ns = [f](int64_t a_value) { return a_value * f; };
+
+            const int64_t i2c_clock = 1000000000;
+
+            const int64_t rise = ns(a_rise_time_ns);
+            const int64_t fall = ns(a_fall_time_ns);
+            const int64_t dnf  = static_cast<int64_t>(a_digital_filter);
+
+            const int64_t af_delay_min = true == a_analog_filter ? ns(50) : 0;
+            const int64_t af_delay_max = true == a_analog_filter ? ns(260) : 0;
+            const int64_t dnf_delay    = dnf * i2c_clock;
+
+            const int64_t sdadel_min = max(fall - af_delay_min - (dnf + 3) * i2c_clock, 0);
+            const int64_t sdadel_max = ns(specification.vddat_max) - rise - af_delay_max - (dnf + 4) * i2c_clock;
+            const int64_t scldel_min = rise + ns(specification.sudat_min);
+
+            const int64_t tsync = af_delay_min + dnf_delay + 2 * i2c_clock;
+
+            // tSCL * rate compared with 10^9 * f: periods are not rounded either
+            const int64_t period_max_rate = 1000000000 * f;
+            const int64_t rate_max        = static_cast<int64_t>(specification.rate_max);
+            const int64_t rate_min        = static_cast<int64_t>(specification.rate_min);
+            const int64_t clk_min         = (period_max_rate + rate_max - 1) / rate_max;
+
+            int64_t best_tscl = 0;
+
+            for (uint32_t presc = 0; presc < 16 && sdadel_max >= sdadel_min; presc++)
+            {
+                const int64_t prescaler = static_cast<int64_t>(presc + 1) * i2c_clock;
+
+                uint32_t scldel = 16;
+                uint32_t sdadel = 16;
+
+                for (uint32_t l = 0; l < 16 && 16 == sdadel; l++)
+                {
+                    if (static_cast<int64_t>(l + 1) * prescaler >= scldel_min)
+                    {
+                        for (uint32_t a = 0; a < 16 && 16 == sdadel; a++)
+                        {
+                            const int64_t t_sdadel = static_cast<int64_t>(a) * prescaler;
+
+                            if (t_sdadel >= sdadel_min && t_sdadel <= sdadel_max)
+                            {
+                                scldel = l;
+                                sdadel = a;
+                            }
+                        }
+                    }
+                }
+
+                for (uint32_t l = 0; l < 256 && 16 != sdadel; l++)
+                {
+                    const int64_t tscl_l = static_cast<int64_t>(l + 1) * prescaler + tsync;
+
+                    if (tscl_l >= ns(specification.l_min) && 4 * i2c_clock < tscl_l - af_delay_min - dnf_delay)
+                    {
+                        const int64_t tscl_h_min = max(ns(specification.h_min),
+                                                       max(clk_min - tscl_l - rise - fall, i2c_clock + 1));
+                        const int64_t h          = max((tscl_h_min - tsync + prescaler - 1) / prescaler - 1, 0);
+
+                        if (h < 256)
+                        {
+                            const int64_t tscl_h = (h + 1) * prescaler + tsync;
+                            const int64_t tscl   = tscl_l + tscl_h + rise + fall;
+
+                            if (tscl * rate_max >= period_max_rate && tscl * rate_min <= period_max_rate &&
+                                (0 == best_tscl || tscl < best_tscl))
+                            {
+                                best_tscl = tscl;
+
+                                ret.presc  = presc;
+                                ret.scldel = scldel;
+                                ret.sdadel = sdadel;
+                                ret.sclh   = static_cast<uint32_t>(h);
+                                ret.scll   = l;
+
+                                ret.scl_frequency_hz = static_cast<cml::frequency>((period_max_rate + tscl / 2) / tscl);
+                                ret.valid            = true;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return ret;
+    }
+
+private:
+
+    struct Specification
+    {
+        cml::frequency rate_min = 0;
+        cml::frequency rate_max = 0;
+
+        int64_t sudat_min = 0;
+        int64_t vddat_max = 0;
+        int64_t l_min     = 0;
+        int64_t h_min     = 0;
+
+        uint32_t rise = 0;
+        uint32_t fall = 0;
+    };
+
+    static constexpr Specification get_specification(Mode a_mode)
+    {
+        switch (a_mode)
+        {
+            case Mode::standard:
+            {
+                return { cml::kHz(80), cml::kHz(100), 250, 3450, 4700, 4000, 640, 20 };
+            }
+            break;
+
+            case Mode::fast:
+            {
+                return { cml::kHz(320), cml::kHz(400), 100, 900, 1300, 600, 250, 100 };
+            }
+            break;
+
+            case Mode::fast_plus:
+            {
+                return { cml::kHz(800), cml::MHz(1), 50, 450, 500, 260, 60, 100 };
+            }
+            break;
+        }
+
+        return {};
+    }
+
+    static constexpr int64_t max(int64_t a_left, int64_t a_right)
+    {
+        return a_left > a_right ? a_left : a_right;
+    }
+};
+
+} // namespace soc
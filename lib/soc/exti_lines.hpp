@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+    Name: exti_lines.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+namespace soc {
+
+/*
+    Register independent part of the EXTI controllers (STM32L0/L4), included after the device header
+    (__CLZ, __DMB come from the CMSIS core header).
+
+    dispatch(): the pending register is read once by the caller and masked with the lines of the handler,
+    only the set bits are visited (highest first). a_handler(line) returns true when the pending flag of
+    the line has to be cleared, the returned mask is written once to the write-1-to-clear pending register.
+
+    Event_queue: single producer (all EXTI interrupts have the same priority), single consumer (main loop)
+    queue of the deferred line events, overflow is counted.
+*/
+class exti_lines
+{
+public:
+
+    template<typename Event_t, uint32_t capacity>
+    class Event_queue
+    {
+    public:
+
+        static_assert(0 == (capacity & (capacity - 1u)), "capacity has to be a power of two");
+
+        bool push(const Event_t& a_event)
+        {
+            const uint32_t head = this->head;
+            const bool ret      = head - this->tail < capacity;
+
+            if (true == ret)
+            {
+                this->events[head % capacity] = a_event;
+                __DMB();
+                this->head = head + 1;
+            }
+            else
+            {
+                this->dropped = this->dropped + 1;
+            }
+
+            return ret;
+        }
+
+        bool read(Event_t* a_p_event)
+        {
+            const uint32_t tail = this->tail;
+            const bool ret      = tail != this->head;
+
+            if (true == ret)
+            {
+                __DMB();
+                (*a_p_event) = this->events[tail % capacity];
+                __DMB();
+                this->tail = tail + 1;
+            }
+
+            return ret;
+        }
+
+        uint32_t get_dropped_count() const
+        {
+            return this->dropped;
+        }
+
+    private:
+
+        Event_t events[capacity];
+
+        volatile uint32_t head    = 0;
+        volatile uint32_t tail    = 0;
+        volatile uint32_t dropped = 0;
+    };
+
+public:
+
+    exti_lines()                  = delete;
+    exti_lines(exti_lines&&)      = delete;
+    exti_lines(const exti_lines&) = delete;
+
+    exti_lines& operator = (exti_lines&&)      = delete;
+    exti_lines& operator = (const exti_lines&) = delete;
+
+    template<typename Handler_t>
+    static uint32_t dispatch(uint32_t a_pending, Handler_t&& a_handler)
+    {
+        uint32_t clear = 0;
+
+        while (0 != a_pending)
+        {
+            const uint32_t index = 31u - __CLZ(a_pending);
+            const uint32_t flag  = 0x1u << index;
+
+            if (true == a_handler(index))
+            {
+                clear |= flag;
+            }
+
+            a_pending &= ~flag;
+        }
+
+        return clear;
+    }
+};
+
+} // namespace soc
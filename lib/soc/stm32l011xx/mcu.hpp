@@ -174,6 +174,36 @@ struct mcu
         APB2 apb2 = APB2::unknown;
     };
 
+    /*
+        Interrupts disabled (PRIMASK) for the lifetime of the guard, the previous state is restored
+        in the destructor, so guards nest and are safe in interrupt handlers.
+    */
+    class Interrupt_guard
+    {
+    public:
+
+        Interrupt_guard()
+            : primask(__get_PRIMASK())
+        {
+            __disable_irq();
+        }
+
+        ~Interrupt_guard()
+        {
+            __set_PRIMASK(this->primask);
+        }
+
+        Interrupt_guard(Interrupt_guard&&)      = delete;
+        Interrupt_guard(const Interrupt_guard&) = delete;
+
+        Interrupt_guard& operator = (Interrupt_guard&&)      = delete;
+        Interrupt_guard& operator = (const Interrupt_guard&) = delete;
+
+    private:
+
+        const uint32_t primask;
+    };
+
 public:
 
     static void enable_msi_clock(Msi_frequency a_freq);
@@ -438,6 +438,127 @@ void pin::af::disable(GPIO* a_p_port, uint32_t a_id)
     a_p_port->give_pin(a_id);
 }
 
+void pin::Bus::set_direction(Direction a_direction)
+{
+    assert(nullptr != this->p_registers);
+
+    set_flag(&(this->p_registers->MODER),
+             this->moder_mask,
+             Direction::out == a_direction ? this->moder_mask & 0x55555555u : 0x0u);
+}
+
+void pin::bus::enable(GPIO* a_p_port, const uint8_t* a_p_ids, uint32_t a_width, const out::Config& a_config, Bus* a_p_out_bus)
+{
+    assert(nullptr != a_p_port);
+    assert(nullptr != a_p_ids);
+    assert(a_width > 0 && a_width <= 16);
+
+    uint32_t mask       = 0;
+    uint32_t moder_mask = 0;
+    bool contiguous     = true;
+
+    for (uint32_t i = 0; i < a_width; i++)
+    {
+        assert(0 == (mask & (0x1u << a_p_ids[i])));
+
+        out::enable(a_p_port, a_p_ids[i], a_config);
+
+        mask       |= 0x1u << a_p_ids[i];
+        moder_mask |= 0x3u << (a_p_ids[i] * 2);
+        contiguous  = contiguous && a_p_ids[i] == a_p_ids[0] + i;
+    }
+
+    if (nullptr != a_p_out_bus)
+    {
+        a_p_out_bus->p_port      = a_p_port;
+        a_p_out_bus->p_registers = static_cast<GPIO_TypeDef*>(*(a_p_port));
+        a_p_out_bus->mask        = mask;
+        a_p_out_bus->moder_mask  = moder_mask;
+        a_p_out_bus->width       = static_cast<uint8_t>(a_width);
+        a_p_out_bus->shift       = a_p_ids[0];
+        a_p_out_bus->contiguous  = contiguous;
+
+        for (uint32_t i = 0; i < a_width; i++)
+        {
+            a_p_out_bus->ids[i] = a_p_ids[i];
+        }
+    }
+}
+
+void pin::bus::disable(GPIO* a_p_port, const uint8_t* a_p_ids, uint32_t a_width)
+{
+    assert(nullptr != a_p_ids);
+    assert(a_width <= 16);
+
+    for (uint32_t i = 0; i < a_width; i++)
+    {
+        out::disable(a_p_port, a_p_ids[i]);
+    }
+}
+
+void pin::table::enable(GPIO* a_p_port, const Image& a_image)
+{
+    assert(nullptr != a_p_port);
+    assert(true == a_p_port->is_enabled());
+    assert(true == a_image.valid);
+    assert(0 == (a_p_port->flags & a_image.pins));
+
+    GPIO_TypeDef* p_port = static_cast<GPIO_TypeDef*>(*(a_p_port));
+
+    uint32_t mask_1bit = 0;
+    uint32_t mask_2bit = 0;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        if (true == is_bit(a_image.pins, i))
+        {
+            mask_1bit |= 0x1u << i;
+            mask_2bit |= 0x3u << (i * 2u);
+        }
+    }
+
+    p_port->BSRR    = a_image.bsrr;
+    p_port->OTYPER  = (p_port->OTYPER & ~mask_1bit) | a_image.otyper;
+    p_port->OSPEEDR = (p_port->OSPEEDR & ~mask_2bit) | a_image.ospeedr;
+    p_port->PUPDR   = (p_port->PUPDR & ~mask_2bit) | a_image.pupdr;
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (0 != a_image.afr_mask[i])
+        {
+            p_port->AFR[i] = (p_port->AFR[i] & ~a_image.afr_mask[i]) | a_image.afr[i];
+        }
+    }
+
+    p_port->MODER = (p_port->MODER & ~mask_2bit) | a_image.moder;
+
+    a_p_port->flags |= a_image.pins;
+}
+
+void pin::table::disable(GPIO* a_p_port, const Image& a_image)
+{
+    assert(nullptr != a_p_port);
+    assert(true == a_p_port->is_enabled());
+
+    GPIO_TypeDef* p_port = static_cast<GPIO_TypeDef*>(*(a_p_port));
+
+    uint32_t mask_2bit = 0;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        if (true == is_bit(a_image.pins, i))
+        {
+            mask_2bit |= 0x3u << (i * 2u);
+        }
+    }
+
+    p_port->MODER   = p_port->MODER | mask_2bit;
+    p_port->OSPEEDR = p_port->OSPEEDR & ~mask_2bit;
+    p_port->PUPDR   = p_port->PUPDR & ~mask_2bit;
+
+    a_p_port->flags &= ~a_image.pins;
+}
+
 } // namespace peripherals
 } // namespace stm32l011xx
 } // namespace soc
@@ -12,7 +12,9 @@
 
 //soc
 #include <soc/counter.hpp>
+#include <soc/I2C_CR2.hpp>
 #include <soc/stm32l011xx/mcu.hpp>
+#include <soc/stm32l011xx/misc.hpp>
 
 //cml
 #include <cml/utils/wait.hpp>
@@ -21,6 +23,7 @@ namespace {
 
 using namespace cml;
 using namespace soc::stm32l011xx::peripherals;
+using soc::I2C_CR2;
 
 struct Controller
 {
@@ -89,6 +92,91 @@ I2C_base::Bus_status_flag get_bus_status_flag_from_I2C_ISR(uint32_t a_isr)
         ret |= I2C_base::Bus_status_flag::nack;
     }
 
+    if (true == is_flag(a_isr, I2C_ISR_PECERR))
+    {
+        ret |= I2C_base::Bus_status_flag::crc_error;
+    }
+
+    return ret;
+}
+
+void set_I2C_slave_CR2_PECBYTE(uint32_t a_data_size_in_bytes)
+{
+    if (true == is_flag(I2C1->CR1, I2C_CR1_PECEN))
+    {
+        assert(a_data_size_in_bytes < 0xFF);
+
+        uint32_t bytes_to_reload = a_data_size_in_bytes;
+
+        set_flag(&(I2C1->CR1), I2C_CR1_SBC);
+        I2C1->CR2 = I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload);
+    }
+}
+
+/*
+    Timed out master transfer: STOP is requested, if a slave holds SCL low the STOP never completes and
+    the peripheral is reset (PE cleared until it reads back 0) to release SCL and SDA.
+    A slave still holding SDA needs I2C_master::recover_bus.
+*/
+constexpr cml::time::tick master_stop_timeout = 2;
+
+void abort_I2C_master_transfer()
+{
+    set_flag(&(I2C1->CR2), I2C_CR2_STOP);
+
+    if (false == cml::utils::wait::until(&(I2C1->ISR), I2C_ISR_STOPF, false, soc::counter::get(), master_stop_timeout))
+    {
+        clear_flag(&(I2C1->CR1), I2C_CR1_PE);
+        cml::utils::wait::until(&(I2C1->CR1), I2C_CR1_PE, true);
+        set_flag(&(I2C1->CR1), I2C_CR1_PE);
+    }
+}
+
+/*
+    Bus recovery (I2C specification 3.1.16): up to 9 SCL pulses with SCL/SDA as open drain outputs
+    until the slave releases SDA, then a STOP condition.
+*/
+constexpr uint32_t bus_recovery_half_period_us = 5;
+constexpr uint32_t bus_recovery_pulses         = 9;
+
+void set_I2C_recovery_pin(GPIO_TypeDef* a_p_port, uint32_t a_id, bool a_output)
+{
+    set_flag(&(a_p_port->MODER), 0x3u << (a_id * 2), (true == a_output ? 0x1u : 0x2u) << (a_id * 2));
+}
+
+void set_I2C_recovery_level(GPIO_TypeDef* a_p_port, uint32_t a_id, bool a_high)
+{
+    a_p_port->BSRR = 0x1u << (true == a_high ? a_id : a_id + 16);
+    soc::stm32l011xx::misc::delay_us(bus_recovery_half_period_us);
+}
+
+bool clock_I2C_bus_free(GPIO_TypeDef* a_p_scl_port, uint32_t a_scl, GPIO_TypeDef* a_p_sda_port, uint32_t a_sda)
+{
+    set_flag(&(a_p_scl_port->OTYPER), 0x1u << a_scl);
+    set_flag(&(a_p_sda_port->OTYPER), 0x1u << a_sda);
+
+    a_p_scl_port->BSRR = 0x1u << a_scl;
+    a_p_sda_port->BSRR = 0x1u << a_sda;
+
+    set_I2C_recovery_pin(a_p_scl_port, a_scl, true);
+    set_I2C_recovery_pin(a_p_sda_port, a_sda, true);
+
+    for (uint32_t i = 0; i < bus_recovery_pulses && false == is_bit(a_p_sda_port->IDR, a_sda); i++)
+    {
+        set_I2C_recovery_level(a_p_scl_port, a_scl, false);
+        set_I2C_recovery_level(a_p_scl_port, a_scl, true);
+    }
+
+    set_I2C_recovery_level(a_p_scl_port, a_scl, false);
+    set_I2C_recovery_level(a_p_sda_port, a_sda, false);
+    set_I2C_recovery_level(a_p_scl_port, a_scl, true);
+    set_I2C_recovery_level(a_p_sda_port, a_sda, true);
+
+    const bool ret = is_bit(a_p_scl_port->IDR, a_scl) && is_bit(a_p_sda_port->IDR, a_sda);
+
+    set_I2C_recovery_pin(a_p_scl_port, a_scl, false);
+    set_I2C_recovery_pin(a_p_sda_port, a_sda, false);
+
     return ret;
 }
 
@@ -165,7 +253,7 @@ void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
         {
             this->tx_callback.function(nullptr, true, this->tx_callback.p_user_data);
 
-            clear_flag(&(I2C1->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
+            clear_flag(&(I2C1->CR1), I2C_CR1_TXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 
             this->tx_callback = { nullptr, nullptr };
         }
@@ -174,7 +262,7 @@ void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
         {
             this->rx_callback.function(0, true, this->rx_callback.p_user_data);
 
-            clear_flag(&(I2C1->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
+            clear_flag(&(I2C1->CR1), I2C_CR1_RXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 
             this->rx_callback = { nullptr, nullptr };
         }
@@ -183,15 +271,31 @@ void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
     }
 }
 
+void I2C_base::tcr_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
+{
+    if (true == is_flag(a_isr, I2C_ISR_TCR) && true == is_flag(a_cr1, I2C_CR1_TCIE))
+    {
+        I2C_CR2::reload_NBYTES(I2C1, &(this->bytes_to_reload));
+    }
+}
+
 void i2c_master_interrupt_handler(I2C_master* a_p_this)
 {
     const uint32_t isr = I2C1->ISR;
     const uint32_t cr1 = I2C1->CR1;
 
-    a_p_this->bus_status_interrupt_handler(isr);
-    a_p_this->rxne_interrupt_handler(isr, cr1);
-    a_p_this->txe_interrupt_handler(isr, cr1);
-    a_p_this->stopf_interrupt_handler(isr, cr1);
+    if (true == a_p_this->is_write_read_active())
+    {
+        a_p_this->write_read_interrupt_handler(isr);
+    }
+    else
+    {
+        a_p_this->bus_status_interrupt_handler(isr);
+        a_p_this->rxne_interrupt_handler(isr, cr1);
+        a_p_this->txe_interrupt_handler(isr, cr1);
+        a_p_this->tcr_interrupt_handler(isr, cr1);
+        a_p_this->stopf_interrupt_handler(isr, cr1);
+    }
 }
 
 void i2c_slave_interrupt_handler(I2C_slave* a_p_this)
@@ -230,6 +334,7 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
 
     assert(nullptr == controller.p_i2c_master_handle);
     assert(nullptr == controller.p_i2c_slave_handle);
+    assert(a_config.digital_filter <= 0xF);
 
     i2c_1_enable(static_cast<uint32_t>(a_clock_source) << RCC_CCIPR_I2C1SEL_Pos, a_irq_priority);
     controller.p_i2c_master_handle = this;
@@ -238,6 +343,7 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
     I2C1->TIMINGR = a_config.timings;
 
     I2C1->CR1 = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
+                (a_config.digital_filter << I2C_CR1_DNF_Pos)              |
                 (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)      |
                 I2C_CR1_PE;
 
@@ -270,12 +376,13 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = (static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos) & I2C_CR2_NBYTES_Msk ;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    I2C1->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND;
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
+
+    I2C1->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND;
 
     uint32_t ret = 0;
     bool error = false;
@@ -288,6 +395,11 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
             I2C1->TXDR = static_cast<const uint8_t*>(a_p_data)[ret++];
         }
 
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
+        }
+
         error = is_I2C_ISR_error(I2C1->ISR);
     }
 
@@ -310,15 +422,16 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    I2C1->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND;
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
+
+    I2C1->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND;
 
     uint32_t ret = 0;
     bool error = false;
@@ -333,6 +446,11 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
             I2C1->TXDR = static_cast<const uint8_t*>(a_p_data)[ret++];
         }
 
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
+        }
+
         error = is_I2C_ISR_error(I2C1->ISR);
     }
 
@@ -341,6 +459,10 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
         bus_status = get_bus_status_flag_from_I2C_ISR(I2C1->ISR);
         clear_I2C_ISR_errors(&(I2C1->ICR));
     }
+    else if (false == is_flag(I2C1->ISR, I2C_ISR_STOPF))
+    {
+        bus_status = Bus_status_flag::timeout;
+    }
 
     set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
     I2C1->CR2 = 0;
@@ -354,12 +476,13 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
 
-    I2C1->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+    I2C1->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
 
     uint32_t ret = 0;
     bool error = false;
@@ -367,9 +490,19 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
 
     while (false == is_flag(I2C1->ISR, I2C_ISR_STOPF) && false == error)
     {
-        if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE) && ret < a_data_size_in_bytes)
+        if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE))
+        {
+            const uint8_t rxdr = static_cast<uint8_t>(I2C1->RXDR);
+
+            if (ret < a_data_size_in_bytes)
+            {
+                static_cast<uint8_t*>(a_p_data)[ret++] = rxdr;
+            }
+        }
+
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
         {
-            static_cast<uint8_t*>(a_p_data)[ret++] = static_cast<uint8_t>(I2C1->RXDR);
+            I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
         }
 
         error = is_I2C_ISR_error(I2C1->ISR);
@@ -394,15 +527,16 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
 
-    I2C1->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+    I2C1->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
 
     uint32_t ret = 0;
     bool error = false;
@@ -412,9 +546,19 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
            false == error &&
            a_timeout >= time::diff(counter::get(), start))
     {
-        if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE) && ret < a_data_size_in_bytes)
+        if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE))
         {
-            static_cast<uint8_t*>(a_p_data)[ret++] = static_cast<uint8_t>(I2C1->RXDR);
+            const uint8_t rxdr = static_cast<uint8_t>(I2C1->RXDR);
+
+            if (ret < a_data_size_in_bytes)
+            {
+                static_cast<uint8_t*>(a_p_data)[ret++] = rxdr;
+            }
+        }
+
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
         }
 
         error = is_I2C_ISR_error(I2C1->ISR);
@@ -425,6 +569,10 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
         bus_status = get_bus_status_flag_from_I2C_ISR(I2C1->ISR);
         clear_I2C_ISR_errors(&(I2C1->ICR));
     }
+    else if (false == is_flag(I2C1->ISR, I2C_ISR_STOPF))
+    {
+        bus_status = Bus_status_flag::timeout;
+    }
 
     set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
     I2C1->CR2 = 0;
@@ -438,16 +586,16 @@ void I2C_master::register_transmit_callback(uint16_t a_slave_address,
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->rx_callback = { nullptr, nullptr };
     this->tx_callback = a_callback;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    I2C1->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND;
-    set_flag(&(I2C1->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE);
+    this->bytes_to_reload = a_data_size_in_bytes;
+    I2C1->CR2             = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &(this->bytes_to_reload)) | I2C_CR2_START | I2C_CR2_AUTOEND;
+    set_flag(&(I2C1->CR1), I2C_CR1_TXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE);
 }
 
 void I2C_master::register_receive_callback(uint16_t a_slave_address,
@@ -456,16 +604,297 @@ void I2C_master::register_receive_callback(uint16_t a_slave_address,
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->tx_callback = { nullptr, nullptr };
     this->rx_callback = a_callback;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    I2C1->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
-    set_flag(&(I2C1->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE);
+    this->bytes_to_reload = a_data_size_in_bytes;
+    I2C1->CR2             = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &(this->bytes_to_reload)) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+    set_flag(&(I2C1->CR1), I2C_CR1_RXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE);
+}
+
+I2C_master::Result I2C_master::write_read_polling(uint16_t a_slave_address,
+                                                  const void* a_p_tx_data,
+                                                  uint32_t a_tx_data_size_in_bytes,
+                                                  void* a_p_rx_data,
+                                                  uint32_t a_rx_data_size_in_bytes)
+{
+    assert(nullptr != controller.p_i2c_master_handle);
+    assert(nullptr != a_p_tx_data);
+    assert(nullptr != a_p_rx_data);
+    assert(a_tx_data_size_in_bytes > 0);
+    assert(a_rx_data_size_in_bytes > 0);
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    uint32_t bytes_to_reload = a_tx_data_size_in_bytes;
+
+    I2C1->CR2 = address_mask | I2C_CR2::get_NBYTES(&bytes_to_reload) | I2C_CR2_START;
+
+    uint32_t tx_words = 0;
+    uint32_t rx_words = 0;
+    bool error = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
+
+    while (false == is_flag(I2C1->ISR, I2C_ISR_TC) && false == error)
+    {
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TXE) && tx_words < a_tx_data_size_in_bytes)
+        {
+            I2C1->TXDR = static_cast<const uint8_t*>(a_p_tx_data)[tx_words++];
+        }
+
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
+        }
+
+        error = is_I2C_ISR_error(I2C1->ISR);
+    }
+
+    if (false == error)
+    {
+        bytes_to_reload = a_rx_data_size_in_bytes;
+        I2C1->CR2       = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+
+        while (false == is_flag(I2C1->ISR, I2C_ISR_STOPF) && false == error)
+        {
+            if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE))
+            {
+                const uint8_t rxdr = static_cast<uint8_t>(I2C1->RXDR);
+
+                if (rx_words < a_rx_data_size_in_bytes)
+                {
+                    static_cast<uint8_t*>(a_p_rx_data)[rx_words++] = rxdr;
+                }
+            }
+
+            if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+            {
+                I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
+            }
+
+            error = is_I2C_ISR_error(I2C1->ISR);
+        }
+    }
+
+    if (true == error)
+    {
+        bus_status = get_bus_status_flag_from_I2C_ISR(I2C1->ISR);
+        clear_I2C_ISR_errors(&(I2C1->ICR));
+    }
+
+    set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
+    I2C1->CR2 = 0;
+
+    return { bus_status, tx_words + rx_words };
+}
+
+I2C_master::Result I2C_master::write_read_polling(uint16_t a_slave_address,
+                                                  const void* a_p_tx_data,
+                                                  uint32_t a_tx_data_size_in_bytes,
+                                                  void* a_p_rx_data,
+                                                  uint32_t a_rx_data_size_in_bytes,
+                                                  time::tick a_timeout)
+{
+    assert(nullptr != controller.p_i2c_master_handle);
+    assert(nullptr != a_p_tx_data);
+    assert(nullptr != a_p_rx_data);
+    assert(a_tx_data_size_in_bytes > 0);
+    assert(a_rx_data_size_in_bytes > 0);
+    assert(a_timeout > 0);
+
+    time::tick start = counter::get();
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    uint32_t bytes_to_reload = a_tx_data_size_in_bytes;
+
+    I2C1->CR2 = address_mask | I2C_CR2::get_NBYTES(&bytes_to_reload) | I2C_CR2_START;
+
+    uint32_t tx_words = 0;
+    uint32_t rx_words = 0;
+    bool error = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
+
+    while (false == is_flag(I2C1->ISR, I2C_ISR_TC) &&
+           false == error &&
+           a_timeout >= time::diff(counter::get(), start))
+    {
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TXE) && tx_words < a_tx_data_size_in_bytes)
+        {
+            I2C1->TXDR = static_cast<const uint8_t*>(a_p_tx_data)[tx_words++];
+        }
+
+        if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
+        }
+
+        error = is_I2C_ISR_error(I2C1->ISR);
+    }
+
+    if (false == error && true == is_flag(I2C1->ISR, I2C_ISR_TC))
+    {
+        bytes_to_reload = a_rx_data_size_in_bytes;
+        I2C1->CR2       = address_mask | I2C_CR2::get_NBYTES_PECBYTE(I2C1, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+
+        while (false == is_flag(I2C1->ISR, I2C_ISR_STOPF) &&
+               false == error &&
+               a_timeout >= time::diff(counter::get(), start))
+        {
+            if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE))
+            {
+                const uint8_t rxdr = static_cast<uint8_t>(I2C1->RXDR);
+
+                if (rx_words < a_rx_data_size_in_bytes)
+                {
+                    static_cast<uint8_t*>(a_p_rx_data)[rx_words++] = rxdr;
+                }
+            }
+
+            if (true == is_flag(I2C1->ISR, I2C_ISR_TCR))
+            {
+                I2C_CR2::reload_NBYTES(I2C1, &bytes_to_reload);
+            }
+
+            error = is_I2C_ISR_error(I2C1->ISR);
+        }
+    }
+
+    if (true == error)
+    {
+        bus_status = get_bus_status_flag_from_I2C_ISR(I2C1->ISR);
+        clear_I2C_ISR_errors(&(I2C1->ICR));
+    }
+    else if (false == is_flag(I2C1->ISR, I2C_ISR_STOPF))
+    {
+        bus_status = Bus_status_flag::timeout;
+        abort_I2C_master_transfer();
+    }
+
+    set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
+    I2C1->CR2 = 0;
+
+    return { bus_status, tx_words + rx_words };
+}
+
+void I2C_master::write_read_it(uint16_t a_slave_address,
+                               const void* a_p_tx_data,
+                               uint32_t a_tx_data_size_in_bytes,
+                               void* a_p_rx_data,
+                               uint32_t a_rx_data_size_in_bytes,
+                               const Transfer_callback& a_callback)
+{
+    assert(nullptr != controller.p_i2c_master_handle);
+    assert(nullptr != a_p_tx_data);
+    assert(nullptr != a_p_rx_data);
+    assert(nullptr != a_callback.complete);
+    assert(false == this->is_write_read_active());
+    assert(a_tx_data_size_in_bytes > 0);
+    assert(a_rx_data_size_in_bytes > 0);
+
+    this->write_read.p_tx_data             = static_cast<const uint8_t*>(a_p_tx_data);
+    this->write_read.p_rx_data             = static_cast<uint8_t*>(a_p_rx_data);
+    this->write_read.tx_data_size_in_bytes = a_tx_data_size_in_bytes;
+    this->write_read.rx_data_size_in_bytes = a_rx_data_size_in_bytes;
+    this->write_read.tx_words              = 0;
+    this->write_read.rx_words              = 0;
+    this->write_read.address_mask          = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+    this->write_read.bus_status            = Bus_status_flag::ok;
+    this->write_read.callback              = a_callback;
+
+    set_flag(&(I2C1->CR1), I2C_CR1_TXIE   |
+                           I2C_CR1_RXIE   |
+                           I2C_CR1_TCIE   |
+                           I2C_CR1_STOPIE |
+                           I2C_CR1_NACKIE |
+                           I2C_CR1_ERRIE);
+
+    this->bytes_to_reload = a_tx_data_size_in_bytes;
+    I2C1->CR2             = this->write_read.address_mask | I2C_CR2::get_NBYTES(&(this->bytes_to_reload)) | I2C_CR2_START;
+}
+
+void I2C_master::write_read_interrupt_handler(uint32_t a_isr)
+{
+    if (true == is_I2C_ISR_error(a_isr))
+    {
+        this->write_read.bus_status |= get_bus_status_flag_from_I2C_ISR(a_isr);
+        clear_I2C_ISR_errors(&(I2C1->ICR));
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TXIS) &&
+        this->write_read.tx_words < this->write_read.tx_data_size_in_bytes)
+    {
+        I2C1->TXDR = this->write_read.p_tx_data[this->write_read.tx_words++];
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_RXNE))
+    {
+        const uint8_t rxdr = static_cast<uint8_t>(I2C1->RXDR);
+
+        if (this->write_read.rx_words < this->write_read.rx_data_size_in_bytes)
+        {
+            this->write_read.p_rx_data[this->write_read.rx_words++] = rxdr;
+        }
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TCR))
+    {
+        I2C_CR2::reload_NBYTES(I2C1, &(this->bytes_to_reload));
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TC))
+    {
+        this->bytes_to_reload = this->write_read.rx_data_size_in_bytes;
+        I2C1->CR2             = this->write_read.address_mask                       |
+                                I2C_CR2::get_NBYTES_PECBYTE(I2C1, &(this->bytes_to_reload)) |
+                                I2C_CR2_START                                       |
+                                I2C_CR2_AUTOEND                                     |
+                                I2C_CR2_RD_WRN;
+    }
+
+    if (true == is_any_bit(a_isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR) ||
+        true == is_flag(a_isr, I2C_ISR_STOPF))
+    {
+        this->write_read_end();
+    }
+}
+
+void I2C_master::write_read_end()
+{
+    const Write_read transfer = this->write_read;
+
+    clear_flag(&(I2C1->CR1), I2C_CR1_TXIE   |
+                             I2C_CR1_RXIE   |
+                             I2C_CR1_TCIE   |
+                             I2C_CR1_STOPIE |
+                             I2C_CR1_ERRIE  |
+                             (nullptr == this->bus_status_callback.function ? I2C_CR1_NACKIE : 0));
+
+    set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
+
+    if (true == is_flag(I2C1->ISR, I2C_ISR_RXNE))
+    {
+        static_cast<void>(I2C1->RXDR);
+    }
+
+    I2C1->CR2 = 0;
+
+    const uint32_t data_length = transfer.tx_words + transfer.rx_words;
+
+    this->write_read = Write_read();
+
+    if (Bus_status_flag::ok == transfer.bus_status)
+    {
+        transfer.callback.complete(data_length, transfer.callback.p_user_data);
+    }
+    else if (nullptr != transfer.callback.error)
+    {
+        transfer.callback.error(transfer.bus_status, data_length, transfer.callback.p_user_data);
+    }
 }
 
 void I2C_master::register_bus_status_callback(const Bus_status_callback& a_callback)
@@ -510,13 +939,38 @@ bool I2C_master::is_slave_connected(uint16_t a_slave_address, time::tick a_timeo
     return ret;
 }
 
+bool I2C_master::recover_bus(pin::Af* a_p_scl, pin::Af* a_p_sda)
+{
+    assert(nullptr != controller.p_i2c_master_handle);
+    assert(nullptr != a_p_scl);
+    assert(nullptr != a_p_sda);
+
+    clear_flag(&(I2C1->CR1), I2C_CR1_PE);
+
+    const bool ret = clock_I2C_bus_free(static_cast<GPIO_TypeDef*>(*(a_p_scl->get_port())),
+                                        a_p_scl->get_id(),
+                                        static_cast<GPIO_TypeDef*>(*(a_p_sda->get_port())),
+                                        a_p_sda->get_id());
+
+    clear_I2C_ISR_errors(&(I2C1->ICR));
+    set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
+
+    I2C1->CR2 = 0;
+    set_flag(&(I2C1->CR1), I2C_CR1_PE);
+
+    return ret;
+}
+
 void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
 {
     assert(false == this->is_enabled());
 
     assert(nullptr == controller.p_i2c_master_handle);
     assert(nullptr == controller.p_i2c_slave_handle);
+    assert(a_config.digital_filter <= 0xF);
     assert(a_config.address <= 0x7F);
+    assert(a_config.address_2 <= 0x7F);
+    assert(a_config.address_2_mask <= 7);
 
     i2c_1_enable(static_cast<uint32_t>(a_clock_source) << RCC_CCIPR_I2C1SEL_Pos, a_irq_priority);
     controller.p_i2c_slave_handle = this;
@@ -525,8 +979,19 @@ void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint
     I2C1->TIMINGR = a_config.timings;
 
     I2C1->OAR1 = I2C_OAR1_OA1EN | (a_config.address << 1);
+
+    if (true == a_config.address_2_enable)
+    {
+        I2C1->OAR2 = I2C_OAR2_OA2EN | (a_config.address_2_mask << I2C_OAR2_OA2MSK_Pos) | (a_config.address_2 << 1);
+    }
+    else
+    {
+        I2C1->OAR2 = 0;
+    }
+
     I2C1->CR1  = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
-                 (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)|
+                 (a_config.digital_filter << I2C_CR1_DNF_Pos)              |
+                 (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)      |
                  I2C_CR1_PE;
 
     if (true == a_config.fast_plus)
@@ -556,7 +1021,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data, uint32
 {
     assert(nullptr != controller.p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     constexpr uint32_t error_mask = I2C_ISR_TIMEOUT | I2C_ISR_PECERR | I2C_ISR_OVR | I2C_ISR_ARLO | I2C_ISR_BERR;
 
@@ -569,6 +1034,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data, uint32
     {
         if (true == is_flag(I2C1->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(a_data_size_in_bytes);
             set_flag(&(I2C1->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -603,7 +1069,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data,
 {
     assert(nullptr != controller.p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
@@ -620,6 +1086,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data,
     {
         if (true == is_flag(I2C1->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(a_data_size_in_bytes);
             set_flag(&(I2C1->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -652,7 +1119,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
 {
     assert(nullptr != controller.p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     uint32_t ret = 0;
     bool error = false;
@@ -663,6 +1130,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
     {
         if (true == is_flag(I2C1->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(a_data_size_in_bytes);
             set_flag(&(I2C1->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -697,7 +1165,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
 {
     assert(nullptr != controller.p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
@@ -712,6 +1180,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
     {
         if (true == is_flag(I2C1->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(a_data_size_in_bytes);
             set_flag(&(I2C1->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -745,11 +1214,12 @@ void I2C_slave::register_transmit_callback(const TX_callback& a_callback, uint32
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->rx_callback = { nullptr, nullptr };
     this->tx_callback = a_callback;
 
+    clear_flag(&(I2C1->CR1), I2C_CR1_SBC);
     set_flag(&(I2C1->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE | I2C_CR1_NACKIE);
 }
 
@@ -757,11 +1227,12 @@ void I2C_slave::register_receive_callback(const RX_callback& a_callback, uint32_
 {
     assert(nullptr != controller.p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->tx_callback = { nullptr, nullptr };
     this->rx_callback = a_callback;
 
+    clear_flag(&(I2C1->CR1), I2C_CR1_SBC);
     set_flag(&(I2C1->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 }
 
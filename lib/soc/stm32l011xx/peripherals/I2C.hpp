@@ -13,6 +13,9 @@
 //externals
 #include <stm32l0xx.h>
 
+//soc
+#include <soc/stm32l011xx/peripherals/GPIO.hpp>
+
 //cml
 #include <cml/bit.hpp>
 #include <cml/Non_copyable.hpp>
@@ -49,7 +52,8 @@ public:
         arbitration_lost = 0x4,
         misplaced        = 0x8,
         nack             = 0x10,
-        unknown          = 0x20
+        unknown          = 0x20,
+        timeout          = 0x40
     };
 
     struct Result
@@ -116,16 +120,20 @@ protected:
 
     I2C_base(Id a_id)
         : id(a_id)
+        , bytes_to_reload(0)
     {}
 
     void bus_status_interrupt_handler(uint32_t a_isr);
     void rxne_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
     void txe_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
     void stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
+    void tcr_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
 
 protected:
 
     Id id;
+    uint32_t bytes_to_reload;
+
     RX_callback rx_callback;
     TX_callback tx_callback;
     Bus_status_callback bus_status_callback;
@@ -160,12 +168,27 @@ public:
     using RX_callback         = I2C_base::RX_callback;
     using Bus_status_callback = I2C_base::Bus_status_callback;
 
+    struct Transfer_callback
+    {
+        using Complete_function = void(*)(uint32_t a_data_length, void* a_p_user_data);
+        using Error_function    = void(*)(Bus_status_flag a_bus_status, uint32_t a_data_length, void* a_p_user_data);
+
+        Complete_function complete = nullptr;
+        Error_function error       = nullptr;
+        void* p_user_data          = nullptr;
+    };
+
+    /*
+        crc_enable: SMBus PEC, appended to transmissions and checked on receptions (Bus_status_flag::crc_error),
+                    in receive callbacks the PEC is passed as the last byte
+    */
     struct Config
     {
-        bool analog_filter  = false;
-        bool fast_plus      = false;
-        bool crc_enable     = false;
-        uint32_t timings    = 0;
+        bool analog_filter      = false;
+        bool fast_plus          = false;
+        bool crc_enable         = false;
+        uint32_t timings        = 0;
+        uint32_t digital_filter = 0;
     };
 
 public:
@@ -234,14 +257,66 @@ public:
                                    const RX_callback& a_callback,
                                    uint32_t a_data_size_in_bytes);
 
+    Result write_read_polling(uint16_t a_slave_address,
+                              const void* a_p_tx_data,
+                              uint32_t a_tx_data_size_in_bytes,
+                              void* a_p_rx_data,
+                              uint32_t a_rx_data_size_in_bytes);
+
+    // on timeout a STOP is generated, the peripheral is reset when the STOP cannot complete (SCL held low)
+    Result write_read_polling(uint16_t a_slave_address,
+                              const void* a_p_tx_data,
+                              uint32_t a_tx_data_size_in_bytes,
+                              void* a_p_rx_data,
+                              uint32_t a_rx_data_size_in_bytes,
+                              cml::time::tick a_timeout);
+
+    void write_read_it(uint16_t a_slave_address,
+                       const void* a_p_tx_data,
+                       uint32_t a_tx_data_size_in_bytes,
+                       void* a_p_rx_data,
+                       uint32_t a_rx_data_size_in_bytes,
+                       const Transfer_callback& a_callback);
+
     void register_bus_status_callback(const Bus_status_callback& a_callback);
     void unregister_bus_status_callback();
 
     bool is_slave_connected(uint16_t a_slave_address, cml::time::tick a_timeout) const;
 
- private:
+    // resets the peripheral and clocks a stuck bus free, a_p_scl/a_p_sda: pins configured for this I2C
+    bool recover_bus(pin::Af* a_p_scl, pin::Af* a_p_sda);
+
+    bool is_write_read_active() const
+    {
+        return nullptr != this->write_read.callback.complete;
+    }
+
+private:
+
+    struct Write_read
+    {
+        const uint8_t* p_tx_data = nullptr;
+        uint8_t* p_rx_data       = nullptr;
+
+        uint32_t tx_data_size_in_bytes = 0;
+        uint32_t rx_data_size_in_bytes = 0;
+        uint32_t tx_words              = 0;
+        uint32_t rx_words              = 0;
+
+        uint32_t address_mask      = 0;
+        Bus_status_flag bus_status = Bus_status_flag::ok;
+
+        Transfer_callback callback;
+    };
+
+    void write_read_interrupt_handler(uint32_t a_isr);
+    void write_read_end();
+
+private:
+
+    Write_read write_read;
 
-     friend void i2c_master_interrupt_handler(I2C_master* a_p_this);
+    friend void i2c_master_interrupt_handler(I2C_master* a_p_this);
 };
 
 class I2C_slave : public I2C_base
@@ -257,13 +332,22 @@ public:
     using RX_callback         = I2C_base::RX_callback;
     using Bus_status_callback = I2C_base::Bus_status_callback;
 
+    /*
+        crc_enable: SMBus PEC, checked and appended by the polling transfers of up to 254 bytes
+                    (slave byte control is set for them), in transmit and receive callbacks it is a data byte
+    */
     struct Config
     {
-        bool analog_filter  = false;
-        bool fast_plus      = false;
-        bool crc_enable     = false;
-        uint32_t timings    = 0;
-        uint16_t address    = 0;
+        bool analog_filter      = false;
+        bool fast_plus          = false;
+        bool crc_enable         = false;
+        uint32_t timings        = 0;
+        uint16_t address        = 0;
+        uint32_t digital_filter = 0;
+
+        bool address_2_enable   = false;
+        uint16_t address_2      = 0;
+        uint32_t address_2_mask = 0; // number of ignored LSBs of address_2, 0 - 7
     };
 
 public:
@@ -0,0 +1,212 @@
+/*
+    Name: LPTIM.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef STM32L011xx
+
+//this
+#include <soc/stm32l011xx/peripherals/LPTIM.hpp>
+
+//soc
+#include <soc/stm32l011xx/mcu.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/utils/delay.hpp>
+
+namespace
+{
+
+using namespace cml;
+using namespace soc::stm32l011xx::peripherals;
+
+LPTIM* p_lptim_1 = nullptr;
+
+// ENABLE has to stay cleared for 2 LPTIM clock cycles (LSI can be as slow as 26 kHz)
+constexpr time::tick low_speed_clock_disable_time_us = 80;
+constexpr time::tick hsi16_disable_time_us           = 2;
+
+void write_synchronized(volatile uint32_t* a_p_register, uint32_t a_value, uint32_t a_ok_flag)
+{
+    *a_p_register = a_value;
+
+    while (false == is_flag(LPTIM1->ISR, a_ok_flag));
+
+    LPTIM1->ICR = a_ok_flag;
+}
+
+} // namespace ::
+
+extern "C"
+{
+
+void LPTIM1_IRQHandler()
+{
+    assert(nullptr != p_lptim_1);
+    lptim_interrupt_handler(p_lptim_1);
+}
+
+} // extern "C"
+
+namespace soc {
+namespace stm32l011xx {
+namespace peripherals {
+
+using namespace cml;
+
+void lptim_interrupt_handler(LPTIM* a_p_this)
+{
+    if (true == is_flag(LPTIM1->ISR, LPTIM_ISR_ARRM))
+    {
+        LPTIM1->ICR = LPTIM_ICR_ARRMCF;
+
+        if (nullptr != a_p_this->update_callback.function)
+        {
+            a_p_this->update_callback.function(a_p_this->update_callback.p_user_data);
+        }
+    }
+}
+
+void LPTIM::enable(const Config& a_config, uint32_t a_irq_priority)
+{
+    assert(nullptr == p_lptim_1);
+    assert(a_config.auto_reload > 0);
+
+    p_lptim_1 = this;
+
+    set_flag(&(RCC->CCIPR), RCC_CCIPR_LPTIM1SEL, static_cast<uint32_t>(a_config.clock_source));
+    set_flag(&(RCC->APB1ENR), RCC_APB1ENR_LPTIM1EN);
+
+    // CFGR and IER are writable only with the timer disabled, ARR and CMP only with the timer enabled
+    LPTIM1->CR   = 0;
+    LPTIM1->CFGR = static_cast<uint32_t>(a_config.prescaler) |
+                   static_cast<uint32_t>(a_config.polarity) |
+                   LPTIM_CFGR_PRELOAD;
+    LPTIM1->IER  = LPTIM_IER_ARRMIE;
+    LPTIM1->CR   = LPTIM_CR_ENABLE;
+
+    write_synchronized(&(LPTIM1->ARR), a_config.auto_reload, LPTIM_ISR_ARROK);
+    write_synchronized(&(LPTIM1->CMP), a_config.auto_reload - 1u, LPTIM_ISR_CMPOK);
+
+    NVIC_SetPriority(LPTIM1_IRQn, a_irq_priority);
+    NVIC_EnableIRQ(LPTIM1_IRQn);
+}
+
+void LPTIM::disable()
+{
+    if (this == p_lptim_1)
+    {
+        NVIC_DisableIRQ(LPTIM1_IRQn);
+
+        LPTIM1->CR  = 0;
+        LPTIM1->IER = 0;
+
+        clear_flag(&(RCC->APB1ENR), RCC_APB1ENR_LPTIM1EN);
+
+        this->update_callback = { nullptr, nullptr };
+
+        p_lptim_1 = nullptr;
+    }
+}
+
+void LPTIM::start()
+{
+    assert(this == p_lptim_1);
+
+    set_flag(&(LPTIM1->CR), LPTIM_CR_CNTSTRT);
+}
+
+void LPTIM::start_single()
+{
+    assert(this == p_lptim_1);
+
+    set_flag(&(LPTIM1->CR), LPTIM_CR_SNGSTRT);
+}
+
+void LPTIM::stop()
+{
+    assert(this == p_lptim_1);
+
+    // the counter is stopped and reset only by disabling the timer, ARR and CMP are kept
+    LPTIM1->CR = 0;
+
+    switch (static_cast<Clock_source>(get_flag(RCC->CCIPR, RCC_CCIPR_LPTIM1SEL)))
+    {
+        case Clock_source::lsi:
+        case Clock_source::lse:
+        {
+            utils::delay::us(low_speed_clock_disable_time_us);
+        }
+        break;
+
+        case Clock_source::hsi16:
+        {
+            utils::delay::us(hsi16_disable_time_us);
+        }
+        break;
+
+        case Clock_source::pclk:
+        {
+        }
+        break;
+    }
+
+    LPTIM1->CR = LPTIM_CR_ENABLE;
+}
+
+void LPTIM::set_compare(uint16_t a_compare)
+{
+    assert(this == p_lptim_1);
+    assert(a_compare < LPTIM1->ARR);
+
+    write_synchronized(&(LPTIM1->CMP), a_compare, LPTIM_ISR_CMPOK);
+}
+
+void LPTIM::set_auto_reload(uint16_t a_auto_reload)
+{
+    assert(this == p_lptim_1);
+    assert(a_auto_reload > 0);
+
+    write_synchronized(&(LPTIM1->ARR), a_auto_reload, LPTIM_ISR_ARROK);
+}
+
+void LPTIM::register_update_callback(const Update_callback& a_callback)
+{
+    assert(this == p_lptim_1);
+    assert(nullptr != a_callback.function);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    this->update_callback = a_callback;
+}
+
+void LPTIM::unregister_update_callback()
+{
+    assert(this == p_lptim_1);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    this->update_callback = { nullptr, nullptr };
+}
+
+uint16_t LPTIM::get_counter() const
+{
+    // asynchronous to the bus clock, valid when two consecutive reads are equal
+    uint32_t ret = LPTIM1->CNT;
+
+    for (uint32_t next = LPTIM1->CNT; next != ret; next = LPTIM1->CNT)
+    {
+        ret = next;
+    }
+
+    return static_cast<uint16_t>(ret);
+}
+
+} // namespace peripherals
+} // namespace stm32l011xx
+} // namespace soc
+
+#endif // STM32L011xx
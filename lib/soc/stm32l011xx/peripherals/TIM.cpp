@@ -0,0 +1,350 @@
+/*
+    Name: TIM.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef STM32L011xx
+
+//this
+#include <soc/stm32l011xx/peripherals/TIM.hpp>
+
+//soc
+#include <soc/stm32l011xx/mcu.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace
+{
+
+using namespace cml;
+using namespace soc::stm32l011xx::peripherals;
+
+void tim_2_enable()
+{
+    set_flag(&(RCC->APB1ENR), RCC_APB1ENR_TIM2EN);
+}
+
+void tim_2_disable()
+{
+    clear_flag(&(RCC->APB1ENR), RCC_APB1ENR_TIM2EN);
+}
+
+void tim_21_enable()
+{
+    set_flag(&(RCC->APB2ENR), RCC_APB2ENR_TIM21EN);
+}
+
+void tim_21_disable()
+{
+    clear_flag(&(RCC->APB2ENR), RCC_APB2ENR_TIM21EN);
+}
+
+struct Controller
+{
+    TIM_TypeDef* p_registers = nullptr;
+    IRQn_Type irqn           = static_cast<IRQn_Type>(0);
+
+    void(*p_enable)()  = nullptr;
+    void(*p_disable)() = nullptr;
+};
+
+const Controller controllers[] =
+{
+    { TIM2,  TIM2_IRQn,  tim_2_enable,  tim_2_disable  },
+    { TIM21, TIM21_IRQn, tim_21_enable, tim_21_disable }
+};
+
+TIM* timers[2] = { nullptr, nullptr };
+
+TIM_TypeDef* get_registers(TIM::Id a_id)
+{
+    return controllers[static_cast<uint32_t>(a_id)].p_registers;
+}
+
+volatile uint32_t* get_capture_register(TIM_TypeDef* a_p_registers, TIM::Channel a_channel)
+{
+    return &(a_p_registers->CCR1) + static_cast<uint32_t>(a_channel);
+}
+
+void set_channel_mode(TIM_TypeDef* a_p_registers, TIM::Channel a_channel, uint32_t a_ccmr, uint32_t a_ccer)
+{
+    const uint32_t index      = static_cast<uint32_t>(a_channel);
+    const uint32_t ccmr_shift = (index % 2u) * 8u;
+    const uint32_t ccer_shift = index * 4u;
+    volatile uint32_t* p_ccmr = 0 == index / 2u ? &(a_p_registers->CCMR1) : &(a_p_registers->CCMR2);
+
+    clear_flag(&(a_p_registers->CCER), TIM_CCER_CC1E << ccer_shift);
+
+    set_flag(p_ccmr, 0xFFu << ccmr_shift, a_ccmr << ccmr_shift);
+
+    set_flag(&(a_p_registers->CCER),
+             (TIM_CCER_CC1P | TIM_CCER_CC1NP) << ccer_shift,
+             (a_ccer | TIM_CCER_CC1E) << ccer_shift);
+}
+
+} // namespace ::
+
+extern "C"
+{
+
+void TIM2_IRQHandler()
+{
+    assert(nullptr != timers[0]);
+    tim_interrupt_handler(timers[0]);
+}
+
+void TIM21_IRQHandler()
+{
+    assert(nullptr != timers[1]);
+    tim_interrupt_handler(timers[1]);
+}
+
+} // extern "C"
+
+namespace soc {
+namespace stm32l011xx {
+namespace peripherals {
+
+using namespace cml;
+
+void tim_interrupt_handler(TIM* a_p_this)
+{
+    TIM_TypeDef* p_registers = get_registers(a_p_this->id);
+
+    const uint32_t sr   = p_registers->SR;
+    const uint32_t dier = p_registers->DIER;
+
+    if (true == is_flag(sr, TIM_SR_UIF) && true == is_flag(dier, TIM_DIER_UIE))
+    {
+        p_registers->SR = ~static_cast<uint32_t>(TIM_SR_UIF);
+        a_p_this->update_callback.function(a_p_this->update_callback.p_user_data);
+    }
+
+    for (uint32_t i = 0; i < a_p_this->get_channels_count(); i++)
+    {
+        const uint32_t capture_flag     = TIM_SR_CC1IF << i;
+        const uint32_t overcapture_flag = TIM_SR_CC1OF << i;
+
+        if (true == is_flag(sr, capture_flag) && true == is_flag(dier, TIM_DIER_CC1IE << i))
+        {
+            const TIM::Channel channel = static_cast<TIM::Channel>(i);
+            const uint32_t value       = *(get_capture_register(p_registers, channel));
+
+            if (true == is_flag(sr, overcapture_flag))
+            {
+                p_registers->SR        = ~overcapture_flag;
+                a_p_this->overcaptures = a_p_this->overcaptures + 1;
+            }
+
+            a_p_this->capture_callbacks[i].function(channel,
+                                                    value,
+                                                    a_p_this->capture_edges[i],
+                                                    a_p_this->capture_callbacks[i].p_user_data);
+        }
+    }
+}
+
+void TIM::enable(const Config& a_config, uint32_t a_irq_priority)
+{
+    assert(nullptr == timers[static_cast<uint32_t>(this->id)]);
+    assert(a_config.auto_reload > 0 && a_config.auto_reload <= this->get_counter_max());
+
+    timers[static_cast<uint32_t>(this->id)] = this;
+
+    const Controller& controller = controllers[static_cast<uint32_t>(this->id)];
+    TIM_TypeDef* p_registers     = controller.p_registers;
+
+    controller.p_enable();
+
+    p_registers->CR1   = TIM_CR1_ARPE | TIM_CR1_URS | (true == a_config.one_pulse ? TIM_CR1_OPM : 0x0u);
+    p_registers->DIER  = 0;
+    p_registers->CCER  = 0;
+    p_registers->CCMR1 = 0;
+    p_registers->PSC   = a_config.prescaler;
+    p_registers->ARR   = a_config.auto_reload;
+
+    if (Id::_2 == this->id)
+    {
+        p_registers->CCMR2 = 0;
+    }
+
+    set_flag(&(p_registers->EGR), TIM_EGR_UG);
+    p_registers->SR = 0;
+
+    this->overcaptures = 0;
+
+    NVIC_SetPriority(controller.irqn, a_irq_priority);
+    NVIC_EnableIRQ(controller.irqn);
+}
+
+void TIM::disable()
+{
+    if (this == timers[static_cast<uint32_t>(this->id)])
+    {
+        const Controller& controller = controllers[static_cast<uint32_t>(this->id)];
+
+        controller.p_registers->CR1  = 0;
+        controller.p_registers->DIER = 0;
+        controller.p_registers->CCER = 0;
+
+        NVIC_DisableIRQ(controller.irqn);
+        controller.p_disable();
+
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            this->capture_callbacks[i] = { nullptr, nullptr };
+        }
+
+        this->update_callback = { nullptr, nullptr };
+
+        timers[static_cast<uint32_t>(this->id)] = nullptr;
+    }
+}
+
+void TIM::start()
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+
+    TIM_TypeDef* p_registers = get_registers(this->id);
+
+    p_registers->CNT = 0;
+    set_flag(&(p_registers->CR1), TIM_CR1_CEN);
+}
+
+void TIM::stop()
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+
+    clear_flag(&(get_registers(this->id)->CR1), TIM_CR1_CEN);
+}
+
+void TIM::enable_capture(Channel a_channel, const Capture& a_capture, const Capture_callback& a_callback)
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+    assert(static_cast<uint32_t>(a_channel) < this->get_channels_count());
+    assert(a_capture.filter <= 0xFu);
+    assert(nullptr != a_callback.function);
+
+    TIM_TypeDef* p_registers = get_registers(this->id);
+    const uint32_t index     = static_cast<uint32_t>(a_channel);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    this->capture_callbacks[index] = a_callback;
+    this->capture_edges[index]     = a_capture.edge;
+
+    set_channel_mode(p_registers,
+                     a_channel,
+                     static_cast<uint32_t>(a_capture.input) |
+                     static_cast<uint32_t>(a_capture.prescaler) |
+                     (a_capture.filter << TIM_CCMR1_IC1F_Pos),
+                     static_cast<uint32_t>(a_capture.edge));
+
+    p_registers->SR = ~((TIM_SR_CC1IF | TIM_SR_CC1OF) << index);
+    set_flag(&(p_registers->DIER), TIM_DIER_CC1IE << index);
+}
+
+void TIM::disable_capture(Channel a_channel)
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+    assert(static_cast<uint32_t>(a_channel) < this->get_channels_count());
+
+    TIM_TypeDef* p_registers = get_registers(this->id);
+    const uint32_t index     = static_cast<uint32_t>(a_channel);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    clear_flag(&(p_registers->DIER), TIM_DIER_CC1IE << index);
+    clear_flag(&(p_registers->CCER), TIM_CCER_CC1E << (index * 4u));
+
+    this->capture_callbacks[index] = { nullptr, nullptr };
+}
+
+void TIM::enable_pwm(Channel a_channel, const Pwm& a_pwm)
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+    assert(static_cast<uint32_t>(a_channel) < this->get_channels_count());
+    assert(a_pwm.compare <= this->get_counter_max());
+
+    TIM_TypeDef* p_registers = get_registers(this->id);
+
+    *(get_capture_register(p_registers, a_channel)) = a_pwm.compare;
+
+    set_channel_mode(p_registers,
+                     a_channel,
+                     static_cast<uint32_t>(a_pwm.mode) | TIM_CCMR1_OC1PE,
+                     static_cast<uint32_t>(a_pwm.polarity));
+
+    if (false == this->is_started())
+    {
+        set_flag(&(p_registers->EGR), TIM_EGR_UG);
+    }
+}
+
+void TIM::disable_pwm(Channel a_channel)
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+    assert(static_cast<uint32_t>(a_channel) < this->get_channels_count());
+
+    clear_flag(&(get_registers(this->id)->CCER), TIM_CCER_CC1E << (static_cast<uint32_t>(a_channel) * 4u));
+}
+
+void TIM::set_compare(Channel a_channel, uint32_t a_compare)
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+    assert(static_cast<uint32_t>(a_channel) < this->get_channels_count());
+    assert(a_compare <= this->get_counter_max());
+
+    *(get_capture_register(get_registers(this->id), a_channel)) = a_compare;
+}
+
+uint32_t TIM::get_compare(Channel a_channel) const
+{
+    assert(static_cast<uint32_t>(a_channel) < this->get_channels_count());
+
+    return *(get_capture_register(get_registers(this->id), a_channel));
+}
+
+void TIM::register_update_callback(const Update_callback& a_callback)
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+    assert(nullptr != a_callback.function);
+
+    TIM_TypeDef* p_registers = get_registers(this->id);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    this->update_callback = a_callback;
+
+    p_registers->SR = ~static_cast<uint32_t>(TIM_SR_UIF);
+    set_flag(&(p_registers->DIER), TIM_DIER_UIE);
+}
+
+void TIM::unregister_update_callback()
+{
+    assert(this == timers[static_cast<uint32_t>(this->id)]);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    clear_flag(&(get_registers(this->id)->DIER), TIM_DIER_UIE);
+    this->update_callback = { nullptr, nullptr };
+}
+
+bool TIM::is_started() const
+{
+    return is_flag(get_registers(this->id)->CR1, TIM_CR1_CEN);
+}
+
+uint32_t TIM::get_counter() const
+{
+    return get_registers(this->id)->CNT;
+}
+
+} // namespace peripherals
+} // namespace stm32l011xx
+} // namespace soc
+
+#endif // STM32L011xx
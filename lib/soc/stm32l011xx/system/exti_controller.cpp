@@ -11,6 +11,8 @@
 #include <soc/stm32l011xx/system/exti_controller.hpp>
 
 //soc
+#include <soc/counter.hpp>
+#include <soc/exti_lines.hpp>
 #ifdef CML_ASSERT
 #include <soc/stm32l011xx/mcu.hpp>
 #endif
@@ -27,9 +29,50 @@ struct Handler
 {
     exti_controller::Callback callback;
     pin::In const* p_pin = nullptr;
+    bool deferred        = false;
 };
 
 Handler handlers[16];
+soc::exti_lines::Event_queue<exti_controller::Event, 32u> deferred_queue;
+
+// lines with a registered handler
+volatile uint32_t lines = 0;
+
+void set_line(const pin::In* a_p_pin, exti_controller::Interrupt_mode a_mode)
+{
+    using namespace cml;
+
+    set_flag(&(SYSCFG->EXTICR[a_p_pin->get_id() / 4u]),
+            (static_cast<uint32_t>(a_p_pin->get_port()->get_id()) << ((static_cast<uint32_t>(a_p_pin->get_id()) % 4u) * 4u)));
+
+    clear_bit(&(EXTI->RTSR), a_p_pin->get_id());
+    clear_bit(&(EXTI->FTSR), a_p_pin->get_id());
+    set_bit(&(EXTI->IMR), a_p_pin->get_id());
+
+    switch (a_mode)
+    {
+        case exti_controller::Interrupt_mode::rising:
+        {
+            set_bit(&(EXTI->RTSR), a_p_pin->get_id());
+        }
+        break;
+
+        case exti_controller::Interrupt_mode::falling:
+        {
+            set_bit(&(EXTI->FTSR), a_p_pin->get_id());
+        }
+        break;
+
+        default:
+        {
+            if ((exti_controller::Interrupt_mode::rising | exti_controller::Interrupt_mode::falling) == a_mode)
+            {
+                set_bit(&(EXTI->RTSR), a_p_pin->get_id());
+                set_bit(&(EXTI->FTSR), a_p_pin->get_id());
+            }
+        }
+    }
+}
 
 } // namespace ::
 
@@ -38,51 +81,41 @@ extern "C"
 
 using namespace cml;
 
-static bool interrupt_handler(uint32_t a_pr1, uint32_t a_index)
+// pending register read once, only the set bits of owned lines are visited (highest first)
+static void interrupt_handler(uint32_t a_lines)
 {
-    assert(nullptr != handlers[a_index].callback.function);
+    const uint32_t clear = soc::exti_lines::dispatch(EXTI->PR & lines & a_lines, [](uint32_t a_line) {
+        const Handler& handler = handlers[a_line];
+        const pin::Level level = handler.p_pin->get_level();
 
-    if (true == is_bit(a_pr1, a_index))
-    {
-        return handlers[a_index].callback.function(handlers[a_index].p_pin->get_level(),
-                                                   handlers[a_index].callback.p_user_data);
+        if (true == handler.deferred)
+        {
+            deferred_queue.push({ static_cast<uint8_t>(a_line), level, soc::counter::get() });
+            return true;
+        }
 
-    }
+        return handler.callback.function(level, handler.callback.p_user_data);
+    });
 
-    return false;
+    if (0 != clear)
+    {
+        EXTI->PR = clear;
+    }
 }
 
 void EXTI0_1_IRQHandler()
 {
-    for (uint32_t i = 0u; i <= 1u; i++)
-    {
-        if (true == interrupt_handler(EXTI->PR, i))
-        {
-            set_bit(&(EXTI->PR), i);
-        }
-    }
+    interrupt_handler(0x3u);
 }
 
 void EXTI2_3_IRQHandler()
 {
-    for (uint32_t i = 2u; i <= 3u; i++)
-    {
-        if (true == interrupt_handler(EXTI->PR, i))
-        {
-            set_bit(&(EXTI->PR), i);
-        }
-    }
+    interrupt_handler(0xCu);
 }
 
 void EXTI4_15_IRQHandler()
 {
-    for (uint32_t i = 4u; i <= 15u; i++)
-    {
-        if (true == interrupt_handler(EXTI->PR, i))
-        {
-            set_bit(&(EXTI->PR), i);
-        }
-    }
+    interrupt_handler(0xFFF0u);
 }
 
 } // extern "C"
@@ -116,52 +149,53 @@ void exti_controller::register_callback(pin::In* a_p_pin,
                                         const Callback& a_callback)
 {
     assert(nullptr != a_p_pin);
+    assert(nullptr != a_callback.function);
     assert(true == mcu::is_syscfg_enabled());
-    assert(nullptr == handlers[static_cast<uint32_t>(a_p_pin->get_id())].callback.function);
+    assert(nullptr == handlers[static_cast<uint32_t>(a_p_pin->get_id())].p_pin);
 
-    set_flag(&(SYSCFG->EXTICR[a_p_pin->get_id() / 4u]),
-            (static_cast<uint32_t>(a_p_pin->get_port()->get_id()) << ((static_cast<uint32_t>(a_p_pin->get_id()) % 4u) * 4u)));
+    handlers[a_p_pin->get_id()] = { a_callback, a_p_pin, false };
+    lines                       = lines | (0x1u << a_p_pin->get_id());
 
-    clear_bit(&(EXTI->RTSR), a_p_pin->get_id());
-    clear_bit(&(EXTI->FTSR), a_p_pin->get_id());
-    set_bit(&(EXTI->IMR), a_p_pin->get_id());
+    set_line(a_p_pin, a_mode);
+}
 
-    switch (a_mode)
-    {
-        case Interrupt_mode::rising:
-        {
-            set_bit(&(EXTI->RTSR), a_p_pin->get_id());
-        }
-        break;
+void exti_controller::register_deferred(pin::In* a_p_pin, Interrupt_mode a_mode)
+{
+    assert(nullptr != a_p_pin);
+    assert(true == mcu::is_syscfg_enabled());
+    assert(nullptr == handlers[static_cast<uint32_t>(a_p_pin->get_id())].p_pin);
 
-        case Interrupt_mode::falling:
-        {
-            set_bit(&(EXTI->FTSR), a_p_pin->get_id());
-        }
-        break;
+    handlers[a_p_pin->get_id()] = { { nullptr, nullptr }, a_p_pin, true };
+    lines                       = lines | (0x1u << a_p_pin->get_id());
 
-        default:
-        {
-            if ((Interrupt_mode::rising | Interrupt_mode::falling) == a_mode)
-            {
-                set_bit(&(EXTI->RTSR), a_p_pin->get_id());
-                set_bit(&(EXTI->FTSR), a_p_pin->get_id());
-            }
-        }
-    }
+    set_line(a_p_pin, a_mode);
+}
+
+bool exti_controller::read_event(Event* a_p_event)
+{
+    assert(nullptr != a_p_event);
 
-    handlers[a_p_pin->get_id()] = { a_callback, a_p_pin };
+    return deferred_queue.read(a_p_event);
+}
+
+uint32_t exti_controller::get_dropped_events_count()
+{
+    return deferred_queue.get_dropped_count();
 }
 
 void exti_controller::unregister_callback(const pin::In& a_pin)
 {
+    clear_bit(&(EXTI->IMR), a_pin.get_id());
     clear_bit(&(EXTI->RTSR), a_pin.get_id());
     clear_bit(&(EXTI->FTSR), a_pin.get_id());
 
+    EXTI->PR = 0x1u << a_pin.get_id();
+
     clear_flag(&(SYSCFG->EXTICR[a_pin.get_id() / 4u]),
                (static_cast<uint32_t>(a_pin.get_port()->get_id()) << ((static_cast<uint32_t>(a_pin.get_id()) % 4u) * 4u)));
 
-    handlers[a_pin.get_id()] = { { nullptr, nullptr }, nullptr };
+    lines                    = lines & ~(0x1u << a_pin.get_id());
+    handlers[a_pin.get_id()] = { { nullptr, nullptr }, nullptr, false };
 }
 
 } // namespace system
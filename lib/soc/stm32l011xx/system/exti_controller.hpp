@@ -13,6 +13,9 @@
 //soc
 #include <soc/stm32l011xx/peripherals/GPIO.hpp>
 
+//cml
+#include <cml/time.hpp>
+
 namespace soc {
 namespace stm32l011xx {
 namespace system {
@@ -35,6 +38,13 @@ public:
         void* p_user_data = nullptr;
     };
 
+    struct Event
+    {
+        uint8_t line                  = 0xFF;
+        peripherals::pin::Level level = peripherals::pin::Level::low;
+        cml::time::tick timestamp     = 0;
+    };
+
 public:
 
     exti_controller()                       = delete;
@@ -51,6 +61,13 @@ public:
                                   Interrupt_mode a_mode,
                                   const Callback& a_callback);
 
+    // events of the line are queued (level and counter tick at the interrupt) instead of calling user code
+    static void register_deferred(peripherals::pin::In* a_p_pin, Interrupt_mode a_mode);
+
+    // main loop side of the deferred events queue
+    static bool read_event(Event* a_p_event);
+    static uint32_t get_dropped_events_count();
+
     static void unregister_callback(const peripherals::pin::In& a_pin);
 };
 
@@ -42,6 +42,17 @@ bool is_channel(ADC::Channel::Id a_type, const ADC::Channel* a_p_channels, uint3
     return found;
 }
 
+void set_sampling_time(ADC::Channel::Id a_id, ADC::Channel::Sampling_time a_sampling_time)
+{
+    volatile uint32_t* p_SMPRs = reinterpret_cast<volatile uint32_t*>(&(ADC1->SMPR1));
+
+    const uint32_t channel_id     = static_cast<uint32_t>(a_id);
+    const uint32_t register_index = channel_id / 10;
+    const uint32_t shift          = (channel_id - (register_index * 10)) * 3;
+
+    set_flag(&(p_SMPRs[register_index]), 0x7u << shift, static_cast<uint32_t>(a_sampling_time) << shift);
+}
+
 } // namespace ::
 
 extern "C"
@@ -53,6 +64,13 @@ void ADC1_IRQHandler()
     adc_interrupt_handler(p_adc_1);
 }
 
+// DMA1 channel 1 can be shared with other peripherals, user code can override this handler
+__attribute__((weak)) void DMA1_Channel1_IRQHandler()
+{
+    assert(nullptr != p_adc_1);
+    adc_dma_interrupt_handler(p_adc_1);
+}
+
 } // extern "C"
 
 namespace soc {
@@ -65,8 +83,46 @@ using namespace cml::utils;
 void adc_interrupt_handler(ADC* a_p_this)
 {
     const uint32_t isr = ADC1->ISR;
+    const uint32_t ier = ADC1->IER;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        const uint32_t flag = ADC_ISR_AWD1 << i;
+
+        if (true == is_flag(isr, flag) && true == is_flag(ier, ADC_IER_AWD1IE << i))
+        {
+            ADC1->ISR = flag;
 
-    if (true == is_flag(isr, ADC_ISR_EOC))
+            const ADC::Analog_watchdog::Callback& callback = a_p_this->analog_watchdog_callbacks[i];
+
+            if (false == callback.function(static_cast<ADC::Analog_watchdog::Id>(i), callback.p_user_data))
+            {
+                clear_flag(&(ADC1->IER), ADC_IER_AWD1IE << i);
+            }
+        }
+    }
+
+    if (true == is_flag(isr, ADC_ISR_JEOS) && true == is_flag(ier, ADC_IER_JEOSIE))
+    {
+        const volatile uint32_t* p_JDRs = &(ADC1->JDR1);
+        const uint32_t count            = a_p_this->get_injected_channels_count();
+
+        uint16_t data[4];
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            data[i] = static_cast<uint16_t>(p_JDRs[i]);
+        }
+
+        ADC1->ISR = ADC_ISR_JEOC | ADC_ISR_JEOS;
+
+        if (false == a_p_this->injected_callback.function(data, count, a_p_this->injected_callback.p_user_data))
+        {
+            a_p_this->stop_injected_it();
+        }
+    }
+
+    if (true == is_flag(isr, ADC_ISR_EOC) && true == is_flag(ier, ADC_IER_EOCIE))
     {
         const bool series_end = is_flag(isr, ADC_ISR_EOS);
         const bool ret = a_p_this->callaback.function(ADC1->DR, series_end, a_p_this->callaback.p_user_data);
@@ -84,6 +140,21 @@ void adc_interrupt_handler(ADC* a_p_this)
     }
 }
 
+void adc_dma_interrupt_handler(ADC* a_p_this)
+{
+    const uint32_t isr = DMA1->ISR;
+
+    set_flag(&(DMA1->IFCR), DMA_IFCR_CGIF1);
+
+    if (false == ADC::dispatch_read_dma(isr,
+                                        a_p_this->dma_read.p_buffer,
+                                        a_p_this->dma_read.buffer_capacity,
+                                        a_p_this->dma_read.callback))
+    {
+        a_p_this->stop_read_dma();
+    }
+}
+
 bool ADC::enable(Resolution a_resolution,
                  const Asynchronous_clock& a_clock,
                  uint32_t a_irq_priority,
@@ -123,6 +194,13 @@ bool ADC::enable(Resolution a_resolution,
 
 void ADC::disable()
 {
+    if (true == this->is_read_dma_active())
+    {
+        clear_flag(&(DMA1_Channel1->CCR), DMA_CCR_EN);
+        this->dma_read = DMA_read();
+    }
+
+    ADC1->IER        = 0;
     ADC1->CR         = 0;
     ADC1_COMMON->CCR = 0;
 
@@ -130,6 +208,7 @@ void ADC::disable()
     clear_flag(&(RCC->AHB2ENR), RCC_AHB2ENR_ADCEN);
 
     NVIC_DisableIRQ(ADC1_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel1_IRQn);
 
     p_adc_1 = nullptr;
 }
@@ -300,6 +379,350 @@ void ADC::stop_read_it()
     this->callaback = { nullptr, nullptr };
 }
 
+void ADC::start_read_dma(uint16_t* a_p_buffer, uint32_t a_buffer_capacity, const DMA_callback& a_callback)
+{
+    assert(nullptr != p_adc_1);
+    assert(nullptr != a_p_buffer);
+    assert(nullptr != a_callback.function);
+    assert(a_buffer_capacity > 0 && a_buffer_capacity <= 0xFFFFu);
+    assert(0 == a_buffer_capacity % (this->get_active_channels_count() * 2));
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    this->dma_read.p_buffer        = a_p_buffer;
+    this->dma_read.buffer_capacity = a_buffer_capacity;
+    this->dma_read.callback        = a_callback;
+
+    set_flag(&(RCC->AHB1ENR), RCC_AHB1ENR_DMA1EN);
+    clear_flag(&(DMA1_CSELR->CSELR), DMA_CSELR_C1S);
+    set_flag(&(DMA1->IFCR), DMA_IFCR_CGIF1);
+
+    DMA1_Channel1->CPAR  = reinterpret_cast<uint32_t>(&(ADC1->DR));
+    DMA1_Channel1->CMAR  = reinterpret_cast<uint32_t>(a_p_buffer);
+    DMA1_Channel1->CNDTR = a_buffer_capacity;
+    DMA1_Channel1->CCR   = DMA_CCR_PL_1 |
+                           DMA_CCR_MSIZE_0 |
+                           DMA_CCR_PSIZE_0 |
+                           DMA_CCR_MINC |
+                           DMA_CCR_CIRC |
+                           DMA_CCR_TEIE |
+                           DMA_CCR_HTIE |
+                           DMA_CCR_TCIE |
+                           DMA_CCR_EN;
+
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    set_flag(&(ADC1->ISR), ADC_ISR_OVR | ADC_ISR_EOC | ADC_ISR_EOS);
+    set_flag(&(ADC1->CFGR), (false == this->is_trigger_set() ? ADC_CFGR_CONT : 0x0u) | ADC_CFGR_DMACFG | ADC_CFGR_DMAEN);
+    set_flag(&(ADC1->CR), ADC_CR_ADSTART);
+}
+
+void ADC::stop_read_dma()
+{
+    assert(nullptr != p_adc_1);
+
+    if (true == is_flag(ADC1->CR, ADC_CR_ADSTART))
+    {
+        set_flag(&(ADC1->CR), ADC_CR_ADSTP);
+        wait::until(&(ADC1->CR), ADC_CR_ADSTP, true);
+    }
+
+    clear_flag(&(ADC1->CFGR), ADC_CFGR_CONT | ADC_CFGR_DMACFG | ADC_CFGR_DMAEN);
+    clear_flag(&(DMA1_Channel1->CCR), DMA_CCR_EN);
+    set_flag(&(DMA1->IFCR), DMA_IFCR_CGIF1);
+
+    NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+    NVIC_ClearPendingIRQ(DMA1_Channel1_IRQn);
+
+    this->dma_read = DMA_read();
+}
+
+void ADC::set_trigger(const Trigger& a_trigger)
+{
+    assert(nullptr != p_adc_1);
+    assert(Trigger::Source::unknown != a_trigger.source);
+    assert(Trigger::Edge::unknown != a_trigger.edge);
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    set_flag(&(ADC1->CFGR), ADC_CFGR_EXTSEL | ADC_CFGR_EXTEN, get_CFGR_trigger(a_trigger));
+}
+
+void ADC::clear_trigger()
+{
+    assert(nullptr != p_adc_1);
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    clear_flag(&(ADC1->CFGR), ADC_CFGR_EXTSEL | ADC_CFGR_EXTEN);
+}
+
+void ADC::set_injected_channels(const Channel* a_p_channels, uint32_t a_channels_count)
+{
+    assert(nullptr != p_adc_1);
+    assert(nullptr != a_p_channels);
+    assert(a_channels_count > 0 && a_channels_count <= 4);
+    assert(false == is_flag(ADC1->CR, ADC_CR_JADSTART));
+
+    for (uint32_t i = 0; i < a_channels_count; i++)
+    {
+        assert(Channel::Id::unknown != a_p_channels[i].id);
+
+        set_sampling_time(a_p_channels[i].id, a_p_channels[i].sampling_time);
+    }
+
+    ADC1->JSQR = (ADC1->JSQR & (ADC_JSQR_JEXTSEL | ADC_JSQR_JEXTEN)) | get_JSQR_channels(a_p_channels, a_channels_count);
+
+    if (true == is_channel(Channel::Id::temperature_sensor, a_p_channels, a_channels_count) &&
+        false == is_flag(ADC1_COMMON->CCR, ADC_CCR_TSEN))
+    {
+        set_flag(&(ADC1_COMMON->CCR), ADC_CCR_TSEN);
+        delay::us(120);
+    }
+
+    if (true == is_channel(Channel::Id::voltage_reference, a_p_channels, a_channels_count))
+    {
+        set_flag(&(ADC1_COMMON->CCR), ADC_CCR_VREFEN);
+    }
+
+    if (true == is_channel(Channel::Id::battery_voltage, a_p_channels, a_channels_count))
+    {
+        set_flag(&(ADC1_COMMON->CCR), ADC_CCR_VBATEN);
+    }
+}
+
+void ADC::clear_injected_channels()
+{
+    assert(nullptr != p_adc_1);
+    assert(false == is_flag(ADC1->CR, ADC_CR_JADSTART));
+
+    clear_flag(&(ADC1->JSQR), ADC_JSQR_JL | ADC_JSQR_JSQ1 | ADC_JSQR_JSQ2 | ADC_JSQR_JSQ3 | ADC_JSQR_JSQ4);
+}
+
+void ADC::set_injected_trigger(const Injected_trigger& a_trigger)
+{
+    assert(nullptr != p_adc_1);
+    assert(Injected_trigger::Source::unknown != a_trigger.source);
+    assert(Trigger::Edge::unknown != a_trigger.edge);
+    assert(false == this->is_injected_auto());
+    assert(false == is_flag(ADC1->CR, ADC_CR_JADSTART));
+
+    set_flag(&(ADC1->JSQR), ADC_JSQR_JEXTSEL | ADC_JSQR_JEXTEN, get_JSQR_trigger(a_trigger));
+}
+
+void ADC::clear_injected_trigger()
+{
+    assert(nullptr != p_adc_1);
+    assert(false == is_flag(ADC1->CR, ADC_CR_JADSTART));
+
+    clear_flag(&(ADC1->JSQR), ADC_JSQR_JEXTSEL | ADC_JSQR_JEXTEN);
+}
+
+void ADC::set_injected_auto(bool a_enable)
+{
+    assert(nullptr != p_adc_1);
+    assert(false == a_enable || false == this->is_injected_trigger_set());
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART) && false == is_flag(ADC1->CR, ADC_CR_JADSTART));
+
+    if (true == a_enable)
+    {
+        set_flag(&(ADC1->CFGR), ADC_CFGR_JAUTO);
+    }
+    else
+    {
+        clear_flag(&(ADC1->CFGR), ADC_CFGR_JAUTO);
+    }
+}
+
+bool ADC::read_injected_polling(uint16_t* a_p_data, uint32_t a_count, time::tick a_timeout)
+{
+    assert(nullptr != p_adc_1);
+    assert(nullptr != a_p_data);
+    assert(a_timeout > 0);
+    assert(false == this->is_injected_auto());
+
+    assert(this->get_injected_channels_count() == a_count);
+
+    ADC1->ISR = ADC_ISR_JEOC | ADC_ISR_JEOS;
+    set_flag(&(ADC1->CR), ADC_CR_JADSTART);
+
+    bool ret = wait::until(&(ADC1->ISR), ADC_ISR_JEOS, false, counter::get(), a_timeout);
+
+    if (true == ret)
+    {
+        const volatile uint32_t* p_JDRs = &(ADC1->JDR1);
+
+        for (uint32_t i = 0; i < a_count; i++)
+        {
+            a_p_data[i] = static_cast<uint16_t>(p_JDRs[i]);
+        }
+
+        ADC1->ISR = ADC_ISR_JEOC | ADC_ISR_JEOS;
+    }
+    else
+    {
+        set_flag(&(ADC1->CR), ADC_CR_JADSTP);
+        wait::until(&(ADC1->CR), ADC_CR_JADSTP, true);
+    }
+
+    return ret;
+}
+
+void ADC::start_injected_it(const Injected_callback& a_callback)
+{
+    assert(nullptr != p_adc_1);
+    assert(nullptr != a_callback.function);
+
+    this->injected_callback = a_callback;
+
+    ADC1->ISR = ADC_ISR_JEOC | ADC_ISR_JEOS;
+    set_flag(&(ADC1->IER), ADC_IER_JEOSIE);
+
+    if (false == this->is_injected_auto())
+    {
+        set_flag(&(ADC1->CR), ADC_CR_JADSTART);
+    }
+}
+
+void ADC::stop_injected_it()
+{
+    assert(nullptr != p_adc_1);
+
+    clear_flag(&(ADC1->IER), ADC_IER_JEOSIE);
+
+    if (true == is_flag(ADC1->CR, ADC_CR_JADSTART))
+    {
+        set_flag(&(ADC1->CR), ADC_CR_JADSTP);
+        wait::until(&(ADC1->CR), ADC_CR_JADSTP, true);
+    }
+
+    this->injected_callback = { nullptr, nullptr };
+}
+
+void ADC::set_oversampling(const Oversampling& a_oversampling)
+{
+    assert(nullptr != p_adc_1);
+    assert(Oversampling::Ratio::unknown != a_oversampling.ratio);
+    assert(a_oversampling.shift <= 8);
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    assert(true == is_oversampling_in_range(static_cast<Resolution>(ADC1->CFGR & ADC_CFGR_RES), a_oversampling));
+
+    set_flag(&(ADC1->CFGR2),
+             ADC_CFGR2_OVSR | ADC_CFGR2_OVSS | ADC_CFGR2_TROVS | ADC_CFGR2_ROVSM | ADC_CFGR2_ROVSE,
+             get_CFGR2_oversampling(a_oversampling));
+}
+
+void ADC::clear_oversampling()
+{
+    assert(nullptr != p_adc_1);
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    clear_flag(&(ADC1->CFGR2), ADC_CFGR2_OVSR | ADC_CFGR2_OVSS | ADC_CFGR2_TROVS | ADC_CFGR2_ROVSM | ADC_CFGR2_ROVSE);
+}
+
+void ADC::enable_analog_watchdog(Analog_watchdog::Id a_id,
+                                 const Analog_watchdog& a_config,
+                                 const Analog_watchdog::Callback& a_callback)
+{
+    assert(nullptr != p_adc_1);
+    assert(nullptr != a_callback.function);
+    assert(a_config.low_threshold <= a_config.high_threshold && a_config.high_threshold <= 0xFFFu);
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    const uint32_t index = static_cast<uint32_t>(a_id);
+
+    this->analog_watchdog_callbacks[index] = a_callback;
+
+    if (Analog_watchdog::Id::_1 == a_id)
+    {
+        assert(nullptr == a_config.p_channels || 1 == a_config.channels_count);
+
+        ADC1->TR1 = (static_cast<uint32_t>(a_config.high_threshold) << ADC_TR1_HT1_Pos) |
+                    (static_cast<uint32_t>(a_config.low_threshold) << ADC_TR1_LT1_Pos);
+
+        set_flag(&(ADC1->CFGR),
+                 ADC_CFGR_AWD1CH | ADC_CFGR_AWD1SGL | ADC_CFGR_AWD1EN,
+                 (nullptr != a_config.p_channels ?
+                  (static_cast<uint32_t>(a_config.p_channels[0]) << ADC_CFGR_AWD1CH_Pos) | ADC_CFGR_AWD1SGL :
+                  0x0u) |
+                 ADC_CFGR_AWD1EN);
+    }
+    else
+    {
+        assert(nullptr != a_config.p_channels);
+        assert(a_config.channels_count > 0);
+
+        uint32_t channels = 0;
+
+        for (uint32_t i = 0; i < a_config.channels_count; i++)
+        {
+            assert(Channel::Id::unknown != a_config.p_channels[i]);
+            channels |= 1u << static_cast<uint32_t>(a_config.p_channels[i]);
+        }
+
+        const uint32_t tr = get_TR2_TR3(a_config);
+
+        if (Analog_watchdog::Id::_2 == a_id)
+        {
+            ADC1->TR2    = tr;
+            ADC1->AWD2CR = channels;
+        }
+        else
+        {
+            ADC1->TR3    = tr;
+            ADC1->AWD3CR = channels;
+        }
+    }
+
+    ADC1->ISR = ADC_ISR_AWD1 << index;
+    set_flag(&(ADC1->IER), ADC_IER_AWD1IE << index);
+}
+
+void ADC::disable_analog_watchdog(Analog_watchdog::Id a_id)
+{
+    assert(nullptr != p_adc_1);
+    assert(false == is_flag(ADC1->CR, ADC_CR_ADSTART));
+
+    const uint32_t index = static_cast<uint32_t>(a_id);
+
+    clear_flag(&(ADC1->IER), ADC_IER_AWD1IE << index);
+
+    switch (a_id)
+    {
+        case Analog_watchdog::Id::_1:
+        {
+            clear_flag(&(ADC1->CFGR), ADC_CFGR_AWD1CH | ADC_CFGR_AWD1SGL | ADC_CFGR_AWD1EN);
+        }
+        break;
+
+        case Analog_watchdog::Id::_2:
+        {
+            ADC1->AWD2CR = 0;
+        }
+        break;
+
+        case Analog_watchdog::Id::_3:
+        {
+            ADC1->AWD3CR = 0;
+        }
+        break;
+    }
+
+    ADC1->ISR = ADC_ISR_AWD1 << index;
+
+    this->analog_watchdog_callbacks[index] = { nullptr, nullptr };
+}
+
+void ADC::rearm_analog_watchdog(Analog_watchdog::Id a_id)
+{
+    assert(nullptr != p_adc_1);
+
+    const uint32_t index = static_cast<uint32_t>(a_id);
+
+    assert(nullptr != this->analog_watchdog_callbacks[index].function);
+
+    ADC1->ISR = ADC_ISR_AWD1 << index;
+    set_flag(&(ADC1->IER), ADC_IER_AWD1IE << index);
+}
+
 void ADC::set_resolution(Resolution a_resolution)
 {
     assert(nullptr != p_adc_1);
@@ -324,6 +747,8 @@ bool ADC::enable(Resolution a_resolution, time::tick a_start, uint32_t a_irq_pri
     p_adc_1 = this;
 
     NVIC_SetPriority(ADC1_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel1_IRQn, a_irq_priority);
+
     NVIC_EnableIRQ(ADC1_IRQn);
 
     clear_flag(&(ADC1->CR), ADC_CR_DEEPPWD);
@@ -130,6 +130,118 @@ public:
         Divider divider = Divider::unknown;
     };
 
+    struct Trigger
+    {
+        enum class Source : uint32_t
+        {
+            tim1_cc1    = 0x0u,
+            tim1_cc2    = 0x1u,
+            tim1_cc3    = 0x2u,
+            tim2_cc2    = 0x3u,
+            tim3_trgo   = 0x4u,
+            exti_11     = 0x6u,
+            tim1_trgo   = 0x9u,
+            tim1_trgo_2 = 0xAu,
+            tim2_trgo   = 0xBu,
+            tim6_trgo   = 0xDu,
+            tim15_trgo  = 0xEu,
+            tim3_cc4    = 0xFu,
+            unknown
+        };
+
+        enum class Edge : uint32_t
+        {
+            rising  = ADC_CFGR_EXTEN_0,
+            falling = ADC_CFGR_EXTEN_1,
+            both    = ADC_CFGR_EXTEN_0 | ADC_CFGR_EXTEN_1,
+            unknown
+        };
+
+        Source source = Source::unknown;
+        Edge edge     = Edge::unknown;
+    };
+
+    struct Injected_trigger
+    {
+        enum class Source : uint32_t
+        {
+            tim1_trgo   = 0x0u,
+            tim1_cc4    = 0x1u,
+            tim2_trgo   = 0x2u,
+            tim2_cc1    = 0x3u,
+            tim3_cc4    = 0x4u,
+            exti_15     = 0x6u,
+            tim1_trgo_2 = 0x8u,
+            tim3_cc3    = 0xBu,
+            tim3_trgo   = 0xCu,
+            tim3_cc1    = 0xDu,
+            tim6_trgo   = 0xEu,
+            tim15_trgo  = 0xFu,
+            unknown
+        };
+
+        Source source      = Source::unknown;
+        Trigger::Edge edge = Trigger::Edge::unknown;
+    };
+
+    struct Injected_callback
+    {
+        using Function = bool(*)(const uint16_t* a_p_data, uint32_t a_count, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    struct Oversampling
+    {
+        enum class Ratio : uint32_t
+        {
+            _2   = 0x0u,
+            _4   = 0x1u,
+            _8   = 0x2u,
+            _16  = 0x3u,
+            _32  = 0x4u,
+            _64  = 0x5u,
+            _128 = 0x6u,
+            _256 = 0x7u,
+            unknown
+        };
+
+        Ratio ratio    = Ratio::unknown;
+        uint32_t shift = 0; // 0 - 8 bits right shift of the accumulated value
+
+        bool triggered = false; // every oversampled conversion needs its own trigger
+    };
+
+    struct Analog_watchdog
+    {
+        enum class Id : uint32_t
+        {
+            _1,
+            _2,
+            _3
+        };
+
+        struct Callback
+        {
+            using Function = bool(*)(Id a_id, void* a_p_user_data);
+
+            Function function = nullptr;
+            void* p_user_data = nullptr;
+        };
+
+        /*
+            Thresholds are 12-bit values, watchdogs 2 and 3 compare only the 8 MSBs.
+            Watchdog 1 guards one channel (channels_count == 1) or all of them (p_channels == nullptr),
+            watchdogs 2 and 3 any set of channels.
+        */
+        const Channel::Id* p_channels = nullptr;
+        uint32_t channels_count       = 0;
+
+        uint16_t low_threshold  = 0;
+        uint16_t high_threshold = 0xFFFu;
+    };
+
     struct Calibration_data
     {
         uint16_t temperature_sensor_data_1  = 0;
@@ -145,6 +257,14 @@ public:
         void* p_user_data = nullptr;
     };
 
+    struct DMA_callback
+    {
+        using Function = bool(*)(const uint16_t* a_p_data, uint32_t a_count, bool a_second_half, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
 public:
 
     ADC(Id) {}
@@ -175,6 +295,167 @@ public:
     void start_read_it(const Conversion_callback& a_callback);
     void stop_read_it();
 
+    /*
+        Continuous (or triggered, see set_trigger) scan of the active channels, DMA1 channel 1 in circular mode
+        writes the results to a_p_buffer.
+        The callback is called (from the interrupt) for every completed half of the buffer, while the other half
+        is being filled, return false to stop. a_buffer_capacity has to be a multiple of twice the active channels
+        count, so every half starts with the first channel of the sequence.
+    */
+    void start_read_dma(uint16_t* a_p_buffer, uint32_t a_buffer_capacity, const DMA_callback& a_callback);
+    void stop_read_dma();
+
+    bool is_read_dma_active() const
+    {
+        return nullptr != this->dma_read.callback.function;
+    }
+
+    /*
+        DMA1 channel 1 interrupt part of start_read_dma: calls a_callback for the halves flagged in a_isr
+        (DMA1 ISR), the first half before the second one when both are pending.
+        Returns false when the transfer has to be stopped (transfer error or a callback returned false).
+    */
+    static bool dispatch_read_dma(uint32_t a_isr,
+                                  const uint16_t* a_p_buffer,
+                                  uint32_t a_buffer_capacity,
+                                  const DMA_callback& a_callback)
+    {
+        bool ret = 0 == (a_isr & DMA_ISR_TEIF1);
+
+        if (true == ret)
+        {
+            const uint32_t half = a_buffer_capacity / 2;
+
+            if (0 != (a_isr & DMA_ISR_HTIF1))
+            {
+                ret = a_callback.function(a_p_buffer, half, false, a_callback.p_user_data);
+            }
+
+            if (true == ret && 0 != (a_isr & DMA_ISR_TCIF1))
+            {
+                ret = a_callback.function(a_p_buffer + half, half, true, a_callback.p_user_data);
+            }
+        }
+
+        return ret;
+    }
+
+    /*
+        With a trigger set, ADSTART (read_polling, start_read_it, start_read_dma) only arms the ADC
+        and every trigger event converts the whole active channels sequence once.
+    */
+    void set_trigger(const Trigger& a_trigger);
+    void clear_trigger();
+
+    bool is_trigger_set() const
+    {
+        return 0 != (ADC1->CFGR & ADC_CFGR_EXTEN);
+    }
+
+    // CFGR EXTSEL and EXTEN bits of a_trigger
+    static constexpr uint32_t get_CFGR_trigger(const Trigger& a_trigger)
+    {
+        return (static_cast<uint32_t>(a_trigger.source) << ADC_CFGR_EXTSEL_Pos) | static_cast<uint32_t>(a_trigger.edge);
+    }
+
+    /*
+        Injected sequence (up to 4 channels), converted on a software start, on its own trigger or automatically
+        after every regular sequence (auto injection, no trigger allowed). A triggered injected sequence
+        interrupts a running regular scan, which resumes when the injected sequence ends.
+        Sampling times are per channel, shared with the regular sequence.
+    */
+    void set_injected_channels(const Channel* a_p_channels, uint32_t a_channels_count);
+    void clear_injected_channels();
+
+    void set_injected_trigger(const Injected_trigger& a_trigger);
+    void clear_injected_trigger();
+
+    void set_injected_auto(bool a_enable);
+
+    bool read_injected_polling(uint16_t* a_p_data, uint32_t a_count, cml::time::tick a_timeout);
+
+    void start_injected_it(const Injected_callback& a_callback);
+    void stop_injected_it();
+
+    uint32_t get_injected_channels_count() const
+    {
+        return (ADC1->JSQR & ADC_JSQR_JL) + 1;
+    }
+
+    bool is_injected_trigger_set() const
+    {
+        return 0 != (ADC1->JSQR & ADC_JSQR_JEXTEN);
+    }
+
+    bool is_injected_auto() const
+    {
+        return 0 != (ADC1->CFGR & ADC_CFGR_JAUTO);
+    }
+
+    // JSQR JL and JSQ1-JSQ4 bits of the injected sequence
+    static constexpr uint32_t get_JSQR_channels(const Channel* a_p_channels, uint32_t a_channels_count)
+    {
+        uint32_t ret = a_channels_count - 1;
+
+        for (uint32_t i = 0; i < a_channels_count; i++)
+        {
+            ret |= static_cast<uint32_t>(a_p_channels[i].id) << (ADC_JSQR_JSQ1_Pos + 6 * i);
+        }
+
+        return ret;
+    }
+
+    // JSQR JEXTSEL and JEXTEN bits of a_trigger
+    static constexpr uint32_t get_JSQR_trigger(const Injected_trigger& a_trigger)
+    {
+        return (static_cast<uint32_t>(a_trigger.source) << ADC_JSQR_JEXTSEL_Pos) |
+               ((static_cast<uint32_t>(a_trigger.edge) >> ADC_CFGR_EXTEN_Pos) << ADC_JSQR_JEXTEN_Pos);
+    }
+
+    /*
+        Oversampled result: sum of the ratio samples shifted right by shift bits, up to 16 bits.
+    */
+    void set_oversampling(const Oversampling& a_oversampling);
+    void clear_oversampling();
+
+    bool is_oversampling() const
+    {
+        return 0 != (ADC1->CFGR2 & ADC_CFGR2_ROVSE);
+    }
+
+    // CFGR2 OVSR, OVSS, TROVS and ROVSE bits of a_oversampling
+    static constexpr uint32_t get_CFGR2_oversampling(const Oversampling& a_oversampling)
+    {
+        return (static_cast<uint32_t>(a_oversampling.ratio) << ADC_CFGR2_OVSR_Pos) |
+               (a_oversampling.shift << ADC_CFGR2_OVSS_Pos) |
+               (true == a_oversampling.triggered ? ADC_CFGR2_TROVS : 0x0u) |
+               ADC_CFGR2_ROVSE;
+    }
+
+    // resolution bits + log2(ratio) - shift <= 16
+    static constexpr bool is_oversampling_in_range(Resolution a_resolution, const Oversampling& a_oversampling)
+    {
+        return get_resolution_bits(a_resolution) + static_cast<uint32_t>(a_oversampling.ratio) + 1 <=
+               16 + a_oversampling.shift;
+    }
+
+    /*
+        The callback is called (from the interrupt) when a guarded channel conversion leaves the window,
+        return true to keep the watchdog interrupt armed, false to get notified only once.
+    */
+    void enable_analog_watchdog(Analog_watchdog::Id a_id,
+                                const Analog_watchdog& a_config,
+                                const Analog_watchdog::Callback& a_callback);
+    void disable_analog_watchdog(Analog_watchdog::Id a_id);
+    void rearm_analog_watchdog(Analog_watchdog::Id a_id);
+
+    // TR2/TR3 value of the 12-bit thresholds (8 MSBs)
+    static constexpr uint32_t get_TR2_TR3(const Analog_watchdog& a_config)
+    {
+        return (static_cast<uint32_t>(a_config.high_threshold >> 4u) << ADC_TR2_HT2_Pos) |
+               (static_cast<uint32_t>(a_config.low_threshold >> 4u) << ADC_TR2_LT2_Pos);
+    }
+
     uint32_t get_active_channels_count() const
     {
         return (ADC1->SQR1 & 0xFu) + 1;
@@ -182,6 +463,11 @@ public:
 
     void set_resolution(Resolution a_resolution);
 
+    static constexpr uint32_t get_resolution_bits(Resolution a_resolution)
+    {
+        return 12u - (static_cast<uint32_t>(a_resolution) >> ADC_CFGR_RES_Pos) * 2u;
+    }
+
     constexpr Calibration_data get_calibration_data() const
     {
         return { *(reinterpret_cast<const uint16_t*>(0x1FFF75A8)),
@@ -202,13 +488,27 @@ private:
                 uint32_t a_irq_priority,
                 cml::time::tick a_timeout);
 
+private:
+
+    struct DMA_read
+    {
+        uint16_t* p_buffer       = nullptr;
+        uint32_t buffer_capacity = 0;
+
+        DMA_callback callback;
+    };
+
 private:
 
     Conversion_callback callaback;
+    DMA_read dma_read;
+    Injected_callback injected_callback;
+    Analog_watchdog::Callback analog_watchdog_callbacks[3];
 
 private:
 
     friend void adc_interrupt_handler(ADC* a_p_this);
+    friend void adc_dma_interrupt_handler(ADC* a_p_this);
 };
 
 } // namespace peripherals
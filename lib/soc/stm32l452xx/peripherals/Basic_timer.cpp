@@ -0,0 +1,129 @@
+/*
+    Name: Basic_timer.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef STM32L452xx
+
+//this
+#include <soc/stm32l452xx/peripherals/Basic_timer.hpp>
+
+//soc
+#include <soc/stm32l452xx/mcu.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace
+{
+
+using namespace soc::stm32l452xx::peripherals;
+
+Basic_timer* p_timer_6 = nullptr;
+
+} // namespace ::
+
+extern "C"
+{
+
+void TIM6_DAC_IRQHandler()
+{
+    assert(nullptr != p_timer_6);
+    basic_timer_interrupt_handler(p_timer_6);
+}
+
+} // extern "C"
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+using namespace cml;
+
+void basic_timer_interrupt_handler(Basic_timer* a_p_this)
+{
+    if (true == is_flag(TIM6->SR, TIM_SR_UIF))
+    {
+        TIM6->SR = ~TIM_SR_UIF;
+
+        if (nullptr != a_p_this->update_callback.function)
+        {
+            a_p_this->update_callback.function(a_p_this->update_callback.p_user_data);
+        }
+    }
+}
+
+void Basic_timer::enable(const Config& a_config, uint32_t a_irq_priority)
+{
+    assert(nullptr == p_timer_6);
+    assert(a_config.auto_reload > 0);
+
+    p_timer_6 = this;
+
+    set_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_TIM6EN);
+
+    configure(TIM6, a_config);
+
+    NVIC_SetPriority(TIM6_DAC_IRQn, a_irq_priority);
+    NVIC_EnableIRQ(TIM6_DAC_IRQn);
+}
+
+void Basic_timer::disable()
+{
+    if (this == p_timer_6)
+    {
+        TIM6->CR1  = 0;
+        TIM6->DIER = 0;
+
+        clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_TIM6EN);
+        NVIC_DisableIRQ(TIM6_DAC_IRQn);
+
+        this->update_callback = { nullptr, nullptr };
+
+        p_timer_6 = nullptr;
+    }
+}
+
+void Basic_timer::start()
+{
+    assert(this == p_timer_6);
+
+    TIM6->CNT = 0;
+    set_flag(&(TIM6->CR1), TIM_CR1_CEN);
+}
+
+void Basic_timer::stop()
+{
+    assert(this == p_timer_6);
+
+    clear_flag(&(TIM6->CR1), TIM_CR1_CEN);
+}
+
+void Basic_timer::register_update_callback(const Update_callback& a_callback)
+{
+    assert(this == p_timer_6);
+    assert(nullptr != a_callback.function);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    this->update_callback = a_callback;
+    set_flag(&(TIM6->DIER), TIM_DIER_UIE);
+}
+
+void Basic_timer::unregister_update_callback()
+{
+    assert(this == p_timer_6);
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    clear_flag(&(TIM6->DIER), TIM_DIER_UIE);
+    this->update_callback = { nullptr, nullptr };
+}
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
+
+#endif // STM32L452xx
@@ -0,0 +1,136 @@
+#pragma once
+
+/*
+    Name: Basic_timer.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#include <stm32l452xx.h>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/frequency.hpp>
+#include <cml/Non_copyable.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+class Basic_timer : private cml::Non_copyable
+{
+public:
+
+    enum class Id : uint32_t
+    {
+        _6 = 0u
+    };
+
+    enum class Trigger_output : uint32_t
+    {
+        reset  = 0x0u,
+        enable = TIM_CR2_MMS_0,
+        update = TIM_CR2_MMS_1
+    };
+
+    struct Config
+    {
+        uint16_t prescaler   = 0;
+        uint16_t auto_reload = 0;
+
+        Trigger_output trigger_output = Trigger_output::update;
+    };
+
+    struct Update_callback
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    Basic_timer(Id) {}
+
+    ~Basic_timer()
+    {
+        this->disable();
+    }
+
+    void enable(const Config& a_config, uint32_t a_irq_priority);
+    void disable();
+
+    void start();
+    void stop();
+
+    void register_update_callback(const Update_callback& a_callback);
+    void unregister_update_callback();
+
+    bool is_started() const
+    {
+        return cml::is_flag(TIM6->CR1, TIM_CR1_CEN);
+    }
+
+    uint16_t get_counter() const
+    {
+        return static_cast<uint16_t>(TIM6->CNT);
+    }
+
+    constexpr Id get_id() const
+    {
+        return Id::_6;
+    }
+
+    /*
+        Prescaler and auto-reload for the update (TRGO) frequency closest to a_update_frequency_hz,
+        with the smallest prescaler (best resolution). The timer kernel clock is PCLK1, or 2 x PCLK1 when
+        the APB1 prescaler is not 1.
+    */
+    static constexpr Config calculate_config(cml::frequency a_timer_clock_hz,
+                                             cml::frequency a_update_frequency_hz,
+                                             Trigger_output a_trigger_output = Trigger_output::update)
+    {
+        const uint32_t ticks     = (a_timer_clock_hz + a_update_frequency_hz / 2) / a_update_frequency_hz;
+        const uint32_t prescaler = ticks > 0 ? (ticks - 1) / 0x10000u : 0;
+        const uint32_t period    = (ticks + (prescaler + 1) / 2) / (prescaler + 1);
+
+        return { static_cast<uint16_t>(prescaler),
+                 static_cast<uint16_t>(period > 1 ? period - 1 : 1),
+                 a_trigger_output };
+    }
+
+    static constexpr cml::frequency get_update_frequency_hz(cml::frequency a_timer_clock_hz, const Config& a_config)
+    {
+        return a_timer_clock_hz / ((a_config.prescaler + 1u) * (a_config.auto_reload + 1u));
+    }
+
+    // registers setup of enable(): counter stopped, prescaler and auto-reload loaded by an update event
+    static void configure(TIM_TypeDef* a_p_registers, const Config& a_config)
+    {
+        a_p_registers->CR1 = TIM_CR1_ARPE | TIM_CR1_URS;
+        a_p_registers->CR2 = static_cast<uint32_t>(a_config.trigger_output);
+        a_p_registers->PSC = a_config.prescaler;
+        a_p_registers->ARR = a_config.auto_reload;
+
+        cml::set_flag(&(a_p_registers->EGR), TIM_EGR_UG);
+        a_p_registers->SR = 0;
+    }
+
+private:
+
+    Update_callback update_callback;
+
+private:
+
+    friend void basic_timer_interrupt_handler(Basic_timer* a_p_this);
+};
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
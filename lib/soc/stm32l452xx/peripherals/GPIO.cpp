@@ -484,6 +484,67 @@ void pin::af::disable(GPIO* a_p_port, uint32_t a_id)
     a_p_port->give_pin(a_id);
 }
 
+void pin::bus::enable(GPIO* a_p_port, const uint8_t* a_p_ids, uint32_t a_width, const out::Config& a_config, Bus* a_p_out_bus)
+{
+    assert(nullptr != a_p_port);
+    assert(nullptr != a_p_ids);
+    assert(a_width > 0 && a_width <= 16);
+
+    for (uint32_t i = 0; i < a_width; i++)
+    {
+        out::enable(a_p_port, a_p_ids[i], a_config);
+    }
+
+    if (nullptr != a_p_out_bus)
+    {
+        bind(static_cast<GPIO_TypeDef*>(*(a_p_port)), a_p_ids, a_width, a_p_out_bus);
+        a_p_out_bus->p_port = a_p_port;
+    }
+}
+
+void pin::bus::disable(GPIO* a_p_port, const uint8_t* a_p_ids, uint32_t a_width)
+{
+    assert(nullptr != a_p_ids);
+    assert(a_width <= 16);
+
+    for (uint32_t i = 0; i < a_width; i++)
+    {
+        out::disable(a_p_port, a_p_ids[i]);
+    }
+}
+
+void pin::table::enable(GPIO* a_p_port, const Image& a_image)
+{
+    assert(nullptr != a_p_port);
+    assert(true == a_p_port->is_enabled());
+
+    a_p_port->flags = apply(static_cast<GPIO_TypeDef*>(*(a_p_port)), a_p_port->flags, a_image);
+}
+
+void pin::table::disable(GPIO* a_p_port, const Image& a_image)
+{
+    assert(nullptr != a_p_port);
+    assert(true == a_p_port->is_enabled());
+
+    GPIO_TypeDef* p_port = static_cast<GPIO_TypeDef*>(*(a_p_port));
+
+    uint32_t mask_2bit = 0;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        if (true == is_bit(a_image.pins, i))
+        {
+            mask_2bit |= 0x3u << (i * 2u);
+        }
+    }
+
+    p_port->MODER   = p_port->MODER | mask_2bit;
+    p_port->OSPEEDR = p_port->OSPEEDR & ~mask_2bit;
+    p_port->PUPDR   = p_port->PUPDR & ~mask_2bit;
+
+    a_p_port->flags &= ~a_image.pins;
+}
+
 } // namespace peripherals
 } // namespace stm32l452xx
 } // namespace soc
@@ -67,6 +67,8 @@ struct pin
     class out;
     class analog;
     class af;
+    class bus;
+    class table;
 
     class In : private cml::Non_copyable
     {
@@ -227,6 +229,122 @@ struct pin
         friend af;
     };
 
+    /*
+        N pins of one port driven as a parallel bus, bit i of the value is the pin a_p_ids[i].
+        Every write is one BSRR store (all pins change at once, no read-modify-write), masks are computed
+        in pin::bus::bind (called by pin::bus::enable). Pins forming a contiguous, ascending range are written and
+        read with a single shift.
+    */
+    class Bus : private cml::Non_copyable
+    {
+    public:
+
+        enum class Direction : uint32_t
+        {
+            in  = 0x0u,
+            out = 0x1u
+        };
+
+    public:
+
+        Bus()
+            : p_port(nullptr)
+            , p_registers(nullptr)
+            , mask(0)
+            , moder_mask(0)
+            , width(0)
+            , shift(0)
+            , contiguous(false)
+            , ids{}
+        {}
+        ~Bus() = default;
+
+        void write(uint32_t a_value)
+        {
+            assert(nullptr != this->p_registers);
+
+            uint32_t set = 0;
+
+            if (true == this->contiguous)
+            {
+                set = (a_value << this->shift) & this->mask;
+            }
+            else
+            {
+                for (uint32_t i = 0; i < this->width; i++)
+                {
+                    set |= ((a_value >> i) & 0x1u) << this->ids[i];
+                }
+            }
+
+            this->p_registers->BSRR = set | ((this->mask & ~set) << 16u);
+        }
+
+        uint32_t read() const
+        {
+            assert(nullptr != this->p_registers);
+
+            const uint32_t idr = this->p_registers->IDR;
+            uint32_t ret       = 0;
+
+            if (true == this->contiguous)
+            {
+                ret = (idr & this->mask) >> this->shift;
+            }
+            else
+            {
+                for (uint32_t i = 0; i < this->width; i++)
+                {
+                    ret |= ((idr >> this->ids[i]) & 0x1u) << i;
+                }
+            }
+
+            return ret;
+        }
+
+        void set_direction(Direction a_direction)
+        {
+            assert(nullptr != this->p_registers);
+
+            cml::set_flag(&(this->p_registers->MODER),
+                          this->moder_mask,
+                          Direction::out == a_direction ? this->moder_mask & 0x55555555u : 0x0u);
+        }
+
+        GPIO* get_port() const
+        {
+            return this->p_port;
+        }
+
+        uint32_t get_width() const
+        {
+            return this->width;
+        }
+
+        uint32_t get_mask() const
+        {
+            return this->mask;
+        }
+
+    private:
+
+        GPIO* p_port;
+        GPIO_TypeDef* p_registers;
+
+        uint32_t mask;
+        uint32_t moder_mask;
+
+        uint8_t width;
+        uint8_t shift;
+        bool contiguous;
+
+        uint8_t ids[16];
+
+    private:
+
+        friend bus;
+    };
+
     class in
     {
     public:
@@ -338,6 +456,223 @@ struct pin
             p_pin->id     = 0xFF;
         }
     };
+    class bus
+    {
+    public:
+
+        bus()            = delete;
+        bus(bus&&)       = delete;
+        bus(const bus&&) = delete;
+
+        bus& operator = (bus&&)      = delete;
+        bus& operator = (const bus&) = delete;
+
+        static void enable(GPIO* a_p_port,
+                           const uint8_t* a_p_ids,
+                           uint32_t a_width,
+                           const out::Config& a_config,
+                           Bus* a_p_out_bus = nullptr);
+        static void disable(GPIO* a_p_port, const uint8_t* a_p_ids, uint32_t a_width);
+
+        static void disable(Bus* p_bus)
+        {
+            disable(p_bus->get_port(), p_bus->ids, p_bus->width);
+
+            p_bus->p_port      = nullptr;
+            p_bus->p_registers = nullptr;
+            p_bus->mask        = 0;
+            p_bus->width       = 0;
+        }
+
+        // masks and pin map of a_p_out_bus over a_p_registers, the pins are not configured (see enable)
+        static void bind(GPIO_TypeDef* a_p_registers, const uint8_t* a_p_ids, uint32_t a_width, Bus* a_p_out_bus)
+        {
+            assert(nullptr != a_p_registers);
+            assert(nullptr != a_p_ids);
+            assert(nullptr != a_p_out_bus);
+            assert(a_width > 0 && a_width <= 16);
+
+            uint32_t mask       = 0;
+            uint32_t moder_mask = 0;
+            bool contiguous     = true;
+
+            for (uint32_t i = 0; i < a_width; i++)
+            {
+                assert(a_p_ids[i] < 16);
+                assert(0 == (mask & (0x1u << a_p_ids[i])));
+
+                mask       |= 0x1u << a_p_ids[i];
+                moder_mask |= 0x3u << (a_p_ids[i] * 2);
+                contiguous  = contiguous && a_p_ids[i] == a_p_ids[0] + i;
+
+                a_p_out_bus->ids[i] = a_p_ids[i];
+            }
+
+            a_p_out_bus->p_registers = a_p_registers;
+            a_p_out_bus->mask        = mask;
+            a_p_out_bus->moder_mask  = moder_mask;
+            a_p_out_bus->width       = static_cast<uint8_t>(a_width);
+            a_p_out_bus->shift       = a_p_ids[0];
+            a_p_out_bus->contiguous  = contiguous;
+        }
+    };
+
+    /*
+        Declarative configuration of many pins of one port: the entries are folded (at compile time for constexpr
+        tables) into register images, enable writes every register of the port once and takes all pins.
+
+        constexpr pin::table::Entry entries[] = { { 5, pin::table::Type::out }, { 9, pin::table::Type::af, ... } };
+        constexpr pin::table::Image image     = pin::table::get_image(entries);
+        static_assert(true == image.valid, "invalid pin table");
+
+        pin::table::enable(&gpio_port_a, image);
+    */
+    class table
+    {
+    public:
+
+        enum class Type : uint32_t
+        {
+            in,
+            out,
+            analog,
+            af
+        };
+
+        struct Entry
+        {
+            uint8_t id  = 0xFF;
+            Type type   = Type::in;
+            Mode mode   = Mode::push_pull;
+            Pull pull   = Pull::none;
+            Speed speed = Speed::low;
+
+            Level level       = Level::low; // out only, set before the pin is switched to output
+            uint32_t function = 0;          // af only
+        };
+
+        // register images of all entries, valid == false: pin used twice, id or value out of range
+        struct Image
+        {
+            uint32_t pins = 0;
+
+            uint32_t moder   = 0;
+            uint32_t otyper  = 0;
+            uint32_t ospeedr = 0;
+            uint32_t pupdr   = 0;
+            uint32_t bsrr    = 0;
+
+            uint32_t afr[2]      = { 0, 0 };
+            uint32_t afr_mask[2] = { 0, 0 };
+
+            bool valid = true;
+        };
+
+    public:
+
+        table()              = delete;
+        table(table&&)       = delete;
+        table(const table&&) = delete;
+
+        table& operator = (table&&)      = delete;
+        table& operator = (const table&) = delete;
+
+        static constexpr Image get_image(const Entry* a_p_entries, uint32_t a_count)
+        {
+            constexpr uint32_t moder[] = { 0x0u, 0x1u, 0x3u, 0x2u };
+
+            Image ret;
+
+            for (uint32_t i = 0; i < a_count && true == ret.valid; i++)
+            {
+                const Entry& entry = a_p_entries[i];
+
+                ret.valid = entry.id < 16 &&
+                            0 == (ret.pins & (0x1u << entry.id)) &&
+                            Mode::unknown != entry.mode &&
+                            Pull::unknown != entry.pull &&
+                            Speed::unknown != entry.speed &&
+                            entry.function <= 0xFu;
+
+                if (true == ret.valid)
+                {
+                    const uint32_t shift_2bit = entry.id * 2u;
+                    const uint32_t afr_index  = entry.id >> 3u;
+                    const uint32_t afr_shift  = (entry.id & 0x7u) * 4u;
+
+                    ret.pins    |= 0x1u << entry.id;
+                    ret.moder   |= moder[static_cast<uint32_t>(entry.type)] << shift_2bit;
+                    ret.otyper  |= static_cast<uint32_t>(entry.mode) << entry.id;
+                    ret.ospeedr |= static_cast<uint32_t>(entry.speed) << shift_2bit;
+                    ret.pupdr   |= static_cast<uint32_t>(entry.pull) << shift_2bit;
+
+                    if (Type::out == entry.type)
+                    {
+                        ret.bsrr |= (Level::high == entry.level ? 0x1u : 0x10000u) << entry.id;
+                    }
+
+                    if (Type::af == entry.type)
+                    {
+                        ret.afr[afr_index]      |= entry.function << afr_shift;
+                        ret.afr_mask[afr_index] |= 0xFu << afr_shift;
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+        template<uint32_t count>
+        static constexpr Image get_image(const Entry(&a_entries)[count])
+        {
+            return get_image(a_entries, count);
+        }
+
+        /*
+            Writes a_image into the port registers: BSRR first (output levels before the pins are switched),
+            MODER last, one read-modify-write of every other register (AFR only when used).
+            a_taken_pins: pins already used on the port, returns them with the pins of the image.
+        */
+        template<typename Registers_t>
+        static uint32_t apply(Registers_t* a_p_registers, uint32_t a_taken_pins, const Image& a_image)
+        {
+            assert(nullptr != a_p_registers);
+            assert(true == a_image.valid);
+            assert(0 == (a_taken_pins & a_image.pins));
+
+            uint32_t mask_1bit = 0;
+            uint32_t mask_2bit = 0;
+
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                if (true == cml::is_bit(a_image.pins, i))
+                {
+                    mask_1bit |= 0x1u << i;
+                    mask_2bit |= 0x3u << (i * 2u);
+                }
+            }
+
+            a_p_registers->BSRR    = a_image.bsrr;
+            a_p_registers->OTYPER  = (a_p_registers->OTYPER & ~mask_1bit) | a_image.otyper;
+            a_p_registers->OSPEEDR = (a_p_registers->OSPEEDR & ~mask_2bit) | a_image.ospeedr;
+            a_p_registers->PUPDR   = (a_p_registers->PUPDR & ~mask_2bit) | a_image.pupdr;
+
+            for (uint32_t i = 0; i < 2; i++)
+            {
+                if (0 != a_image.afr_mask[i])
+                {
+                    a_p_registers->AFR[i] = (a_p_registers->AFR[i] & ~a_image.afr_mask[i]) | a_image.afr[i];
+                }
+            }
+
+            a_p_registers->MODER = (a_p_registers->MODER & ~mask_2bit) | a_image.moder;
+
+            return a_taken_pins | a_image.pins;
+        }
+
+        static void enable(GPIO* a_p_port, const Image& a_image);
+        static void disable(GPIO* a_p_port, const Image& a_image);
+    };
 };
 
 class GPIO : private cml::Non_copyable
@@ -415,8 +750,149 @@ private:
     friend pin::out;
     friend pin::analog;
     friend pin::af;
+    friend pin::bus;
+    friend pin::table;
+};
+
+/*
+    Pins with the port and index as template constants: the register addresses and masks are known at compile
+    time, set_level is a single store to BSRR. enable/disable still take the GPIO object (clock and pin
+    allocation). unique_pins_v<...> rejects, at compile time, a set of typed pins using the same pin twice.
+
+    using Led    = Static_out<GPIO::Id::a, 5>;
+    using Button = Static_in<GPIO::Id::c, 13>;
+    static_assert(unique_pins_v<Led, Button>, "pin used twice");
+
+    Led::enable(&gpio_port_a, { pin::Mode::push_pull, pin::Pull::none, pin::Speed::low });
+    Led::set_level(pin::Level::high);
+*/
+template<GPIO::Id port_id, uint32_t id>
+class Static_pin
+{
+public:
+
+    Static_pin()                  = delete;
+    Static_pin(Static_pin&&)      = delete;
+    Static_pin(const Static_pin&) = delete;
+    ~Static_pin()                 = delete;
+
+    Static_pin& operator = (Static_pin&&)      = delete;
+    Static_pin& operator = (const Static_pin&) = delete;
+
+    static pin::Level get_level()
+    {
+        return static_cast<pin::Level>(cml::is_flag(get_registers()->IDR, mask));
+    }
+
+    static constexpr GPIO::Id get_port_id()
+    {
+        return port_id;
+    }
+
+    static constexpr uint32_t get_id()
+    {
+        return id;
+    }
+
+public:
+
+    static constexpr uint32_t mask = 0x1u << id;
+    static constexpr uint32_t key  = static_cast<uint32_t>(port_id) * 16u + id;
+
+protected:
+
+    static GPIO_TypeDef* get_registers()
+    {
+        return reinterpret_cast<GPIO_TypeDef*>(GPIOA_BASE + (GPIOB_BASE - GPIOA_BASE) * static_cast<uint32_t>(port_id));
+    }
+
+private:
+
+    static_assert(id < 16, "pin index out of range");
 };
 
+template<GPIO::Id port_id, uint32_t id>
+class Static_out : public Static_pin<port_id, id>
+{
+public:
+
+    Static_out()                  = delete;
+    Static_out(Static_out&&)      = delete;
+    Static_out(const Static_out&) = delete;
+    ~Static_out()                 = delete;
+
+    Static_out& operator = (Static_out&&)      = delete;
+    Static_out& operator = (const Static_out&) = delete;
+
+    static void enable(GPIO* a_p_port, const pin::out::Config& a_config)
+    {
+        assert(nullptr != a_p_port && port_id == a_p_port->get_id());
+        pin::out::enable(a_p_port, id, a_config);
+    }
+
+    static void disable(GPIO* a_p_port)
+    {
+        assert(nullptr != a_p_port && port_id == a_p_port->get_id());
+        pin::out::disable(a_p_port, id);
+    }
+
+    static void set_level(pin::Level a_level)
+    {
+        Static_out::get_registers()->BSRR = pin::Level::high == a_level ? Static_out::mask : Static_out::mask << 16u;
+    }
+
+    static void set_high()
+    {
+        Static_out::get_registers()->BSRR = Static_out::mask;
+    }
+
+    static void set_low()
+    {
+        Static_out::get_registers()->BSRR = Static_out::mask << 16u;
+    }
+
+    static void toggle_level()
+    {
+        GPIO_TypeDef* p_registers = Static_out::get_registers();
+        p_registers->BSRR         = cml::is_flag(p_registers->ODR, Static_out::mask) ? Static_out::mask << 16u :
+                                                                                        Static_out::mask;
+    }
+};
+
+template<GPIO::Id port_id, uint32_t id>
+class Static_in : public Static_pin<port_id, id>
+{
+public:
+
+    Static_in()                 = delete;
+    Static_in(Static_in&&)      = delete;
+    Static_in(const Static_in&) = delete;
+    ~Static_in()                = delete;
+
+    Static_in& operator = (Static_in&&)      = delete;
+    Static_in& operator = (const Static_in&) = delete;
+
+    static void enable(GPIO* a_p_port, pin::Pull a_pull)
+    {
+        assert(nullptr != a_p_port && port_id == a_p_port->get_id());
+        pin::in::enable(a_p_port, id, a_pull);
+    }
+
+    static void disable(GPIO* a_p_port)
+    {
+        assert(nullptr != a_p_port && port_id == a_p_port->get_id());
+        pin::in::disable(a_p_port, id);
+    }
+};
+
+// number of pins of Pins_t... with the key a_key
+template<uint32_t key, typename... Pins_t>
+inline constexpr uint32_t pins_count_v = (0u + ... + (key == Pins_t::key ? 1u : 0u));
+
+// true when no pin is used more than once: static_assert(unique_pins_v<Led, Button>)
+template<typename... Pins_t>
+inline constexpr bool unique_pins_v = (true && ... && (1u == pins_count_v<Pins_t::key, Pins_t...>));
+
 } // namespace peripherals
 } // namespace stm32l452xx
 } // namespace soc
\ No newline at end of file
@@ -12,16 +12,32 @@
 
 //soc
 #include <soc/counter.hpp>
+#include <soc/I2C_CR2.hpp>
 #include <soc/stm32l452xx/mcu.hpp>
+#include <soc/stm32l452xx/misc.hpp>
 
 //cml
 #include <cml/debug/assert.hpp>
+#include <cml/utils/SMBus_PEC.hpp>
 #include <cml/utils/wait.hpp>
 
 namespace {
 
 using namespace cml;
 using namespace soc::stm32l452xx::peripherals;
+using soc::I2C_CR2;
+
+struct DMA_channel
+{
+    DMA_TypeDef* p_dma             = nullptr;
+    DMA_Channel_TypeDef* p_channel = nullptr;
+    DMA_Request_TypeDef* p_request = nullptr;
+
+    uint32_t index   = 0;
+    uint32_t request = 0;
+
+    IRQn_Type irqn = NonMaskableInt_IRQn;
+};
 
 struct Controller
 {
@@ -34,6 +50,9 @@ struct Controller
 
     Enable_function enable   = nullptr;
     Disable_function disable = nullptr;
+
+    DMA_channel dma_tx;
+    DMA_channel dma_rx;
 };
 
 void i2c_1_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -44,13 +63,21 @@ void i2c_1_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
     set_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C1EN);
 
     NVIC_SetPriority(I2C1_EV_IRQn, a_irq_priority);
+    NVIC_SetPriority(I2C1_ER_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel6_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel7_IRQn, a_irq_priority);
+
     NVIC_EnableIRQ(I2C1_EV_IRQn);
+    NVIC_EnableIRQ(I2C1_ER_IRQn);
 }
 
 void i2c_1_disable()
 {
     clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C1EN);
     NVIC_DisableIRQ(I2C1_EV_IRQn);
+    NVIC_DisableIRQ(I2C1_ER_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel6_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel7_IRQn);
 }
 
 void i2c_2_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -61,13 +88,21 @@ void i2c_2_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
     set_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C2EN);
 
     NVIC_SetPriority(I2C2_EV_IRQn, a_irq_priority);
+    NVIC_SetPriority(I2C2_ER_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel4_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel5_IRQn, a_irq_priority);
+
     NVIC_EnableIRQ(I2C2_EV_IRQn);
+    NVIC_EnableIRQ(I2C2_ER_IRQn);
 }
 
 void i2c_2_disable()
 {
     clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C2EN);
     NVIC_DisableIRQ(I2C2_EV_IRQn);
+    NVIC_DisableIRQ(I2C2_ER_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel4_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel5_IRQn);
 }
 
 void i2c_3_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -78,13 +113,21 @@ void i2c_3_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
     set_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C3EN);
 
     NVIC_SetPriority(I2C3_EV_IRQn, a_irq_priority);
+    NVIC_SetPriority(I2C3_ER_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel2_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA1_Channel3_IRQn, a_irq_priority);
+
     NVIC_EnableIRQ(I2C3_EV_IRQn);
+    NVIC_EnableIRQ(I2C3_ER_IRQn);
 }
 
 void i2c_3_disable()
 {
     clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C3EN);
     NVIC_DisableIRQ(I2C3_EV_IRQn);
+    NVIC_DisableIRQ(I2C3_ER_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel2_IRQn);
+    NVIC_DisableIRQ(DMA1_Channel3_IRQn);
 }
 
 void i2c_4_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -95,13 +138,21 @@ void i2c_4_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
     set_flag(&(RCC->APB1ENR2), RCC_APB1ENR2_I2C4EN);
 
     NVIC_SetPriority(I2C4_EV_IRQn, a_irq_priority);
+    NVIC_SetPriority(I2C4_ER_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA2_Channel2_IRQn, a_irq_priority);
+    NVIC_SetPriority(DMA2_Channel1_IRQn, a_irq_priority);
+
     NVIC_EnableIRQ(I2C4_EV_IRQn);
+    NVIC_EnableIRQ(I2C4_ER_IRQn);
 }
 
 void i2c_4_disable()
 {
     clear_flag(&(RCC->APB1ENR2), RCC_APB1ENR2_I2C4EN);
     NVIC_DisableIRQ(I2C4_EV_IRQn);
+    NVIC_DisableIRQ(I2C4_ER_IRQn);
+    NVIC_DisableIRQ(DMA2_Channel2_IRQn);
+    NVIC_DisableIRQ(DMA2_Channel1_IRQn);
 }
 
 bool is_I2C_ISR_error(uint32_t a_isr)
@@ -148,6 +199,11 @@ I2C_base::Bus_status_flag get_bus_status_flag_from_I2C_ISR(uint32_t a_isr)
         ret |= I2C_base::Bus_status_flag::nack;
     }
 
+    if (true == is_flag(a_isr, I2C_ISR_PECERR))
+    {
+        ret |= I2C_base::Bus_status_flag::crc_error;
+    }
+
     return ret;
 }
 
@@ -194,12 +250,141 @@ uint32_t get_RCC_CCIPR_from_clock_source(I2C_base::Clock_source a_clock_source,
     return 0;
 }
 
+void flush_I2C_RXDR(I2C_TypeDef* a_p_registers)
+{
+    if (true == is_flag(a_p_registers->ISR, I2C_ISR_RXNE))
+    {
+        static_cast<void>(a_p_registers->RXDR);
+    }
+}
+
+void set_I2C_slave_CR2_PECBYTE(I2C_TypeDef* a_p_registers, uint32_t a_data_size_in_bytes)
+{
+    if (true == is_flag(a_p_registers->CR1, I2C_CR1_PECEN))
+    {
+        assert(a_data_size_in_bytes < 0xFF);
+
+        uint32_t bytes_to_reload = a_data_size_in_bytes;
+
+        set_flag(&(a_p_registers->CR1), I2C_CR1_SBC);
+        a_p_registers->CR2 = I2C_CR2::get_NBYTES_PECBYTE(a_p_registers, &bytes_to_reload);
+    }
+}
+
+void dma_channel_enable(const DMA_channel& a_channel,
+                        volatile uint32_t* a_p_peripheral,
+                        const void* a_p_memory,
+                        uint32_t a_data_size_in_bytes,
+                        bool a_memory_to_peripheral)
+{
+    set_flag(&(RCC->AHB1ENR), DMA1 == a_channel.p_dma ? RCC_AHB1ENR_DMA1EN : RCC_AHB1ENR_DMA2EN);
+    set_flag(&(a_channel.p_request->CSELR), DMA_CSELR_C1S << (a_channel.index * 4), a_channel.request << (a_channel.index * 4));
+    set_flag(&(a_channel.p_dma->IFCR), DMA_IFCR_CGIF1 << (a_channel.index * 4));
+
+    a_channel.p_channel->CCR   = 0;
+    a_channel.p_channel->CPAR  = reinterpret_cast<uint32_t>(a_p_peripheral);
+    a_channel.p_channel->CMAR  = reinterpret_cast<uint32_t>(a_p_memory);
+    a_channel.p_channel->CNDTR = a_data_size_in_bytes;
+    a_channel.p_channel->CCR   = (true == a_memory_to_peripheral ? DMA_CCR_DIR : 0) |
+                                 DMA_CCR_MINC |
+                                 DMA_CCR_TEIE |
+                                 DMA_CCR_EN;
+
+    NVIC_EnableIRQ(a_channel.irqn);
+}
+
+uint32_t dma_channel_disable(const DMA_channel& a_channel)
+{
+    clear_flag(&(a_channel.p_channel->CCR), DMA_CCR_EN);
+    set_flag(&(a_channel.p_dma->IFCR), DMA_IFCR_CGIF1 << (a_channel.index * 4));
+
+    NVIC_DisableIRQ(a_channel.irqn);
+    NVIC_ClearPendingIRQ(a_channel.irqn);
+
+    return a_channel.p_channel->CNDTR;
+}
+
+/*
+    Timed out master transfer: STOP is requested, if a slave holds SCL low the STOP never completes and
+    the peripheral is reset (PE cleared until it reads back 0) to release SCL and SDA.
+    A slave still holding SDA needs I2C_master::recover_bus.
+*/
+constexpr cml::time::tick master_stop_timeout = 2;
+
+void abort_I2C_master_transfer(I2C_TypeDef* a_p_registers)
+{
+    set_flag(&(a_p_registers->CR2), I2C_CR2_STOP);
+
+    if (false == cml::utils::wait::until(&(a_p_registers->ISR),
+                                         I2C_ISR_STOPF,
+                                         false,
+                                         soc::counter::get(),
+                                         master_stop_timeout))
+    {
+        clear_flag(&(a_p_registers->CR1), I2C_CR1_PE);
+        cml::utils::wait::until(&(a_p_registers->CR1), I2C_CR1_PE, true);
+        set_flag(&(a_p_registers->CR1), I2C_CR1_PE);
+    }
+}
+
+/*
+    Bus recovery (I2C specification 3.1.16): up to 9 SCL pulses with SCL/SDA as open drain outputs
+    until the slave releases SDA, then a STOP condition.
+*/
+constexpr uint32_t bus_recovery_half_period_us = 5;
+constexpr uint32_t bus_recovery_pulses         = 9;
+
+void set_I2C_recovery_pin(GPIO_TypeDef* a_p_port, uint32_t a_id, bool a_output)
+{
+    set_flag(&(a_p_port->MODER), 0x3u << (a_id * 2), (true == a_output ? 0x1u : 0x2u) << (a_id * 2));
+}
+
+void set_I2C_recovery_level(GPIO_TypeDef* a_p_port, uint32_t a_id, bool a_high)
+{
+    a_p_port->BSRR = 0x1u << (true == a_high ? a_id : a_id + 16);
+    soc::stm32l452xx::misc::delay_us(bus_recovery_half_period_us);
+}
+
+bool clock_I2C_bus_free(GPIO_TypeDef* a_p_scl_port, uint32_t a_scl, GPIO_TypeDef* a_p_sda_port, uint32_t a_sda)
+{
+    set_flag(&(a_p_scl_port->OTYPER), 0x1u << a_scl);
+    set_flag(&(a_p_sda_port->OTYPER), 0x1u << a_sda);
+
+    a_p_scl_port->BSRR = 0x1u << a_scl;
+    a_p_sda_port->BSRR = 0x1u << a_sda;
+
+    set_I2C_recovery_pin(a_p_scl_port, a_scl, true);
+    set_I2C_recovery_pin(a_p_sda_port, a_sda, true);
+
+    for (uint32_t i = 0; i < bus_recovery_pulses && false == is_bit(a_p_sda_port->IDR, a_sda); i++)
+    {
+        set_I2C_recovery_level(a_p_scl_port, a_scl, false);
+        set_I2C_recovery_level(a_p_scl_port, a_scl, true);
+    }
+
+    set_I2C_recovery_level(a_p_scl_port, a_scl, false);
+    set_I2C_recovery_level(a_p_sda_port, a_sda, false);
+    set_I2C_recovery_level(a_p_scl_port, a_scl, true);
+    set_I2C_recovery_level(a_p_sda_port, a_sda, true);
+
+    const bool ret = is_bit(a_p_scl_port->IDR, a_scl) && is_bit(a_p_sda_port->IDR, a_sda);
+
+    set_I2C_recovery_pin(a_p_scl_port, a_scl, false);
+    set_I2C_recovery_pin(a_p_sda_port, a_sda, false);
+
+    return ret;
+}
+
+/*
+    DMA request mapping (RM0394, DMA1/DMA2 requests): I2C1-3 on DMA1 (CxS = 3), I2C4 on DMA2 (CxS = 0).
+    DMA channel interrupts are enabled only while a DMA transfer is in progress.
+*/
 Controller controllers[]
 {
-    { I2C1, nullptr, nullptr, i2c_1_enable, i2c_1_disable },
-    { I2C2, nullptr, nullptr, i2c_2_enable, i2c_2_disable },
-    { I2C3, nullptr, nullptr, i2c_3_enable, i2c_3_disable },
-    { I2C4, nullptr, nullptr, i2c_4_enable, i2c_4_disable }
+    { I2C1, nullptr, nullptr, i2c_1_enable, i2c_1_disable, { DMA1, DMA1_Channel6, DMA1_CSELR, 5, 3, DMA1_Channel6_IRQn }, { DMA1, DMA1_Channel7, DMA1_CSELR, 6, 3, DMA1_Channel7_IRQn } },
+    { I2C2, nullptr, nullptr, i2c_2_enable, i2c_2_disable, { DMA1, DMA1_Channel4, DMA1_CSELR, 3, 3, DMA1_Channel4_IRQn }, { DMA1, DMA1_Channel5, DMA1_CSELR, 4, 3, DMA1_Channel5_IRQn } },
+    { I2C3, nullptr, nullptr, i2c_3_enable, i2c_3_disable, { DMA1, DMA1_Channel2, DMA1_CSELR, 1, 3, DMA1_Channel2_IRQn }, { DMA1, DMA1_Channel3, DMA1_CSELR, 2, 3, DMA1_Channel3_IRQn } },
+    { I2C4, nullptr, nullptr, i2c_4_enable, i2c_4_disable, { DMA2, DMA2_Channel2, DMA2_CSELR, 1, 0, DMA2_Channel2_IRQn }, { DMA2, DMA2_Channel1, DMA2_CSELR, 0, 0, DMA2_Channel1_IRQn } }
 };
 
 } // namespace ::
@@ -246,6 +431,87 @@ void I2C4_EV_IRQHandler()
     interupt_handler(3);
 }
 
+void I2C1_ER_IRQHandler()
+{
+    interupt_handler(0);
+}
+
+void I2C2_ER_IRQHandler()
+{
+    interupt_handler(1);
+}
+
+void I2C3_ER_IRQHandler()
+{
+    interupt_handler(2);
+}
+
+void I2C4_ER_IRQHandler()
+{
+    interupt_handler(3);
+}
+
+void dma_interupt_handler(uint32_t a_controller_index, bool a_tx)
+{
+    const DMA_channel& channel = true == a_tx ? controllers[a_controller_index].dma_tx :
+                                                controllers[a_controller_index].dma_rx;
+
+    if (true == is_flag(channel.p_dma->ISR, DMA_ISR_TEIF1 << (channel.index * 4)))
+    {
+        if (nullptr != controllers[a_controller_index].p_i2c_master_handle)
+        {
+            i2c_master_dma_error_interrupt_handler(controllers[a_controller_index].p_i2c_master_handle);
+        }
+        else if (nullptr != controllers[a_controller_index].p_i2c_slave_handle)
+        {
+            i2c_dma_error_interrupt_handler(controllers[a_controller_index].p_i2c_slave_handle);
+        }
+    }
+
+    set_flag(&(channel.p_dma->IFCR), DMA_IFCR_CGIF1 << (channel.index * 4));
+}
+
+// DMA channels can be shared with other peripherals, user code can override these handlers
+__attribute__((weak)) void DMA1_Channel6_IRQHandler()
+{
+    dma_interupt_handler(0, true);
+}
+
+__attribute__((weak)) void DMA1_Channel7_IRQHandler()
+{
+    dma_interupt_handler(0, false);
+}
+
+__attribute__((weak)) void DMA1_Channel4_IRQHandler()
+{
+    dma_interupt_handler(1, true);
+}
+
+__attribute__((weak)) void DMA1_Channel5_IRQHandler()
+{
+    dma_interupt_handler(1, false);
+}
+
+__attribute__((weak)) void DMA1_Channel2_IRQHandler()
+{
+    dma_interupt_handler(2, true);
+}
+
+__attribute__((weak)) void DMA1_Channel3_IRQHandler()
+{
+    dma_interupt_handler(2, false);
+}
+
+__attribute__((weak)) void DMA2_Channel2_IRQHandler()
+{
+    dma_interupt_handler(3, true);
+}
+
+__attribute__((weak)) void DMA2_Channel1_IRQHandler()
+{
+    dma_interupt_handler(3, false);
+}
+
 } // extern "C"
 
 namespace soc {
@@ -300,7 +566,7 @@ void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
         {
             this->tx_callback.function(nullptr, true, this->tx_callback.p_user_data);
 
-            clear_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
+            clear_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 
             this->tx_callback = { nullptr, nullptr };
         }
@@ -309,7 +575,7 @@ void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
         {
             this->rx_callback.function(0, true, this->rx_callback.p_user_data);
 
-            clear_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
+            clear_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 
             this->rx_callback = { nullptr, nullptr };
         }
@@ -318,15 +584,164 @@ void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
     }
 }
 
+void I2C_base::tcr_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
+{
+    if (true == is_flag(a_isr, I2C_ISR_TCR) && true == is_flag(a_cr1, I2C_CR1_TCIE))
+    {
+        I2C_CR2::reload_NBYTES(this->p_i2c, &(this->bytes_to_reload));
+    }
+}
+
+void I2C_base::dma_transfer_start(const void* a_p_data,
+                                  uint32_t a_data_size_in_bytes,
+                                  const Transfer_callback& a_callback,
+                                  bool a_tx)
+{
+    const Controller& controller = controllers[static_cast<uint32_t>(this->id)];
+
+    this->dma_transfer    = { a_callback, Bus_status_flag::ok, a_data_size_in_bytes, a_tx };
+    this->bytes_to_reload = a_data_size_in_bytes;
+
+    if (true == a_tx)
+    {
+        dma_channel_enable(controller.dma_tx, &(this->p_i2c->TXDR), a_p_data, a_data_size_in_bytes, true);
+        set_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN);
+    }
+    else
+    {
+        dma_channel_enable(controller.dma_rx, &(this->p_i2c->RXDR), a_p_data, a_data_size_in_bytes, false);
+        set_flag(&(this->p_i2c->CR1), I2C_CR1_RXDMAEN);
+    }
+
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_NACKIE | I2C_CR1_ERRIE);
+}
+
+void I2C_base::dma_transfer_interrupt_handler(uint32_t a_isr)
+{
+    const bool slave_tx = nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle &&
+                          true == this->dma_transfer.tx;
+
+    if (true == is_I2C_ISR_error(a_isr))
+    {
+        if (false == slave_tx || I2C_ISR_NACKF != get_flag(a_isr, I2C_ISR_TIMEOUT |
+                                                                  I2C_ISR_PECERR  |
+                                                                  I2C_ISR_OVR     |
+                                                                  I2C_ISR_ARLO    |
+                                                                  I2C_ISR_BERR    |
+                                                                  I2C_ISR_NACKF))
+        {
+            this->dma_transfer.bus_status |= get_bus_status_flag_from_I2C_ISR(a_isr);
+        }
+
+        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TCR))
+    {
+        I2C_CR2::reload_NBYTES(this->p_i2c, &(this->bytes_to_reload));
+    }
+
+    if (true == is_any_bit(a_isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR) ||
+        true == is_flag(a_isr, I2C_ISR_STOPF))
+    {
+        this->dma_transfer_end(this->dma_transfer.bus_status);
+    }
+}
+
+void I2C_base::dma_transfer_end(Bus_status_flag a_bus_status)
+{
+    const Controller& controller = controllers[static_cast<uint32_t>(this->id)];
+    const DMA_transfer transfer  = this->dma_transfer;
+
+    const uint32_t data_length = transfer.data_size_in_bytes -
+                                 dma_channel_disable(true == transfer.tx ? controller.dma_tx : controller.dma_rx);
+
+    const bool alert = nullptr != controller.p_i2c_master_handle &&
+                       true == controller.p_i2c_master_handle->is_alert_callback_registered();
+
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN |
+                                    I2C_CR1_RXDMAEN |
+                                    I2C_CR1_TCIE    |
+                                    I2C_CR1_STOPIE  |
+                                    (false == alert ? I2C_CR1_ERRIE : 0) |
+                                    (nullptr == this->bus_status_callback.function ? I2C_CR1_NACKIE | I2C_CR1_ADDRIE : 0));
+
+    set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+    flush_I2C_RXDR(this->p_i2c);
+
+    if (nullptr != controller.p_i2c_master_handle)
+    {
+        this->p_i2c->CR2 = 0;
+    }
+    else if (true == transfer.tx)
+    {
+        set_flag(&(this->p_i2c->ISR), I2C_ISR_TXE);
+    }
+
+    this->dma_transfer = DMA_transfer();
+
+    if (Bus_status_flag::ok == a_bus_status)
+    {
+        transfer.callback.complete(data_length, transfer.callback.p_user_data);
+    }
+    else if (nullptr != transfer.callback.error)
+    {
+        transfer.callback.error(a_bus_status, data_length, transfer.callback.p_user_data);
+    }
+}
+
+void i2c_dma_error_interrupt_handler(I2C_base* a_p_this)
+{
+    if (true == a_p_this->is_dma_transfer_active())
+    {
+        a_p_this->dma_transfer_end(a_p_this->dma_transfer.bus_status | I2C_base::Bus_status_flag::buffer_error);
+    }
+}
+
+void i2c_master_dma_error_interrupt_handler(I2C_master* a_p_this)
+{
+    if (true == a_p_this->is_write_read_active())
+    {
+        a_p_this->write_read.bus_status |= I2C_base::Bus_status_flag::buffer_error;
+        a_p_this->write_read_end();
+    }
+    else
+    {
+        i2c_dma_error_interrupt_handler(a_p_this);
+    }
+}
+
 void i2c_master_interrupt_handler(I2C_master* a_p_this)
 {
     const uint32_t isr = a_p_this->p_i2c->ISR;
     const uint32_t cr1 = a_p_this->p_i2c->CR1;
 
-    a_p_this->bus_status_interrupt_handler(isr);
-    a_p_this->rxne_interrupt_handler(isr, cr1);
-    a_p_this->txe_interrupt_handler(isr, cr1);
-    a_p_this->stopf_interrupt_handler(isr, cr1);
+    if (true == is_flag(isr, I2C_ISR_ALERT))
+    {
+        set_flag(&(a_p_this->p_i2c->ICR), I2C_ICR_ALERTCF);
+
+        if (nullptr != a_p_this->alert_callback.function)
+        {
+            a_p_this->alert_callback.function(a_p_this->alert_callback.p_user_data);
+        }
+    }
+
+    if (true == a_p_this->is_write_read_active())
+    {
+        a_p_this->write_read_interrupt_handler(isr);
+    }
+    else if (true == a_p_this->is_dma_transfer_active())
+    {
+        a_p_this->dma_transfer_interrupt_handler(isr);
+    }
+    else
+    {
+        a_p_this->bus_status_interrupt_handler(isr);
+        a_p_this->rxne_interrupt_handler(isr, cr1);
+        a_p_this->txe_interrupt_handler(isr, cr1);
+        a_p_this->tcr_interrupt_handler(isr, cr1);
+        a_p_this->stopf_interrupt_handler(isr, cr1);
+    }
 }
 
 void i2c_slave_interrupt_handler(I2C_slave* a_p_this)
@@ -334,22 +749,38 @@ void i2c_slave_interrupt_handler(I2C_slave* a_p_this)
     const uint32_t isr = a_p_this->p_i2c->ISR;
     const uint32_t cr1 = a_p_this->p_i2c->CR1;
 
-    if (true == is_flag(isr, I2C_ISR_NACKF) &&
-        nullptr != a_p_this->tx_callback.function)
+    if (true == a_p_this->is_dma_transfer_active())
     {
-        set_flag(&(a_p_this->p_i2c->ICR), I2C_ICR_NACKCF);
+        a_p_this->dma_transfer_interrupt_handler(isr);
     }
-    else
+    else if (true == a_p_this->is_event_callback_registered())
     {
-        a_p_this->bus_status_interrupt_handler(isr);
+        a_p_this->event_interrupt_handler(isr);
     }
+    else
+    {
+        if (true == is_flag(isr, I2C_ISR_NACKF) &&
+            nullptr != a_p_this->tx_callback.function)
+        {
+            set_flag(&(a_p_this->p_i2c->ICR), I2C_ICR_NACKCF);
+        }
+        else
+        {
+            a_p_this->bus_status_interrupt_handler(isr);
+        }
 
-    a_p_this->rxne_interrupt_handler(isr, cr1);
-    a_p_this->txe_interrupt_handler(isr, cr1);
-    a_p_this->stopf_interrupt_handler(isr, cr1);
+        a_p_this->rxne_interrupt_handler(isr, cr1);
+        a_p_this->txe_interrupt_handler(isr, cr1);
+        a_p_this->stopf_interrupt_handler(isr, cr1);
+    }
 
     if (true == is_flag(isr, I2C_ISR_ADDR) && true == is_flag(cr1, I2C_CR1_ADDRIE))
     {
+        if (true == a_p_this->is_dma_transfer_active())
+        {
+            set_I2C_slave_CR2_PECBYTE(a_p_this->p_i2c, a_p_this->dma_transfer.data_size_in_bytes);
+        }
+
         set_flag(&(a_p_this->p_i2c->ICR), I2C_ICR_ADDRCF);
     }
 }
@@ -364,6 +795,7 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
     assert(false   == this->is_enabled());
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(a_config.digital_filter <= 0xF);
 
     controllers[static_cast<uint32_t>(this->id)].enable(get_RCC_CCIPR_from_clock_source(a_clock_source, this->id),
                                                                                       a_irq_priority);
@@ -374,8 +806,10 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
     this->p_i2c->CR1     = 0;
     this->p_i2c->TIMINGR = a_config.timings;
 
-    this->p_i2c->CR1 = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
-                       (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)      |
+    this->p_i2c->CR1 = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0)              |
+                       (a_config.digital_filter << I2C_CR1_DNF_Pos)                           |
+                       (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)                      |
+                       (true == a_config.smbus_alert ? I2C_CR1_SMBHEN | I2C_CR1_ALERTEN : 0) |
                        I2C_CR1_PE;
 
     if (true == a_config.fast_plus)
@@ -411,12 +845,13 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = (static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos) & I2C_CR2_NBYTES_Msk ;
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
 
-    this->p_i2c->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND;
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND;
 
     uint32_t words = 0;
     bool error = false;
@@ -429,6 +864,11 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
             this->p_i2c->TXDR = static_cast<const uint8_t*>(a_p_data)[words++];
         }
 
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
+        }
+
         error = is_I2C_ISR_error(this->p_i2c->ISR);
     }
 
@@ -452,15 +892,16 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
 
-    this->p_i2c->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND;
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND;
 
     uint32_t words = 0;
     bool error = false;
@@ -475,6 +916,11 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
             this->p_i2c->TXDR = static_cast<const uint8_t*>(a_p_data)[words++];
         }
 
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
+        }
+
         error = is_I2C_ISR_error(this->p_i2c->ISR);
     }
 
@@ -483,6 +929,10 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
         bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
         clear_I2C_ISR_errors(&(this->p_i2c->ICR));
     }
+    else if (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF))
+    {
+        bus_status = Bus_status_flag::timeout;
+    }
 
     set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
     this->p_i2c->CR2 = 0;
@@ -497,12 +947,13 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
 
-    this->p_i2c->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
 
     uint32_t words = 0;
     bool error = false;
@@ -510,9 +961,19 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
 
     while (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF) && false == error)
     {
-        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE) && words < a_data_size_in_bytes)
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE))
+        {
+            const uint8_t rxdr = static_cast<uint8_t>(this->p_i2c->RXDR);
+
+            if (words < a_data_size_in_bytes)
+            {
+                static_cast<uint8_t*>(a_p_data)[words++] = rxdr;
+            }
+        }
+
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
         {
-            static_cast<uint8_t*>(a_p_data)[words++] = static_cast<uint8_t>(this->p_i2c->RXDR);
+            I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
         }
 
         error = is_I2C_ISR_error(this->p_i2c->ISR);
@@ -538,15 +999,16 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
 
     const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
 
-    this->p_i2c->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+    uint32_t bytes_to_reload = a_data_size_in_bytes;
+
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
 
     uint32_t words = 0;
     bool error = false;
@@ -556,9 +1018,19 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
            false == error &&
            a_timeout >= time::diff(counter::get(), start))
     {
-        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE) && words < a_data_size_in_bytes)
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE))
+        {
+            const uint8_t rxdr = static_cast<uint8_t>(this->p_i2c->RXDR);
+
+            if (words < a_data_size_in_bytes)
+            {
+                static_cast<uint8_t*>(a_p_data)[words++] = rxdr;
+            }
+        }
+
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
         {
-            static_cast<uint8_t*>(a_p_data)[words++] = static_cast<uint8_t>(this->p_i2c->RXDR);
+            I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
         }
 
         error = is_I2C_ISR_error(this->p_i2c->ISR);
@@ -569,6 +1041,10 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
         bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
         clear_I2C_ISR_errors(&(this->p_i2c->ICR));
     }
+    else if (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF))
+    {
+        bus_status = Bus_status_flag::timeout;
+    }
 
     set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
     this->p_i2c->CR2 = 0;
@@ -583,16 +1059,16 @@ void I2C_master::register_transmit_callback(uint16_t a_slave_address,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->rx_callback = { nullptr, nullptr };
     this->tx_callback = a_callback;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    this->p_i2c->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND;
-    set_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE);
+    this->bytes_to_reload = a_data_size_in_bytes;
+    this->p_i2c->CR2      = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &(this->bytes_to_reload)) | I2C_CR2_START | I2C_CR2_AUTOEND;
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE);
 }
 
 void I2C_master::register_receive_callback(uint16_t a_slave_address,
@@ -602,36 +1078,456 @@ void I2C_master::register_receive_callback(uint16_t a_slave_address,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->tx_callback = { nullptr, nullptr };
     this->rx_callback = a_callback;
 
-    const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
-    const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    this->p_i2c->CR2 = address_mask | data_size_mask | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
-    set_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE);
+    this->bytes_to_reload = a_data_size_in_bytes;
+    this->p_i2c->CR2      = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &(this->bytes_to_reload)) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_TCIE | I2C_CR1_STOPIE);
 }
 
-void I2C_master::register_bus_status_callback(const Bus_status_callback& a_callback)
+void I2C_master::transmit_dma(uint16_t a_slave_address,
+                              const void* a_p_data,
+                              uint32_t a_data_size_in_bytes,
+                              const Transfer_callback& a_callback)
 {
     assert(nullptr != this->p_i2c);
-    assert(nullptr != a_callback.function);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr != a_p_data);
+    assert(nullptr != a_callback.complete);
+    assert(false == this->is_dma_transfer_active());
+    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 0xFFFF);
 
-    this->bus_status_callback = a_callback;
-    set_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE);
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    this->dma_transfer_start(a_p_data, a_data_size_in_bytes, a_callback, true);
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &(this->bytes_to_reload)) | I2C_CR2_START | I2C_CR2_AUTOEND;
 }
 
-void I2C_master::unregister_bus_status_callback()
+void I2C_master::receive_dma(uint16_t a_slave_address,
+                             void* a_p_data,
+                             uint32_t a_data_size_in_bytes,
+                             const Transfer_callback& a_callback)
 {
     assert(nullptr != this->p_i2c);
-
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr != a_p_data);
+    assert(nullptr != a_callback.complete);
+    assert(false == this->is_dma_transfer_active());
+    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 0xFFFF);
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    this->dma_transfer_start(a_p_data, a_data_size_in_bytes, a_callback, false);
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &(this->bytes_to_reload)) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+}
+
+I2C_master::Result I2C_master::write_read_polling(uint16_t a_slave_address,
+                                                  const void* a_p_tx_data,
+                                                  uint32_t a_tx_data_size_in_bytes,
+                                                  void* a_p_rx_data,
+                                                  uint32_t a_rx_data_size_in_bytes)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr != a_p_tx_data);
+    assert(nullptr != a_p_rx_data);
+    assert(a_tx_data_size_in_bytes > 0);
+    assert(a_rx_data_size_in_bytes > 0);
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    uint32_t bytes_to_reload = a_tx_data_size_in_bytes;
+
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES(&bytes_to_reload) | I2C_CR2_START;
+
+    uint32_t tx_words = 0;
+    uint32_t rx_words = 0;
+    bool error = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
+
+    while (false == is_flag(this->p_i2c->ISR, I2C_ISR_TC) && false == error)
+    {
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TXE) && tx_words < a_tx_data_size_in_bytes)
+        {
+            this->p_i2c->TXDR = static_cast<const uint8_t*>(a_p_tx_data)[tx_words++];
+        }
+
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
+        }
+
+        error = is_I2C_ISR_error(this->p_i2c->ISR);
+    }
+
+    if (false == error)
+    {
+        bytes_to_reload  = a_rx_data_size_in_bytes;
+        this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+
+        while (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF) && false == error)
+        {
+            if (true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE))
+            {
+                const uint8_t rxdr = static_cast<uint8_t>(this->p_i2c->RXDR);
+
+                if (rx_words < a_rx_data_size_in_bytes)
+                {
+                    static_cast<uint8_t*>(a_p_rx_data)[rx_words++] = rxdr;
+                }
+            }
+
+            if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
+            {
+                I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
+            }
+
+            error = is_I2C_ISR_error(this->p_i2c->ISR);
+        }
+    }
+
+    if (true == error)
+    {
+        bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
+        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    }
+
+    set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+    this->p_i2c->CR2 = 0;
+
+    return { bus_status, tx_words + rx_words };
+}
+
+I2C_master::Result I2C_master::write_read_polling(uint16_t a_slave_address,
+                                                  const void* a_p_tx_data,
+                                                  uint32_t a_tx_data_size_in_bytes,
+                                                  void* a_p_rx_data,
+                                                  uint32_t a_rx_data_size_in_bytes,
+                                                  time::tick a_timeout)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr != a_p_tx_data);
+    assert(nullptr != a_p_rx_data);
+    assert(a_tx_data_size_in_bytes > 0);
+    assert(a_rx_data_size_in_bytes > 0);
+    assert(a_timeout > 0);
+
+    time::tick start = counter::get();
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    uint32_t bytes_to_reload = a_tx_data_size_in_bytes;
+
+    this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES(&bytes_to_reload) | I2C_CR2_START;
+
+    uint32_t tx_words = 0;
+    uint32_t rx_words = 0;
+    bool error = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
+
+    while (false == is_flag(this->p_i2c->ISR, I2C_ISR_TC) &&
+           false == error &&
+           a_timeout >= time::diff(counter::get(), start))
+    {
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TXE) && tx_words < a_tx_data_size_in_bytes)
+        {
+            this->p_i2c->TXDR = static_cast<const uint8_t*>(a_p_tx_data)[tx_words++];
+        }
+
+        if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
+        {
+            I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
+        }
+
+        error = is_I2C_ISR_error(this->p_i2c->ISR);
+    }
+
+    if (false == error && true == is_flag(this->p_i2c->ISR, I2C_ISR_TC))
+    {
+        bytes_to_reload  = a_rx_data_size_in_bytes;
+        this->p_i2c->CR2 = address_mask | I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &bytes_to_reload) | I2C_CR2_START | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
+
+        while (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF) &&
+               false == error &&
+               a_timeout >= time::diff(counter::get(), start))
+        {
+            if (true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE))
+            {
+                const uint8_t rxdr = static_cast<uint8_t>(this->p_i2c->RXDR);
+
+                if (rx_words < a_rx_data_size_in_bytes)
+                {
+                    static_cast<uint8_t*>(a_p_rx_data)[rx_words++] = rxdr;
+                }
+            }
+
+            if (true == is_flag(this->p_i2c->ISR, I2C_ISR_TCR))
+            {
+                I2C_CR2::reload_NBYTES(this->p_i2c, &bytes_to_reload);
+            }
+
+            error = is_I2C_ISR_error(this->p_i2c->ISR);
+        }
+    }
+
+    if (true == error)
+    {
+        bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
+        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    }
+    else if (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF))
+    {
+        bus_status = Bus_status_flag::timeout;
+        abort_I2C_master_transfer(this->p_i2c);
+    }
+
+    set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+    this->p_i2c->CR2 = 0;
+
+    return { bus_status, tx_words + rx_words };
+}
+
+void I2C_master::write_read_it(uint16_t a_slave_address,
+                               const void* a_p_tx_data,
+                               uint32_t a_tx_data_size_in_bytes,
+                               void* a_p_rx_data,
+                               uint32_t a_rx_data_size_in_bytes,
+                               const Transfer_callback& a_callback)
+{
+    this->write_read_start(a_slave_address,
+                           a_p_tx_data,
+                           a_tx_data_size_in_bytes,
+                           a_p_rx_data,
+                           a_rx_data_size_in_bytes,
+                           a_callback,
+                           false);
+}
+
+void I2C_master::write_read_dma(uint16_t a_slave_address,
+                                const void* a_p_tx_data,
+                                uint32_t a_tx_data_size_in_bytes,
+                                void* a_p_rx_data,
+                                uint32_t a_rx_data_size_in_bytes,
+                                const Transfer_callback& a_callback)
+{
+    this->write_read_start(a_slave_address,
+                           a_p_tx_data,
+                           a_tx_data_size_in_bytes,
+                           a_p_rx_data,
+                           a_rx_data_size_in_bytes,
+                           a_callback,
+                           true);
+}
+
+void I2C_master::write_read_start(uint16_t a_slave_address,
+                                  const void* a_p_tx_data,
+                                  uint32_t a_tx_data_size_in_bytes,
+                                  void* a_p_rx_data,
+                                  uint32_t a_rx_data_size_in_bytes,
+                                  const Transfer_callback& a_callback,
+                                  bool a_dma)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr != a_p_tx_data);
+    assert(nullptr != a_p_rx_data);
+    assert(nullptr != a_callback.complete);
+    assert(false == this->is_write_read_active());
+    assert(false == this->is_dma_transfer_active());
+    assert(a_tx_data_size_in_bytes > 0 && (false == a_dma || a_tx_data_size_in_bytes <= 0xFFFF));
+    assert(a_rx_data_size_in_bytes > 0 && (false == a_dma || a_rx_data_size_in_bytes <= 0xFFFF));
+
+    this->write_read.p_tx_data             = static_cast<const uint8_t*>(a_p_tx_data);
+    this->write_read.p_rx_data             = static_cast<uint8_t*>(a_p_rx_data);
+    this->write_read.tx_data_size_in_bytes = a_tx_data_size_in_bytes;
+    this->write_read.rx_data_size_in_bytes = a_rx_data_size_in_bytes;
+    this->write_read.tx_words              = 0;
+    this->write_read.rx_words              = 0;
+    this->write_read.address_mask          = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+    this->write_read.bus_status            = Bus_status_flag::ok;
+    this->write_read.dma                   = a_dma;
+    this->write_read.callback              = a_callback;
+
+    if (true == a_dma)
+    {
+        dma_channel_enable(controllers[static_cast<uint32_t>(this->id)].dma_tx,
+                           &(this->p_i2c->TXDR),
+                           a_p_tx_data,
+                           a_tx_data_size_in_bytes,
+                           true);
+
+        set_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN | I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_NACKIE | I2C_CR1_ERRIE);
+    }
+    else
+    {
+        set_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE   |
+                                      I2C_CR1_RXIE   |
+                                      I2C_CR1_TCIE   |
+                                      I2C_CR1_STOPIE |
+                                      I2C_CR1_NACKIE |
+                                      I2C_CR1_ERRIE);
+    }
+
+    this->bytes_to_reload = a_tx_data_size_in_bytes;
+    this->p_i2c->CR2      = this->write_read.address_mask | I2C_CR2::get_NBYTES(&(this->bytes_to_reload)) | I2C_CR2_START;
+}
+
+void I2C_master::write_read_interrupt_handler(uint32_t a_isr)
+{
+    if (true == is_I2C_ISR_error(a_isr))
+    {
+        this->write_read.bus_status |= get_bus_status_flag_from_I2C_ISR(a_isr);
+        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    }
+
+    if (false == this->write_read.dma)
+    {
+        if (true == is_flag(a_isr, I2C_ISR_TXIS) &&
+            this->write_read.tx_words < this->write_read.tx_data_size_in_bytes)
+        {
+            this->p_i2c->TXDR = this->write_read.p_tx_data[this->write_read.tx_words++];
+        }
+
+        if (true == is_flag(a_isr, I2C_ISR_RXNE))
+        {
+            const uint8_t rxdr = static_cast<uint8_t>(this->p_i2c->RXDR);
+
+            if (this->write_read.rx_words < this->write_read.rx_data_size_in_bytes)
+            {
+                this->write_read.p_rx_data[this->write_read.rx_words++] = rxdr;
+            }
+        }
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TCR))
+    {
+        I2C_CR2::reload_NBYTES(this->p_i2c, &(this->bytes_to_reload));
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TC))
+    {
+        if (true == this->write_read.dma)
+        {
+            const Controller& controller = controllers[static_cast<uint32_t>(this->id)];
+
+            this->write_read.tx_words = this->write_read.tx_data_size_in_bytes - dma_channel_disable(controller.dma_tx);
+
+            dma_channel_enable(controller.dma_rx,
+                               &(this->p_i2c->RXDR),
+                               this->write_read.p_rx_data,
+                               this->write_read.rx_data_size_in_bytes,
+                               false);
+
+            set_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN, I2C_CR1_RXDMAEN);
+        }
+
+        this->bytes_to_reload = this->write_read.rx_data_size_in_bytes;
+        this->p_i2c->CR2      = this->write_read.address_mask                                  |
+                                I2C_CR2::get_NBYTES_PECBYTE(this->p_i2c, &(this->bytes_to_reload)) |
+                                I2C_CR2_START                                                  |
+                                I2C_CR2_AUTOEND                                                |
+                                I2C_CR2_RD_WRN;
+    }
+
+    if (true == is_any_bit(a_isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR) ||
+        true == is_flag(a_isr, I2C_ISR_STOPF))
+    {
+        this->write_read_end();
+    }
+}
+
+void I2C_master::write_read_end()
+{
+    const Write_read transfer = this->write_read;
+
+    if (true == transfer.dma)
+    {
+        const Controller& controller = controllers[static_cast<uint32_t>(this->id)];
+
+        if (true == is_flag(this->p_i2c->CR1, I2C_CR1_RXDMAEN))
+        {
+            dma_channel_disable(controller.dma_tx);
+            this->write_read.rx_words = transfer.rx_data_size_in_bytes - dma_channel_disable(controller.dma_rx);
+        }
+        else
+        {
+            this->write_read.tx_words = transfer.tx_data_size_in_bytes - dma_channel_disable(controller.dma_tx);
+        }
+    }
+
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN |
+                                    I2C_CR1_RXDMAEN |
+                                    I2C_CR1_TXIE    |
+                                    I2C_CR1_RXIE    |
+                                    I2C_CR1_TCIE    |
+                                    I2C_CR1_STOPIE  |
+                                    (false == this->is_alert_callback_registered() ? I2C_CR1_ERRIE : 0) |
+                                    (nullptr == this->bus_status_callback.function ? I2C_CR1_NACKIE : 0));
+
+    set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+    flush_I2C_RXDR(this->p_i2c);
+    this->p_i2c->CR2 = 0;
+
+    const uint32_t data_length = this->write_read.tx_words + this->write_read.rx_words;
+
+    this->write_read = Write_read();
+
+    if (Bus_status_flag::ok == transfer.bus_status)
+    {
+        transfer.callback.complete(data_length, transfer.callback.p_user_data);
+    }
+    else if (nullptr != transfer.callback.error)
+    {
+        transfer.callback.error(transfer.bus_status, data_length, transfer.callback.p_user_data);
+    }
+}
+
+void I2C_master::register_bus_status_callback(const Bus_status_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != a_callback.function);
+
+    this->bus_status_callback = a_callback;
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE);
+}
+
+void I2C_master::unregister_bus_status_callback()
+{
+    assert(nullptr != this->p_i2c);
+
     clear_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE);
 
     this->bus_status_callback = { nullptr, nullptr };
 }
 
+void I2C_master::register_alert_callback(const Alert_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != a_callback.function);
+    assert(true == is_flag(this->p_i2c->CR1, I2C_CR1_SMBHEN | I2C_CR1_ALERTEN));
+
+    this->alert_callback = a_callback;
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_ERRIE);
+}
+
+void I2C_master::unregister_alert_callback()
+{
+    assert(nullptr != this->p_i2c);
+
+    if (false == this->is_dma_transfer_active() && false == this->is_write_read_active())
+    {
+        clear_flag(&(this->p_i2c->CR1), I2C_CR1_ERRIE);
+    }
+
+    this->alert_callback = { nullptr, nullptr };
+}
+
 bool I2C_master::is_slave_connected(uint16_t a_slave_address, time::tick a_timeout) const
 {
     assert(nullptr != this->p_i2c);
@@ -660,12 +1556,38 @@ bool I2C_master::is_slave_connected(uint16_t a_slave_address, time::tick a_timeo
     return ret;
 }
 
+bool I2C_master::recover_bus(pin::Af* a_p_scl, pin::Af* a_p_sda)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != a_p_scl);
+    assert(nullptr != a_p_sda);
+    assert(false == this->is_dma_transfer_active() && false == this->is_write_read_active());
+
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_PE);
+
+    const bool ret = clock_I2C_bus_free(static_cast<GPIO_TypeDef*>(*(a_p_scl->get_port())),
+                                        a_p_scl->get_id(),
+                                        static_cast<GPIO_TypeDef*>(*(a_p_sda->get_port())),
+                                        a_p_sda->get_id());
+
+    clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+
+    this->p_i2c->CR2 = 0;
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_PE);
+
+    return ret;
+}
+
 void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
 {
     assert(false   == this->is_enabled());
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(a_config.digital_filter <= 0xF);
     assert(a_config.address <= 0x7F);
+    assert(a_config.address_2 <= 0x7F);
+    assert(a_config.address_2_mask <= 7);
 
     controllers[static_cast<uint32_t>(this->id)].enable(get_RCC_CCIPR_from_clock_source(a_clock_source, this->id),
                                                       a_irq_priority);
@@ -677,8 +1599,19 @@ void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint
     this->p_i2c->TIMINGR = a_config.timings;
 
     this->p_i2c->OAR1 = I2C_OAR1_OA1EN | (a_config.address << 1);
+
+    if (true == a_config.address_2_enable)
+    {
+        this->p_i2c->OAR2 = I2C_OAR2_OA2EN | (a_config.address_2_mask << I2C_OAR2_OA2MSK_Pos) | (a_config.address_2 << 1);
+    }
+    else
+    {
+        this->p_i2c->OAR2 = 0;
+    }
+
     this->p_i2c->CR1  = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
-                        (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)|
+                        (a_config.digital_filter << I2C_CR1_DNF_Pos)              |
+                        (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)      |
                         I2C_CR1_PE;
 
     if (true == a_config.fast_plus)
@@ -712,7 +1645,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data, uint32
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     constexpr uint32_t error_mask = I2C_ISR_TIMEOUT | I2C_ISR_PECERR | I2C_ISR_OVR | I2C_ISR_ARLO | I2C_ISR_BERR;
 
@@ -725,6 +1658,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data, uint32
     {
         if (true == is_flag(this->p_i2c->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(this->p_i2c, a_data_size_in_bytes);
             set_flag(&(this->p_i2c->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -760,7 +1694,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data,
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
@@ -777,6 +1711,7 @@ I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data,
     {
         if (true == is_flag(this->p_i2c->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(this->p_i2c, a_data_size_in_bytes);
             set_flag(&(this->p_i2c->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -810,7 +1745,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     uint32_t words = 0;
     bool error = false;
@@ -821,6 +1756,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
     {
         if (true == is_flag(this->p_i2c->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(this->p_i2c, a_data_size_in_bytes);
             set_flag(&(this->p_i2c->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -853,7 +1789,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
     assert(nullptr != a_p_data);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
     assert(a_timeout > 0);
 
     time::tick start = counter::get();
@@ -868,6 +1804,7 @@ I2C_slave::Result I2C_slave::receive_bytes_polling(void* a_p_data, uint32_t a_da
     {
         if (true == is_flag(this->p_i2c->ISR, I2C_ISR_ADDR))
         {
+            set_I2C_slave_CR2_PECBYTE(this->p_i2c, a_data_size_in_bytes);
             set_flag(&(this->p_i2c->ICR), I2C_ICR_ADDRCF);
         }
 
@@ -900,11 +1837,12 @@ void I2C_slave::register_transmit_callback(const TX_callback& a_callback, uint32
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->rx_callback = { nullptr, nullptr };
     this->tx_callback = a_callback;
 
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_SBC);
     set_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE | I2C_CR1_NACKIE);
 }
 
@@ -913,14 +1851,41 @@ void I2C_slave::register_receive_callback(const RX_callback& a_callback, uint32_
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
     assert(nullptr != a_callback.function);
-    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
+    assert(a_data_size_in_bytes > 0);
 
     this->tx_callback = { nullptr, nullptr };
     this->rx_callback = a_callback;
 
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_SBC);
     set_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 }
 
+void I2C_slave::transmit_dma(const void* a_p_data, uint32_t a_data_size_in_bytes, const Transfer_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(nullptr != a_p_data);
+    assert(nullptr != a_callback.complete);
+    assert(false == this->is_dma_transfer_active());
+    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 0xFFFF);
+
+    this->dma_transfer_start(a_p_data, a_data_size_in_bytes, a_callback, true);
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_ADDRIE);
+}
+
+void I2C_slave::receive_dma(void* a_p_data, uint32_t a_data_size_in_bytes, const Transfer_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(nullptr != a_p_data);
+    assert(nullptr != a_callback.complete);
+    assert(false == this->is_dma_transfer_active());
+    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 0xFFFF);
+
+    this->dma_transfer_start(a_p_data, a_data_size_in_bytes, a_callback, false);
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_ADDRIE);
+}
+
 void I2C_slave::register_bus_status_callback(const Bus_status_callback& a_callback)
 {
     assert(nullptr != this->p_i2c);
@@ -939,6 +1904,112 @@ void I2C_slave::unregister_bus_status_callback()
     this->bus_status_callback = { nullptr, nullptr };
 }
 
+void I2C_slave::register_event_callback(const Event_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != a_callback.address);
+    assert(nullptr != a_callback.receive);
+    assert(nullptr != a_callback.transmit);
+    assert(nullptr != a_callback.stop);
+    assert(false == this->is_dma_transfer_active());
+
+    this->event_callback = a_callback;
+    this->pec            = 0;
+    this->pec_restart    = true;
+
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_SBC);
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_ADDRIE |
+                                  I2C_CR1_RXIE   |
+                                  I2C_CR1_TXIE   |
+                                  I2C_CR1_STOPIE |
+                                  I2C_CR1_NACKIE |
+                                  I2C_CR1_ERRIE);
+}
+
+void I2C_slave::unregister_event_callback()
+{
+    assert(nullptr != this->p_i2c);
+
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE   |
+                                    I2C_CR1_TXIE   |
+                                    I2C_CR1_STOPIE |
+                                    I2C_CR1_ERRIE  |
+                                    (nullptr == this->bus_status_callback.function ? I2C_CR1_NACKIE | I2C_CR1_ADDRIE : 0));
+
+    this->event_callback = Event_callback();
+}
+
+void I2C_slave::event_interrupt_handler(uint32_t a_isr)
+{
+    if (true == is_any_bit(a_isr, I2C_ISR_OVR | I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_TIMEOUT | I2C_ISR_PECERR))
+    {
+        this->bus_status_interrupt_handler(a_isr);
+    }
+
+    if (true == is_I2C_ISR_error(a_isr))
+    {
+        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    }
+
+    const bool pec_enabled = is_flag(this->p_i2c->CR1, I2C_CR1_PECEN);
+
+    if (true == is_flag(a_isr, I2C_ISR_RXNE))
+    {
+        const uint8_t data = static_cast<uint8_t>(this->p_i2c->RXDR);
+
+        if (true == pec_enabled)
+        {
+            this->pec = utils::SMBus_PEC::update(this->pec, data);
+        }
+
+        this->event_callback.receive(data, this->event_callback.p_user_data);
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_ADDR))
+    {
+        const bool read        = is_flag(a_isr, I2C_ISR_DIR);
+        const uint16_t address = static_cast<uint16_t>(get_flag(a_isr, I2C_ISR_ADDCODE) >> I2C_ISR_ADDCODE_Pos);
+
+        if (true == read)
+        {
+            set_flag(&(this->p_i2c->ISR), I2C_ISR_TXE);
+        }
+
+        if (true == pec_enabled)
+        {
+            this->pec         = utils::SMBus_PEC::update(true == this->pec_restart ? 0 : this->pec,
+                                                         utils::SMBus_PEC::get_address_byte(address, read));
+            this->pec_restart = false;
+        }
+
+        this->event_callback.address(address, read, this->event_callback.p_user_data);
+
+        set_flag(&(this->p_i2c->ICR), I2C_ICR_ADDRCF);
+    }
+    else if (true == is_flag(a_isr, I2C_ISR_TXIS))
+    {
+        const uint8_t data = this->event_callback.transmit(this->event_callback.p_user_data);
+
+        if (true == pec_enabled)
+        {
+            this->pec = utils::SMBus_PEC::update(this->pec, data);
+        }
+
+        this->p_i2c->TXDR = data;
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_STOPF))
+    {
+        const bool tx_discarded = is_flag(a_isr, I2C_ISR_DIR) && false == is_flag(this->p_i2c->ISR, I2C_ISR_TXE);
+
+        set_flag(&(this->p_i2c->ISR), I2C_ISR_TXE);
+        set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+
+        this->event_callback.stop(tx_discarded, this->event_callback.p_user_data);
+        this->pec_restart = true;
+    }
+}
+
 } // namespace peripherals
 } // namespace stm32l452xx
 } // namespace soc
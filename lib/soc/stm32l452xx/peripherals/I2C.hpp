@@ -13,6 +13,9 @@
 //externals
 #include <stm32l4xx.h>
 
+//soc
+#include <soc/stm32l452xx/peripherals/GPIO.hpp>
+
 //cml
 #include <cml/bit.hpp>
 #include <cml/Non_copyable.hpp>
@@ -51,7 +54,8 @@ public:
         arbitration_lost = 0x4,
         misplaced        = 0x8,
         nack             = 0x10,
-        unknown          = 0x20
+        unknown          = 0x20,
+        timeout          = 0x40
     };
 
     struct Result
@@ -84,6 +88,16 @@ public:
         void* p_user_data = nullptr;
     };
 
+    struct Transfer_callback
+    {
+        using Complete_function = void(*)(uint32_t a_data_length, void* a_p_user_data);
+        using Error_function    = void(*)(Bus_status_flag a_bus_status, uint32_t a_data_length, void* a_p_user_data);
+
+        Complete_function complete = nullptr;
+        Error_function error       = nullptr;
+        void* p_user_data          = nullptr;
+    };
+
 public:
 
     Clock_source get_clock_source() const;
@@ -115,26 +129,53 @@ public:
         return this->id;
     }
 
+    bool is_dma_transfer_active() const
+    {
+        return nullptr != this->dma_transfer.callback.complete;
+    }
+
 protected:
 
     I2C_base(Id a_id)
         : id(a_id)
         , p_i2c(nullptr)
+        , bytes_to_reload(0)
     {}
 
     void bus_status_interrupt_handler(uint32_t a_isr);
     void rxne_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
     void txe_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
     void stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
+    void tcr_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
+
+    void dma_transfer_start(const void* a_p_data, uint32_t a_data_size_in_bytes, const Transfer_callback& a_callback, bool a_tx);
+    void dma_transfer_interrupt_handler(uint32_t a_isr);
+    void dma_transfer_end(Bus_status_flag a_bus_status);
 
 protected:
 
+    struct DMA_transfer
+    {
+        Transfer_callback callback;
+        Bus_status_flag bus_status  = Bus_status_flag::ok;
+        uint32_t data_size_in_bytes = 0;
+        bool tx                     = false;
+    };
+
     Id id;
     mutable I2C_TypeDef* p_i2c;
 
+    uint32_t bytes_to_reload;
+
     RX_callback rx_callback;
     TX_callback tx_callback;
     Bus_status_callback bus_status_callback;
+
+    DMA_transfer dma_transfer;
+
+private:
+
+    friend void i2c_dma_error_interrupt_handler(I2C_base* a_p_this);
 };
 
 constexpr I2C_base::Bus_status_flag operator | (I2C_base::Bus_status_flag a_f1, I2C_base::Bus_status_flag a_f2)
@@ -165,15 +206,33 @@ public:
     using TX_callback         = I2C_base::TX_callback;
     using RX_callback         = I2C_base::RX_callback;
     using Bus_status_callback = I2C_base::Bus_status_callback;
+    using Transfer_callback   = I2C_base::Transfer_callback;
 
+    /*
+        crc_enable: SMBus PEC, appended to transmissions and checked on receptions (Bus_status_flag::crc_error),
+                    in receive callbacks the PEC is passed as the last byte
+        smbus_alert: SMBus host, SMBA pin falling edge calls the alert callback
+    */
     struct Config
     {
-        bool analog_filter  = false;
-        bool fast_plus      = false;
-        bool crc_enable     = false;
-        uint32_t timings    = 0;
+        bool analog_filter      = false;
+        bool fast_plus          = false;
+        bool crc_enable         = false;
+        uint32_t timings        = 0;
+        uint32_t digital_filter = 0;
+        bool smbus_alert        = false;
     };
 
+    struct Alert_callback
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    static constexpr uint16_t smbus_alert_response_address = 0x0C;
+
 public:
 
     I2C_master(Id a_id)
@@ -240,14 +299,102 @@ public:
                                    const RX_callback& a_callback,
                                    uint32_t a_data_size_in_bytes);
 
+    void transmit_dma(uint16_t a_slave_address,
+                      const void* a_p_data,
+                      uint32_t a_data_size_in_bytes,
+                      const Transfer_callback& a_callback);
+
+    void receive_dma(uint16_t a_slave_address,
+                     void* a_p_data,
+                     uint32_t a_data_size_in_bytes,
+                     const Transfer_callback& a_callback);
+
+    Result write_read_polling(uint16_t a_slave_address,
+                              const void* a_p_tx_data,
+                              uint32_t a_tx_data_size_in_bytes,
+                              void* a_p_rx_data,
+                              uint32_t a_rx_data_size_in_bytes);
+
+    // on timeout a STOP is generated, the peripheral is reset when the STOP cannot complete (SCL held low)
+    Result write_read_polling(uint16_t a_slave_address,
+                              const void* a_p_tx_data,
+                              uint32_t a_tx_data_size_in_bytes,
+                              void* a_p_rx_data,
+                              uint32_t a_rx_data_size_in_bytes,
+                              cml::time::tick a_timeout);
+
+    void write_read_it(uint16_t a_slave_address,
+                       const void* a_p_tx_data,
+                       uint32_t a_tx_data_size_in_bytes,
+                       void* a_p_rx_data,
+                       uint32_t a_rx_data_size_in_bytes,
+                       const Transfer_callback& a_callback);
+
+    void write_read_dma(uint16_t a_slave_address,
+                        const void* a_p_tx_data,
+                        uint32_t a_tx_data_size_in_bytes,
+                        void* a_p_rx_data,
+                        uint32_t a_rx_data_size_in_bytes,
+                        const Transfer_callback& a_callback);
+
     void register_bus_status_callback(const Bus_status_callback& a_callback);
     void unregister_bus_status_callback();
 
+    void register_alert_callback(const Alert_callback& a_callback);
+    void unregister_alert_callback();
+
     bool is_slave_connected(uint16_t a_slave_address, cml::time::tick a_timeout) const;
 
- private:
+    // resets the peripheral and clocks a stuck bus free, a_p_scl/a_p_sda: pins configured for this I2C
+    bool recover_bus(pin::Af* a_p_scl, pin::Af* a_p_sda);
+
+    bool is_write_read_active() const
+    {
+        return nullptr != this->write_read.callback.complete;
+    }
+
+    bool is_alert_callback_registered() const
+    {
+        return nullptr != this->alert_callback.function;
+    }
+
+private:
+
+    struct Write_read
+    {
+        const uint8_t* p_tx_data = nullptr;
+        uint8_t* p_rx_data       = nullptr;
+
+        uint32_t tx_data_size_in_bytes = 0;
+        uint32_t rx_data_size_in_bytes = 0;
+        uint32_t tx_words              = 0;
+        uint32_t rx_words              = 0;
 
-     friend void i2c_master_interrupt_handler(I2C_master* a_p_this);
+        uint32_t address_mask      = 0;
+        Bus_status_flag bus_status = Bus_status_flag::ok;
+        bool dma                   = false;
+
+        Transfer_callback callback;
+    };
+
+    void write_read_start(uint16_t a_slave_address,
+                          const void* a_p_tx_data,
+                          uint32_t a_tx_data_size_in_bytes,
+                          void* a_p_rx_data,
+                          uint32_t a_rx_data_size_in_bytes,
+                          const Transfer_callback& a_callback,
+                          bool a_dma);
+
+    void write_read_interrupt_handler(uint32_t a_isr);
+    void write_read_end();
+
+private:
+
+    Write_read write_read;
+    Alert_callback alert_callback;
+
+    friend void i2c_master_interrupt_handler(I2C_master* a_p_this);
+    friend void i2c_master_dma_error_interrupt_handler(I2C_master* a_p_this);
 };
 
 class I2C_slave : public I2C_base
@@ -262,20 +409,58 @@ public:
     using TX_callback         = I2C_base::TX_callback;
     using RX_callback         = I2C_base::RX_callback;
     using Bus_status_callback = I2C_base::Bus_status_callback;
+    using Transfer_callback   = I2C_base::Transfer_callback;
 
+    /*
+        crc_enable: SMBus PEC, checked and appended by the polling and DMA transfers of up to 254 bytes
+                    (slave byte control is set for them), computed in software for the event callbacks
+                    (get_pec()), in transmit and receive callbacks it is a data byte
+    */
     struct Config
     {
-        bool analog_filter = false;
-        bool fast_plus     = false;
-        bool crc_enable    = false;
-        uint32_t timings   = 0;
-        uint16_t address   = 0;
+        bool analog_filter      = false;
+        bool fast_plus          = false;
+        bool crc_enable         = false;
+        uint32_t timings        = 0;
+        uint16_t address        = 0;
+        uint32_t digital_filter = 0;
+
+        bool address_2_enable   = false;
+        uint16_t address_2      = 0;
+        uint32_t address_2_mask = 0; // number of ignored LSBs of address_2, 0 - 7
+    };
+
+    /*
+        Byte level slave events, called from the I2C interrupt:
+        address  - address match (a_address is the matched 7-bit address, useful with address_2_mask),
+                   a_read: master reads from the slave
+        receive  - byte written by the master
+        transmit - next byte to be sent to the master
+        stop     - end of transaction, a_tx_discarded: the last byte returned by transmit was not sent
+        With crc_enable get_pec() is the PEC of the transaction so far (address bytes included, repeated start
+        continues it): transmit returns it after the data of a read, in stop it is 0 if the last received byte
+        was a correct PEC.
+    */
+    struct Event_callback
+    {
+        using Address_function  = void(*)(uint16_t a_address, bool a_read, void* a_p_user_data);
+        using Receive_function  = void(*)(uint8_t a_data, void* a_p_user_data);
+        using Transmit_function = uint8_t(*)(void* a_p_user_data);
+        using Stop_function     = void(*)(bool a_tx_discarded, void* a_p_user_data);
+
+        Address_function address   = nullptr;
+        Receive_function receive   = nullptr;
+        Transmit_function transmit = nullptr;
+        Stop_function stop         = nullptr;
+        void* p_user_data          = nullptr;
     };
 
 public:
 
     I2C_slave(Id a_id)
         : I2C_base(a_id)
+        , pec(0)
+        , pec_restart(true)
     {}
 
     ~I2C_slave()
@@ -329,9 +514,52 @@ public:
     void register_receive_callback(const RX_callback& a_callback,
                                    uint32_t a_data_size_in_bytes);
 
+    void transmit_dma(const void* a_p_data, uint32_t a_data_size_in_bytes, const Transfer_callback& a_callback);
+    void receive_dma(void* a_p_data, uint32_t a_data_size_in_bytes, const Transfer_callback& a_callback);
+
     void register_bus_status_callback(const Bus_status_callback& a_callback);
     void unregister_bus_status_callback();
 
+    void register_event_callback(const Event_callback& a_callback);
+    void unregister_event_callback();
+
+    // SMBus device: drives SMBA low and acknowledges the alert response address until cleared
+    void set_smbus_alert(bool a_active)
+    {
+        assert(nullptr != this->p_i2c);
+
+        cml::set_flag(&(this->p_i2c->CR1), I2C_CR1_ALERTEN, true == a_active ? I2C_CR1_ALERTEN : 0);
+    }
+
+    bool is_smbus_alert() const
+    {
+        assert(nullptr != this->p_i2c);
+
+        return cml::is_flag(this->p_i2c->CR1, I2C_CR1_ALERTEN);
+    }
+
+    bool is_event_callback_registered() const
+    {
+        return nullptr != this->event_callback.address;
+    }
+
+    // software PEC of the event callbacks transaction, see Event_callback
+    uint8_t get_pec() const
+    {
+        return this->pec;
+    }
+
+private:
+
+    void event_interrupt_handler(uint32_t a_isr);
+
+private:
+
+    Event_callback event_callback;
+
+    uint8_t pec;
+    bool pec_restart;
+
 private:
 
     friend void i2c_slave_interrupt_handler(I2C_slave* a_p_this);
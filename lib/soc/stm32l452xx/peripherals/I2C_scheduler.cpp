@@ -0,0 +1,131 @@
+/*
+    Name: I2C_scheduler.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef STM32L452xx
+
+//this
+#include <soc/stm32l452xx/peripherals/I2C_scheduler.hpp>
+
+//externals
+#include <stm32l4xx.h>
+
+//soc
+#include <soc/stm32l452xx/mcu.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+using namespace cml;
+
+bool I2C_scheduler::submit(const Transaction& a_transaction)
+{
+    assert(nullptr != a_transaction.callback.complete);
+    assert(a_transaction.tx_data_size_in_bytes > 0 || a_transaction.rx_data_size_in_bytes > 0);
+    assert(0 == a_transaction.tx_data_size_in_bytes || nullptr != a_transaction.p_tx_data);
+    assert(0 == a_transaction.rx_data_size_in_bytes || nullptr != a_transaction.p_rx_data);
+    assert(true == mcu::is_dwt_enabled());
+
+    mcu::Interrupt_guard interrupt_guard;
+
+    const bool ret = nullptr != this->queue.push(a_transaction, DWT->CYCCNT);
+
+    if (true == ret && nullptr == this->queue.get_active())
+    {
+        this->start_next();
+    }
+
+    return ret;
+}
+
+void I2C_scheduler::cancel_pending()
+{
+    mcu::Interrupt_guard interrupt_guard;
+
+    this->queue.cancel_pending();
+}
+
+void I2C_scheduler::on_complete(uint32_t a_data_length, void* a_p_user_data)
+{
+    reinterpret_cast<I2C_scheduler*>(a_p_user_data)->finish(I2C_master::Bus_status_flag::ok, a_data_length);
+}
+
+void I2C_scheduler::on_error(I2C_master::Bus_status_flag a_bus_status, uint32_t a_data_length, void* a_p_user_data)
+{
+    reinterpret_cast<I2C_scheduler*>(a_p_user_data)->finish(a_bus_status, a_data_length);
+}
+
+void I2C_scheduler::start_next()
+{
+    const Entry* p_next = this->queue.pop();
+
+    if (nullptr != p_next)
+    {
+        const Transaction& transaction               = p_next->transaction;
+        const I2C_master::Transfer_callback callback = { on_complete, on_error, this };
+
+        this->active_start_cycles = DWT->CYCCNT;
+
+        if (0 != transaction.tx_data_size_in_bytes && 0 != transaction.rx_data_size_in_bytes)
+        {
+            this->p_i2c->write_read_dma(transaction.address,
+                                        transaction.p_tx_data,
+                                        transaction.tx_data_size_in_bytes,
+                                        transaction.p_rx_data,
+                                        transaction.rx_data_size_in_bytes,
+                                        callback);
+        }
+        else if (0 != transaction.tx_data_size_in_bytes)
+        {
+            this->p_i2c->transmit_dma(transaction.address,
+                                      transaction.p_tx_data,
+                                      transaction.tx_data_size_in_bytes,
+                                      callback);
+        }
+        else
+        {
+            this->p_i2c->receive_dma(transaction.address,
+                                     transaction.p_rx_data,
+                                     transaction.rx_data_size_in_bytes,
+                                     callback);
+        }
+    }
+}
+
+void I2C_scheduler::finish(I2C_master::Bus_status_flag a_bus_status, uint32_t a_data_length)
+{
+    assert(nullptr != this->queue.get_active());
+
+    const Entry finished       = *(this->queue.get_active());
+    const uint32_t wait_cycles = this->active_start_cycles - finished.submit_cycles;
+    const uint32_t bus_cycles  = DWT->CYCCNT - this->active_start_cycles;
+    const bool error           = I2C_master::Bus_status_flag::ok != a_bus_status;
+
+    I2C_transaction_queue::update_statistics(&(this->statistics), error, a_data_length, wait_cycles, bus_cycles);
+
+    if (nullptr != finished.transaction.p_statistics)
+    {
+        I2C_transaction_queue::update_statistics(finished.transaction.p_statistics, error, a_data_length, wait_cycles, bus_cycles);
+    }
+
+    this->start_next();
+
+    if (false == error)
+    {
+        finished.transaction.callback.complete(a_data_length, finished.transaction.callback.p_user_data);
+    }
+    else if (nullptr != finished.transaction.callback.error)
+    {
+        finished.transaction.callback.error(a_bus_status, a_data_length, finished.transaction.callback.p_user_data);
+    }
+}
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
+
+#endif // STM32L452xx
@@ -0,0 +1,102 @@
+#pragma once
+
+/*
+    Name: I2C_scheduler.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//soc
+#include <soc/stm32l452xx/peripherals/I2C.hpp>
+#include <soc/stm32l452xx/peripherals/I2C_transaction_queue.hpp>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/debug/assert.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+/*
+    Non-blocking, prioritized transaction queue for one I2C bus. Transactions are moved with DMA and
+    the next pending one (I2C_transaction_queue order: highest priority first, FIFO within a priority) is
+    started from the completion interrupt, so the main loop is involved only when it submits.
+    Wait (submit to start) and bus (start to completion) times are DWT cycle counter (SYSCLK) cycles,
+    mcu::enable_dwt has to be called before the first submit.
+*/
+class I2C_scheduler : private cml::Non_copyable
+{
+public:
+
+    using Priority    = I2C_transaction_queue::Priority;
+    using Statistics  = I2C_transaction_queue::Statistics;
+    using Transaction = I2C_transaction_queue::Transaction;
+    using Entry       = I2C_transaction_queue::Entry;
+
+public:
+
+    I2C_scheduler(I2C_master* a_p_i2c, Entry* a_p_buffer, uint32_t a_capacity)
+        : p_i2c(a_p_i2c)
+        , queue(a_p_buffer, a_capacity)
+        , active_start_cycles(0)
+    {
+        assert(nullptr != a_p_i2c);
+    }
+
+    I2C_scheduler()                     = delete;
+    I2C_scheduler(I2C_scheduler&&)      = delete;
+    I2C_scheduler(const I2C_scheduler&) = delete;
+    ~I2C_scheduler()                    = default;
+
+    I2C_scheduler& operator = (I2C_scheduler&&)      = delete;
+    I2C_scheduler& operator = (const I2C_scheduler&) = delete;
+
+    bool submit(const Transaction& a_transaction);
+    void cancel_pending();
+
+    uint32_t get_pending_count() const
+    {
+        return this->queue.get_pending_count();
+    }
+
+    bool is_busy() const
+    {
+        return nullptr != this->queue.get_active();
+    }
+
+    const Statistics& get_statistics() const
+    {
+        return this->statistics;
+    }
+
+    void reset_statistics()
+    {
+        this->statistics = Statistics();
+    }
+
+private:
+
+    static void on_complete(uint32_t a_data_length, void* a_p_user_data);
+    static void on_error(I2C_master::Bus_status_flag a_bus_status, uint32_t a_data_length, void* a_p_user_data);
+
+    void start_next();
+    void finish(I2C_master::Bus_status_flag a_bus_status, uint32_t a_data_length);
+
+private:
+
+    I2C_master* p_i2c;
+
+    I2C_transaction_queue queue;
+    uint32_t active_start_cycles;
+
+    Statistics statistics;
+};
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
@@ -0,0 +1,208 @@
+#pragma once
+
+/*
+    Name: I2C_transaction_queue.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//soc
+#include <soc/stm32l452xx/peripherals/I2C.hpp>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/debug/assert.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+/*
+    Pending transactions of I2C_scheduler, without the bus and the cycle counter: push() takes a free entry,
+    pop() makes the next one (highest priority first, FIFO within a priority) the active one.
+    Not interrupt safe, I2C_scheduler calls it with the interrupts disabled or from the I2C interrupt.
+*/
+class I2C_transaction_queue : private cml::Non_copyable
+{
+public:
+
+    enum class Priority : uint32_t
+    {
+        low,
+        normal,
+        high
+    };
+
+    struct Statistics
+    {
+        uint32_t transactions = 0;
+        uint32_t errors       = 0;
+        uint32_t bytes        = 0;
+
+        uint64_t bus_cycles      = 0;
+        uint64_t wait_cycles     = 0;
+        uint32_t max_wait_cycles = 0;
+    };
+
+    struct Transaction
+    {
+        uint16_t address = 0;
+
+        const void* p_tx_data          = nullptr;
+        uint32_t tx_data_size_in_bytes = 0;
+
+        void* p_rx_data                = nullptr;
+        uint32_t rx_data_size_in_bytes = 0;
+
+        Priority priority = Priority::normal;
+        I2C_master::Transfer_callback callback;
+
+        Statistics* p_statistics = nullptr;
+    };
+
+    struct Entry
+    {
+        Transaction transaction;
+
+        uint32_t submit_cycles = 0;
+        uint32_t sequence      = 0;
+        bool pending           = false;
+    };
+
+public:
+
+    I2C_transaction_queue(Entry* a_p_buffer, uint32_t a_capacity)
+        : p_buffer(a_p_buffer)
+        , capacity(a_capacity)
+        , p_active(nullptr)
+        , sequence(0)
+    {
+        assert(nullptr != a_p_buffer);
+        assert(0 != a_capacity);
+    }
+
+    I2C_transaction_queue()                             = delete;
+    I2C_transaction_queue(I2C_transaction_queue&&)      = delete;
+    I2C_transaction_queue(const I2C_transaction_queue&) = delete;
+    ~I2C_transaction_queue()                            = default;
+
+    I2C_transaction_queue& operator = (I2C_transaction_queue&&)      = delete;
+    I2C_transaction_queue& operator = (const I2C_transaction_queue&) = delete;
+
+    // nullptr when all entries are pending or active
+    Entry* push(const Transaction& a_transaction, uint32_t a_submit_cycles)
+    {
+        Entry* p_free = nullptr;
+
+        for (uint32_t i = 0; i < this->capacity && nullptr == p_free; i++)
+        {
+            if (false == this->p_buffer[i].pending && &(this->p_buffer[i]) != this->p_active)
+            {
+                p_free = &(this->p_buffer[i]);
+            }
+        }
+
+        if (nullptr != p_free)
+        {
+            p_free->transaction   = a_transaction;
+            p_free->submit_cycles = a_submit_cycles;
+            p_free->sequence      = this->sequence++;
+            p_free->pending       = true;
+        }
+
+        return p_free;
+    }
+
+    // the active entry is replaced by the next pending one, nullptr when nothing is pending
+    Entry* pop()
+    {
+        Entry* p_next = nullptr;
+
+        for (uint32_t i = 0; i < this->capacity; i++)
+        {
+            if (true == this->p_buffer[i].pending && (nullptr == p_next || true == is_before(this->p_buffer[i], *p_next)))
+            {
+                p_next = &(this->p_buffer[i]);
+            }
+        }
+
+        if (nullptr != p_next)
+        {
+            p_next->pending = false;
+        }
+
+        this->p_active = p_next;
+
+        return p_next;
+    }
+
+    void cancel_pending()
+    {
+        for (uint32_t i = 0; i < this->capacity; i++)
+        {
+            this->p_buffer[i].pending = false;
+        }
+    }
+
+    uint32_t get_pending_count() const
+    {
+        uint32_t ret = 0;
+
+        for (uint32_t i = 0; i < this->capacity; i++)
+        {
+            ret += true == this->p_buffer[i].pending ? 1 : 0;
+        }
+
+        return ret;
+    }
+
+    Entry* get_active() const
+    {
+        return this->p_active;
+    }
+
+    // higher priority first, then the lower sequence (wraps around)
+    static bool is_before(const Entry& a_left, const Entry& a_right)
+    {
+        if (a_left.transaction.priority != a_right.transaction.priority)
+        {
+            return static_cast<uint32_t>(a_left.transaction.priority) > static_cast<uint32_t>(a_right.transaction.priority);
+        }
+
+        return static_cast<int32_t>(a_left.sequence - a_right.sequence) < 0;
+    }
+
+    static void update_statistics(Statistics* a_p_statistics,
+                                  bool a_error,
+                                  uint32_t a_data_length,
+                                  uint32_t a_wait_cycles,
+                                  uint32_t a_bus_cycles)
+    {
+        a_p_statistics->transactions++;
+        a_p_statistics->errors      += true == a_error ? 1 : 0;
+        a_p_statistics->bytes       += a_data_length;
+        a_p_statistics->wait_cycles += a_wait_cycles;
+        a_p_statistics->bus_cycles  += a_bus_cycles;
+
+        if (a_wait_cycles > a_p_statistics->max_wait_cycles)
+        {
+            a_p_statistics->max_wait_cycles = a_wait_cycles;
+        }
+    }
+
+private:
+
+    Entry* p_buffer;
+    uint32_t capacity;
+
+    Entry* volatile p_active;
+    uint32_t sequence;
+};
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
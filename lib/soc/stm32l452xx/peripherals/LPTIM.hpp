@@ -0,0 +1,177 @@
+#pragma once
+
+/*
+    Name: LPTIM.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#include <stm32l452xx.h>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/frequency.hpp>
+#include <cml/Non_copyable.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+/*
+    Low power timer LPTIM1 (16-bit), counting the internal clock selected by Clock_source (LSI/LSE keep
+    it running in the stop modes). The output (PWM) is active from the compare match to the auto-reload
+    match: active time = auto_reload - compare, compare < auto_reload (enable sets the shortest, 1 tick).
+    Compare and auto-reload are preloaded (applied at the end of the period).
+    One pulse: start_single, delay = compare, width = auto_reload - compare.
+    stop keeps the timer disabled for 2 LPTIM clock cycles (up to 80 us with LSI/LSE, delay::us, DWT).
+    Clock source oscillator (LSI/LSE/HSI16) has to be enabled before enable.
+*/
+class LPTIM : private cml::Non_copyable
+{
+public:
+
+    enum class Id : uint32_t
+    {
+        _1
+    };
+
+    enum class Clock_source : uint32_t
+    {
+        pclk  = 0x0u,
+        lsi   = RCC_CCIPR_LPTIM1SEL_0,
+        hsi16 = RCC_CCIPR_LPTIM1SEL_1,
+        lse   = RCC_CCIPR_LPTIM1SEL_0 | RCC_CCIPR_LPTIM1SEL_1
+    };
+
+    enum class Prescaler : uint32_t
+    {
+        _1   = 0x0u << LPTIM_CFGR_PRESC_Pos,
+        _2   = 0x1u << LPTIM_CFGR_PRESC_Pos,
+        _4   = 0x2u << LPTIM_CFGR_PRESC_Pos,
+        _8   = 0x3u << LPTIM_CFGR_PRESC_Pos,
+        _16  = 0x4u << LPTIM_CFGR_PRESC_Pos,
+        _32  = 0x5u << LPTIM_CFGR_PRESC_Pos,
+        _64  = 0x6u << LPTIM_CFGR_PRESC_Pos,
+        _128 = 0x7u << LPTIM_CFGR_PRESC_Pos
+    };
+
+    enum class Polarity : uint32_t
+    {
+        active_high = 0x0u,
+        active_low  = LPTIM_CFGR_WAVPOL
+    };
+
+    struct Config
+    {
+        Clock_source clock_source = Clock_source::pclk;
+        Prescaler prescaler       = Prescaler::_1;
+        uint16_t auto_reload      = 0xFFFFu;
+        Polarity polarity         = Polarity::active_high;
+    };
+
+    struct Update_callback
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    LPTIM(Id) {}
+
+    ~LPTIM()
+    {
+        this->disable();
+    }
+
+    void enable(const Config& a_config, uint32_t a_irq_priority);
+    void disable();
+
+    void start();
+    void start_single();
+    void stop();
+
+    // blocks until the previous write is synchronized with the LPTIM clock (a few LPTIM clock cycles)
+    void set_compare(uint16_t a_compare);
+    void set_auto_reload(uint16_t a_auto_reload);
+
+    void register_update_callback(const Update_callback& a_callback);
+    void unregister_update_callback();
+
+    uint16_t get_counter() const;
+
+    uint16_t get_compare() const
+    {
+        return static_cast<uint16_t>(LPTIM1->CMP);
+    }
+
+    uint16_t get_auto_reload() const
+    {
+        return static_cast<uint16_t>(LPTIM1->ARR);
+    }
+
+    bool is_enabled() const
+    {
+        return cml::is_flag(LPTIM1->CR, LPTIM_CR_ENABLE);
+    }
+
+    constexpr Id get_id() const
+    {
+        return Id::_1;
+    }
+
+    // smallest prescaler (best resolution) for the period closest to 1 / a_update_frequency_hz
+    static constexpr Config calculate_config(cml::frequency a_clock_hz,
+                                             cml::frequency a_update_frequency_hz,
+                                             Clock_source a_clock_source = Clock_source::pclk,
+                                             Polarity a_polarity         = Polarity::active_high)
+    {
+        const uint32_t ticks = (a_clock_hz + a_update_frequency_hz / 2) / a_update_frequency_hz;
+
+        uint32_t shift = 0;
+
+        while (shift < 7 && ticks > (0x10000u << shift))
+        {
+            shift++;
+        }
+
+        const uint32_t period = (ticks + (0x1u << shift) / 2) >> shift;
+
+        return { a_clock_source,
+                 static_cast<Prescaler>(shift << LPTIM_CFGR_PRESC_Pos),
+                 static_cast<uint16_t>(period > 0x10000u ? 0xFFFFu : period > 1 ? period - 1 : 1),
+                 a_polarity };
+    }
+
+    static constexpr cml::frequency get_update_frequency_hz(cml::frequency a_clock_hz, const Config& a_config)
+    {
+        return (a_clock_hz >> (static_cast<uint32_t>(a_config.prescaler) >> LPTIM_CFGR_PRESC_Pos)) /
+               (a_config.auto_reload + 1u);
+    }
+
+    // a_duty_cycle: 0.01 % units of active output, at least 1 tick
+    static constexpr uint16_t calculate_compare(const Config& a_config, uint32_t a_duty_cycle)
+    {
+        const uint32_t active = ((a_config.auto_reload + 1u) * a_duty_cycle + 5000u) / 10000u;
+        return static_cast<uint16_t>(active < a_config.auto_reload ? a_config.auto_reload - (active > 0 ? active : 1u) : 0);
+    }
+
+private:
+
+    Update_callback update_callback;
+
+private:
+
+    friend void lptim_interrupt_handler(LPTIM* a_p_this);
+};
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
@@ -144,6 +144,7 @@ private:
 private:
 
     friend void rs485_interrupt_handler(RS485* a_p_this);
+    template<USART::Id, typename> friend class USART_irq;
 };
 
 } // namespace peripherals
@@ -0,0 +1,226 @@
+#pragma once
+
+/*
+    Name: TIM.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#include <stm32l452xx.h>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/frequency.hpp>
+#include <cml/Non_copyable.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+/*
+    General purpose timers: TIM2 (32-bit, 4 channels), TIM15 (16-bit, 2 channels), TIM6: Basic_timer.
+    PWM: auto-reload and compare registers are preloaded, a new duty cycle is applied at the next update
+    event (no glitches). One pulse (Config::one_pulse): the counter stops at the update event, with PWM mode 2,
+    compare = delay and auto_reload = delay + width every start emits one pulse.
+    Input capture latches the counter in hardware on the input edge, the value does not depend on the
+    interrupt latency. PWM input: one input captured by two channels, direct on the rising edge and
+    indirect on the falling edge.
+*/
+class TIM : private cml::Non_copyable
+{
+public:
+
+    enum class Id : uint32_t
+    {
+        _2,
+        _15
+    };
+
+    enum class Channel : uint32_t
+    {
+        _1 = 0,
+        _2 = 1,
+        _3 = 2,
+        _4 = 3
+    };
+
+    struct Config
+    {
+        uint16_t prescaler   = 0;
+        uint32_t auto_reload = 0xFFFFFFFFu; // TIM15: up to 0xFFFF
+
+        bool one_pulse = false;
+    };
+
+    struct Pwm
+    {
+        enum class Mode : uint32_t
+        {
+            pwm_1 = TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_2,                    // active while counter < compare
+            pwm_2 = TIM_CCMR1_OC1M_0 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_2  // inactive while counter < compare
+        };
+
+        enum class Polarity : uint32_t
+        {
+            active_high = 0x0u,
+            active_low  = TIM_CCER_CC1P
+        };
+
+        Mode mode         = Mode::pwm_1;
+        Polarity polarity = Polarity::active_high;
+        uint32_t compare  = 0;
+    };
+
+    struct Capture
+    {
+        enum class Edge : uint32_t
+        {
+            rising  = 0x0u,
+            falling = TIM_CCER_CC1P,
+            both    = TIM_CCER_CC1P | TIM_CCER_CC1NP
+        };
+
+        enum class Input : uint32_t
+        {
+            direct   = TIM_CCMR1_CC1S_0,
+            indirect = TIM_CCMR1_CC1S_1
+        };
+
+        enum class Prescaler : uint32_t
+        {
+            _1 = 0x0u,
+            _2 = TIM_CCMR1_IC1PSC_0,
+            _4 = TIM_CCMR1_IC1PSC_1,
+            _8 = TIM_CCMR1_IC1PSC_0 | TIM_CCMR1_IC1PSC_1
+        };
+
+        Edge edge           = Edge::rising;
+        Input input         = Input::direct;
+        Prescaler prescaler = Prescaler::_1;
+        uint32_t filter     = 0; // IC1F, 0 - 15
+    };
+
+    struct Capture_callback
+    {
+        using Function = void(*)(Channel a_channel, uint32_t a_value, Capture::Edge a_edge, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    struct Update_callback
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    TIM(Id a_id)
+        : id(a_id)
+        , overcaptures(0)
+    {}
+
+    ~TIM()
+    {
+        this->disable();
+    }
+
+    void enable(const Config& a_config, uint32_t a_irq_priority);
+    void disable();
+
+    void start();
+    void stop();
+
+    void enable_pwm(Channel a_channel, const Pwm& a_pwm);
+    void disable_pwm(Channel a_channel);
+
+    // preloaded, applied at the next update event
+    void set_compare(Channel a_channel, uint32_t a_compare);
+    uint32_t get_compare(Channel a_channel) const;
+
+    void enable_capture(Channel a_channel, const Capture& a_capture, const Capture_callback& a_callback);
+    void disable_capture(Channel a_channel);
+
+    void register_update_callback(const Update_callback& a_callback);
+    void unregister_update_callback();
+
+    bool is_started() const;
+    uint32_t get_counter() const;
+
+    // captures lost because the previous value of the channel was not read in time
+    uint32_t get_overcaptures_count() const
+    {
+        return this->overcaptures;
+    }
+
+    Id get_id() const
+    {
+        return this->id;
+    }
+
+    uint32_t get_channels_count() const
+    {
+        return Id::_2 == this->id ? 4u : 2u;
+    }
+
+    uint32_t get_counter_max() const
+    {
+        return Id::_2 == this->id ? 0xFFFFFFFFu : 0xFFFFu;
+    }
+
+    /*
+        Prescaler and auto-reload for the update frequency closest to a_update_frequency_hz, with the smallest
+        prescaler (best resolution). a_counter_max: 0xFFFFFFFF for TIM2, 0xFFFF for TIM15. The timer kernel clock
+        is PCLK, or 2 x PCLK when the APB prescaler is not 1.
+    */
+    static constexpr Config calculate_config(cml::frequency a_timer_clock_hz,
+                                             cml::frequency a_update_frequency_hz,
+                                             uint32_t a_counter_max,
+                                             bool a_one_pulse = false)
+    {
+        const uint64_t ticks     = (a_timer_clock_hz + a_update_frequency_hz / 2ull) / a_update_frequency_hz;
+        const uint64_t prescaler = ticks > 0 ? (ticks - 1) / (static_cast<uint64_t>(a_counter_max) + 1u) : 0;
+        const uint64_t period    = (ticks + (prescaler + 1) / 2) / (prescaler + 1);
+
+        return { static_cast<uint16_t>(prescaler),
+                 static_cast<uint32_t>(period > 1 ? period - 1 : 1),
+                 a_one_pulse };
+    }
+
+    static constexpr cml::frequency get_update_frequency_hz(cml::frequency a_timer_clock_hz, const Config& a_config)
+    {
+        return static_cast<cml::frequency>(a_timer_clock_hz / ((a_config.prescaler + 1ull) * (a_config.auto_reload + 1ull)));
+    }
+
+    // a_duty_cycle: 0.01 % units, PWM mode 1
+    static constexpr uint32_t calculate_compare(const Config& a_config, uint32_t a_duty_cycle)
+    {
+        return static_cast<uint32_t>(((a_config.auto_reload + 1ull) * a_duty_cycle + 5000u) / 10000u);
+    }
+
+private:
+
+    Id id;
+
+    Capture_callback capture_callbacks[4];
+    Capture::Edge capture_edges[4];
+    Update_callback update_callback;
+
+    volatile uint32_t overcaptures;
+
+private:
+
+    friend void tim_interrupt_handler(TIM* a_p_this);
+};
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
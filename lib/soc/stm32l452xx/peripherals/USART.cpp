@@ -139,6 +139,8 @@ Controller controllers[] =
 extern "C"
 {
 
+// default, runtime dispatched handlers. A strong definition (see USART_irq.hpp) overrides them per instance.
+
 static void interrupt_handler(uint32_t a_index)
 {
     assert((nullptr != controllers[a_index].p_usart_handle && nullptr == controllers[a_index].p_rs485_handle) ||
@@ -154,17 +156,17 @@ static void interrupt_handler(uint32_t a_index)
     }
 }
 
-void USART1_IRQHandler()
+__attribute__((weak)) void USART1_IRQHandler()
 {
     interrupt_handler(0);
 }
 
-void USART2_IRQHandler()
+__attribute__((weak)) void USART2_IRQHandler()
 {
     interrupt_handler(1);
 }
 
-void USART3_IRQHandler()
+__attribute__((weak)) void USART3_IRQHandler()
 {
     interrupt_handler(2);
 }
@@ -296,6 +296,7 @@ private:
 private:
 
     friend void usart_interrupt_handler(USART* a_p_this);
+    template<Id, typename> friend class USART_irq;
 };
 
 constexpr USART::Bus_status_flag operator | (USART::Bus_status_flag a_f1, USART::Bus_status_flag a_f2)
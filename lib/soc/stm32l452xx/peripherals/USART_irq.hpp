@@ -0,0 +1,194 @@
+#pragma once
+
+/*
+    Name: USART_irq.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#include <stm32l4xx.h>
+
+//soc
+#include <soc/stm32l452xx/peripherals/RS485.hpp>
+#include <soc/stm32l452xx/peripherals/USART.hpp>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/type_traits.hpp>
+#include <cml/debug/assert.hpp>
+
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+/*
+    Compile-time IRQ binding. Default USARTx_IRQHandler's (USART.cpp) are weak and dispatch through the
+    runtime controllers table. Defining a strong handler which calls USART_irq<id, Handle_t>::handle()
+    replaces that path with a specialized one: registers base is a constant, handle type is known
+    and there is no table lookup.
+
+    extern "C" void USART1_IRQHandler()
+    {
+        USART_irq<USART::Id::_1, USART>::handle();
+    }
+*/
+template<USART::Id id, typename Handle_t>
+class USART_irq
+{
+public:
+
+    USART_irq()                 = delete;
+    USART_irq(USART_irq&&)      = delete;
+    USART_irq(const USART_irq&) = delete;
+    ~USART_irq()                = delete;
+
+    USART_irq& operator = (USART_irq&&)      = delete;
+    USART_irq& operator = (const USART_irq&) = delete;
+
+    static void bind(Handle_t* a_p_handle)
+    {
+        assert(nullptr != a_p_handle);
+        assert(id == a_p_handle->id);
+
+        p_handle = a_p_handle;
+    }
+
+    static void unbind()
+    {
+        p_handle = nullptr;
+    }
+
+    static bool is_bound()
+    {
+        return nullptr != p_handle;
+    }
+
+    __attribute__((always_inline)) static inline void handle()
+    {
+        assert(nullptr != p_handle);
+
+        USART_TypeDef* p_registers = get_registers();
+
+        const uint32_t isr = p_registers->ISR;
+        const uint32_t cr1 = p_registers->CR1;
+
+        if (nullptr != p_handle->tx_callback.function)
+        {
+            if (true == cml::is_flag(isr, USART_ISR_TXE) && true == cml::is_flag(cr1, USART_CR1_TXEIE))
+            {
+                if (false == p_handle->tx_callback.function(&(p_registers->TDR),
+                                                            false,
+                                                            p_handle->tx_callback.p_user_data))
+                {
+                    p_handle->unregister_transmit_callback();
+                }
+            }
+
+            if (true == cml::is_flag(isr, USART_ISR_TC) && true == cml::is_flag(cr1, USART_CR1_TCIE))
+            {
+                if (false == p_handle->tx_callback.function(nullptr, true, p_handle->tx_callback.p_user_data))
+                {
+                    p_handle->unregister_transmit_callback();
+                }
+            }
+        }
+
+        if (nullptr != p_handle->rx_callback.function)
+        {
+            bool status = true;
+
+            if (true == cml::is_flag(isr, USART_ISR_RXNE) && true == cml::is_flag(cr1, USART_CR1_RXNEIE))
+            {
+                const uint16_t rdr = static_cast<uint16_t>(p_registers->RDR);
+
+                if (false == is_rs485 || false == cml::is_flag(rdr, 0x100u))
+                {
+                    status = p_handle->rx_callback.function(rdr, false, p_handle->rx_callback.p_user_data);
+                }
+            }
+            else if (true == cml::is_flag(isr, USART_ISR_IDLE) && true == cml::is_flag(cr1, USART_CR1_IDLEIE))
+            {
+                cml::set_flag(&(p_registers->ICR), USART_ICR_IDLECF);
+                status = p_handle->rx_callback.function(0x0u, true, p_handle->rx_callback.p_user_data);
+            }
+
+            if (false == status)
+            {
+                p_handle->unregister_receive_callback();
+            }
+        }
+
+        if (nullptr != p_handle->bus_status_callback.function &&
+            true == cml::is_flag(cr1, USART_CR1_PEIE) &&
+            true == cml::is_flag(p_registers->CR3, USART_CR3_EIE))
+        {
+            handle_bus_status(p_registers, isr);
+        }
+    }
+
+private:
+
+    static constexpr bool is_rs485 = cml::is_same<Handle_t, RS485>::value;
+
+    static_assert(true == cml::is_same<Handle_t, USART>::value || true == is_rs485);
+
+    static USART_TypeDef* get_registers()
+    {
+        if constexpr (USART::Id::_1 == id)
+        {
+            return USART1;
+        }
+        else if constexpr (USART::Id::_2 == id)
+        {
+            return USART2;
+        }
+        else
+        {
+            return USART3;
+        }
+    }
+
+    static void handle_bus_status(USART_TypeDef* a_p_registers, uint32_t a_isr)
+    {
+        USART::Bus_status_flag status = USART::Bus_status_flag::ok;
+
+        if (true == cml::is_flag(a_isr, USART_ISR_PE))
+        {
+            status |= USART::Bus_status_flag::parity_error;
+        }
+
+        if (true == cml::is_flag(a_isr, USART_ISR_FE))
+        {
+            status |= USART::Bus_status_flag::framing_error;
+        }
+
+        if (true == cml::is_flag(a_isr, USART_ISR_ORE))
+        {
+            status |= USART::Bus_status_flag::overrun;
+        }
+
+        if (true == cml::is_flag(a_isr, USART_ISR_NE))
+        {
+            status |= USART::Bus_status_flag::noise_detected;
+        }
+
+        if (USART::Bus_status_flag::ok != status &&
+            true == p_handle->bus_status_callback.function(status, p_handle->bus_status_callback.p_user_data))
+        {
+            cml::set_flag(&(a_p_registers->ICR), USART_ICR_PECF | USART_ICR_FECF | USART_ICR_ORECF | USART_ICR_NECF);
+        }
+    }
+
+private:
+
+    static inline Handle_t* p_handle = nullptr;
+};
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
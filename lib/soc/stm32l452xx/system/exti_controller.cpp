@@ -9,6 +9,8 @@
 #include <soc/stm32l452xx/system/exti_controller.hpp>
 
 //soc
+#include <soc/counter.hpp>
+#include <soc/exti_lines.hpp>
 #include <soc/stm32l452xx/peripherals/GPIO.hpp>
 #ifdef CML_ASSERT
 #include <soc/stm32l452xx/mcu.hpp>
@@ -26,9 +28,52 @@ struct Handler
 {
     exti_controller::Callback callback;
     pin::In const* p_pin = nullptr;
+    bool deferred        = false;
 };
 
 Handler handlers[16];
+soc::exti_lines::Event_queue<exti_controller::Event, 32u> deferred_queue;
+
+// lines with a registered handler
+volatile uint32_t lines = 0;
+
+volatile uint32_t entry_cycles = 0;
+
+void set_line(const pin::In* a_p_pin, exti_controller::Interrupt_mode a_mode)
+{
+    using namespace cml;
+
+    set_flag(&(SYSCFG->EXTICR[a_p_pin->get_id() / 4u]),
+            (static_cast<uint32_t>(a_p_pin->get_port()->get_id()) << ((static_cast<uint32_t>(a_p_pin->get_id()) % 4u) * 4u)));
+
+    clear_bit(&(EXTI->RTSR1), a_p_pin->get_id());
+    clear_bit(&(EXTI->FTSR1), a_p_pin->get_id());
+    set_bit(&(EXTI->IMR1), a_p_pin->get_id());
+
+    switch (a_mode)
+    {
+        case exti_controller::Interrupt_mode::rising:
+        {
+            set_bit(&(EXTI->RTSR1), a_p_pin->get_id());
+        }
+        break;
+
+        case exti_controller::Interrupt_mode::falling:
+        {
+            set_bit(&(EXTI->FTSR1), a_p_pin->get_id());
+        }
+        break;
+
+        default:
+        {
+            if ((exti_controller::Interrupt_mode::rising | exti_controller::Interrupt_mode::falling) == a_mode)
+            {
+                set_bit(&(EXTI->RTSR1), a_p_pin->get_id());
+                set_bit(&(EXTI->FTSR1), a_p_pin->get_id());
+            }
+        }
+    }
+}
 
 } // namespace ::
 
@@ -37,79 +82,63 @@ extern "C"
 
 using namespace cml;
 
-static bool interrupt_handler(uint32_t a_pr1, uint32_t a_index)
+// pending register read once, only the set bits of owned lines are visited (highest first)
+static void interrupt_handler(uint32_t a_lines)
 {
-    assert(nullptr != handlers[a_index].callback.function);
+    entry_cycles = DWT->CYCCNT;
 
-    if (true == is_bit(a_pr1, a_index))
+    const uint32_t clear = soc::exti_lines::dispatch(EXTI->PR1 & lines & a_lines, [](uint32_t a_line) {
+        const Handler& handler = handlers[a_line];
+        const pin::Level level = handler.p_pin->get_level();
+
+        if (true == handler.deferred)
+        {
+            deferred_queue.push({ static_cast<uint8_t>(a_line), level, soc::counter::get() });
+            return true;
+        }
+
+        return handler.callback.function(level, handler.callback.p_user_data);
+    });
+
+    if (0 != clear)
     {
-        return handlers[a_index].callback.function(handlers[a_index].p_pin->get_level(),
-                                                   handlers[a_index].callback.p_user_data);
+        EXTI->PR1 = clear;
     }
-
-    return false;
 }
 
 void EXTI0_IRQHandler()
 {
-    if (true == interrupt_handler(EXTI->PR1, 0))
-    {
-        set_bit(&(EXTI->PR1), 0);
-    }
+    interrupt_handler(0x1u);
 }
 
 void EXTI1_IRQHandler()
 {
-    if (true == interrupt_handler(EXTI->PR1, 1))
-    {
-        set_bit(&(EXTI->PR1), 1);
-    }
+    interrupt_handler(0x2u);
 }
 
 void EXTI2_IRQHandler()
 {
-    if (true == interrupt_handler(EXTI->PR1, 2))
-    {
-        set_bit(&(EXTI->PR1), 2);
-    }
+    interrupt_handler(0x4u);
 }
 
 void EXTI3_IRQHandler()
 {
-    if (true == interrupt_handler(EXTI->PR1, 3))
-    {
-        set_bit(&(EXTI->PR1), 3);
-    }
+    interrupt_handler(0x8u);
 }
 
 void EXTI4_IRQHandler()
 {
-    if (true == interrupt_handler(EXTI->PR1, 4))
-    {
-        set_bit(&(EXTI->PR1), 4);
-    }
+    interrupt_handler(0x10u);
 }
 
 void EXTI9_5_IRQHandler()
 {
-    for (uint32_t i = 5u; i <= 9u; i++)
-    {
-        if (true == interrupt_handler(EXTI->PR1, i))
-        {
-            set_bit(&(EXTI->PR1), i);
-        }
-    }
+    interrupt_handler(0x3E0u);
 }
 
 void EXTI15_10_IRQHandler()
 {
-    for (uint32_t i = 10u; i <= 15u; i++)
-    {
-        if (true == interrupt_handler(EXTI->PR1, i))
-        {
-            set_bit(&(EXTI->PR1), i);
-        }
-    }
+    interrupt_handler(0xFC00u);
 }
 
 } // extern "C"
@@ -156,52 +185,58 @@ void exti_controller::register_callback(pin::In* a_p_pin,
                                         const Callback& a_callback)
 {
     assert(nullptr != a_p_pin);
+    assert(nullptr != a_callback.function);
     assert(true == mcu::is_syscfg_enabled());
-    assert(nullptr == handlers[static_cast<uint32_t>(a_p_pin->get_id())].callback.function);
+    assert(nullptr == handlers[static_cast<uint32_t>(a_p_pin->get_id())].p_pin);
 
-    set_flag(&(SYSCFG->EXTICR[a_p_pin->get_id() / 4u]),
-            (static_cast<uint32_t>(a_p_pin->get_port()->get_id()) << ((static_cast<uint32_t>(a_p_pin->get_id()) % 4u) * 4u)));
+    handlers[a_p_pin->get_id()] = { a_callback, a_p_pin, false };
+    lines                       = lines | (0x1u << a_p_pin->get_id());
 
-    clear_bit(&(EXTI->RTSR1), a_p_pin->get_id());
-    clear_bit(&(EXTI->FTSR1), a_p_pin->get_id());
-    set_bit(&(EXTI->IMR1), a_p_pin->get_id());
+    set_line(a_p_pin, a_mode);
+}
 
-    switch (a_mode)
-    {
-        case Interrupt_mode::rising:
-        {
-            set_bit(&(EXTI->RTSR1), a_p_pin->get_id());
-        }
-        break;
+void exti_controller::register_deferred(pin::In* a_p_pin, Interrupt_mode a_mode)
+{
+    assert(nullptr != a_p_pin);
+    assert(true == mcu::is_syscfg_enabled());
+    assert(nullptr == handlers[static_cast<uint32_t>(a_p_pin->get_id())].p_pin);
 
-        case Interrupt_mode::falling:
-        {
-            set_bit(&(EXTI->FTSR1), a_p_pin->get_id());
-        }
-        break;
+    handlers[a_p_pin->get_id()] = { { nullptr, nullptr }, a_p_pin, true };
+    lines                       = lines | (0x1u << a_p_pin->get_id());
 
-        default:
-        {
-            if ((Interrupt_mode::rising | Interrupt_mode::falling) == a_mode)
-            {
-                set_bit(&(EXTI->RTSR1), a_p_pin->get_id());
-                set_bit(&(EXTI->FTSR1), a_p_pin->get_id());
-            }
-        }
-    }
+    set_line(a_p_pin, a_mode);
+}
+
+bool exti_controller::read_event(Event* a_p_event)
+{
+    assert(nullptr != a_p_event);
 
-    handlers[a_p_pin->get_id()] = { a_callback, a_p_pin };
+    return deferred_queue.read(a_p_event);
+}
+
+uint32_t exti_controller::get_dropped_events_count()
+{
+    return deferred_queue.get_dropped_count();
+}
+
+uint32_t exti_controller::get_entry_cycles()
+{
+    return entry_cycles;
 }
 
 void exti_controller::unregister_callback(const pin::In& a_pin)
 {
+    clear_bit(&(EXTI->IMR1), a_pin.get_id());
     clear_bit(&(EXTI->RTSR1), a_pin.get_id());
     clear_bit(&(EXTI->FTSR1), a_pin.get_id());
 
+    EXTI->PR1 = 0x1u << a_pin.get_id();
+
     clear_flag(&(SYSCFG->EXTICR[a_pin.get_id() / 4u]),
                (static_cast<uint32_t>(a_pin.get_port()->get_id()) << ((static_cast<uint32_t>(a_pin.get_id()) % 4u) * 4u)));
 
-    handlers[a_pin.get_id()] = { { nullptr, nullptr }, nullptr };
+    lines                    = lines & ~(0x1u << a_pin.get_id());
+    handlers[a_pin.get_id()] = { { nullptr, nullptr }, nullptr, false };
 }
 
 } // namespace stm32l452xx
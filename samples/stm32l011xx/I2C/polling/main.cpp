@@ -75,6 +75,12 @@ void print_status(Console* a_p_console,
             a_p_console->write("unknown ");
         }
         break;
+
+        case I2C_base::Bus_status_flag::timeout:
+        {
+            a_p_console->write("timeout ");
+        }
+        break;
     }
 
     a_p_console->write_line("-> bytes: %u", a_bytes);
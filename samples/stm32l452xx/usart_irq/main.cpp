@@ -0,0 +1,196 @@
+/*
+    Name: main.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <cml/hal/counter.hpp>
+#include <cml/hal/mcu.hpp>
+#include <cml/hal/systick.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+#include <cml/hal/peripherals/USART.hpp>
+#include <cml/hal/peripherals/USART_irq.hpp>
+#include <cml/utils/Console.hpp>
+
+/*
+    ISR entry-to-callback latency: USART1 is bound at compile time (USART_irq), USART3 goes through
+    the default, runtime dispatched handler. Both measure DWT cycles from enabling the pending
+    TXE interrupt in NVIC to the first instruction of the user callback.
+*/
+
+namespace
+{
+
+using namespace cml;
+using namespace cml::hal::peripherals;
+
+constexpr uint32_t samples_count = 1000u;
+
+struct Statistics
+{
+    uint32_t min = 0xFFFFFFFFu;
+    uint32_t max = 0;
+    uint32_t sum = 0;
+};
+
+volatile uint32_t start_cycles = 0;
+volatile uint32_t end_cycles   = 0;
+
+bool tx_callback(volatile uint16_t*, bool, void*)
+{
+    end_cycles = DWT->CYCCNT;
+    return false;
+}
+
+Statistics measure(USART* a_p_usart, IRQn_Type a_irqn)
+{
+    Statistics ret;
+
+    for (uint32_t i = 0; i < samples_count; i++)
+    {
+        NVIC_DisableIRQ(a_irqn);
+        a_p_usart->register_transmit_callback({ tx_callback, nullptr });
+
+        start_cycles = DWT->CYCCNT;
+        NVIC_EnableIRQ(a_irqn);
+
+        while (true == a_p_usart->is_transmit_callback_registered());
+
+        const uint32_t cycles = end_cycles - start_cycles;
+
+        ret.min = cycles < ret.min ? cycles : ret.min;
+        ret.max = cycles > ret.max ? cycles : ret.max;
+        ret.sum += cycles;
+    }
+
+    return ret;
+}
+
+uint32_t write_character(char a_character, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->transmit_bytes_polling(&a_character, 1).data_length_in_words;
+}
+
+uint32_t write_string(const char* a_p_string, uint32_t a_length, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->transmit_bytes_polling(a_p_string, a_length).data_length_in_words;
+}
+
+uint32_t read_key(char* a_p_out, uint32_t a_length, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->receive_bytes_polling(a_p_out, a_length).data_length_in_words;
+}
+
+} // namespace ::
+
+extern "C"
+{
+
+void USART1_IRQHandler()
+{
+    USART_irq<USART::Id::_1, USART>::handle();
+}
+
+} // extern "C"
+
+int main()
+{
+    using namespace cml;
+    using namespace cml::hal;
+    using namespace cml::hal::peripherals;
+    using namespace cml::utils;
+
+    mcu::enable_hsi_clock(mcu::Hsi_frequency::_16_MHz);
+    mcu::set_sysclk(mcu::Sysclk_source::hsi, { mcu::Bus_prescalers::AHB::_1,
+                                               mcu::Bus_prescalers::APB1::_1,
+                                               mcu::Bus_prescalers::APB2::_1 });
+
+    if (mcu::Sysclk_source::hsi == mcu::get_sysclk_source())
+    {
+        mcu::set_nvic({ mcu::NVIC_config::Grouping::_4, 16u << 4u });
+        mcu::enable_dwt();
+
+        USART::Config usart_config =
+        {
+            115200u,
+            USART::Oversampling::_16,
+            USART::Stop_bits::_1,
+            USART::Flow_control_flag::none,
+            USART::Sampling_method::three_sample_bit,
+            USART::Mode_flag::tx
+        };
+
+        USART::Frame_format usart_frame_format
+        {
+            USART::Word_length::_8_bit,
+            USART::Parity::none
+        };
+
+        USART::Clock usart_clock
+        {
+            USART::Clock::Source::sysclk,
+            mcu::get_sysclk_frequency_hz(),
+        };
+
+        pin::af::Config usart_pin_config =
+        {
+            pin::Mode::push_pull,
+            pin::Pull::up,
+            pin::Speed::high,
+            0x7u
+        };
+
+        mcu::disable_msi_clock();
+        systick::enable((mcu::get_sysclk_frequency_hz() / kHz(1)) - 1, 0x9u);
+        systick::register_tick_callback({ counter::update, nullptr });
+
+        GPIO gpio_port_a(GPIO::Id::a);
+        gpio_port_a.enable();
+
+        pin::af::enable(&gpio_port_a, 2, usart_pin_config);
+        pin::af::enable(&gpio_port_a, 3, usart_pin_config);
+
+        USART console_usart(USART::Id::_2);
+        USART static_usart(USART::Id::_1);
+        USART dynamic_usart(USART::Id::_3);
+
+        bool usart_ready = console_usart.enable(usart_config, usart_frame_format, usart_clock, 0x1u, 10) &&
+                           static_usart.enable(usart_config, usart_frame_format, usart_clock, 0x1u, 10)  &&
+                           dynamic_usart.enable(usart_config, usart_frame_format, usart_clock, 0x1u, 10);
+
+        if (true == usart_ready)
+        {
+            Console console({ write_character, &console_usart },
+                            { write_string,    &console_usart },
+                            { read_key,        &console_usart });
+
+            console.write_line("CML USART IRQ latency sample. CPU speed: %u MHz",
+                               mcu::get_sysclk_frequency_hz() / MHz(1));
+
+            USART_irq<USART::Id::_1, USART>::bind(&static_usart);
+
+            Statistics dynamic_binding = measure(&dynamic_usart, USART3_IRQn);
+            Statistics static_binding  = measure(&static_usart, USART1_IRQn);
+
+            console.write_line("runtime dispatch [cycles]: min: %u max: %u avg: %u",
+                               dynamic_binding.min,
+                               dynamic_binding.max,
+                               dynamic_binding.sum / samples_count);
+
+            console.write_line("static dispatch  [cycles]: min: %u max: %u avg: %u",
+                               static_binding.min,
+                               static_binding.max,
+                               static_binding.sum / samples_count);
+
+            console.write_line("reduction [cycles]: %u",
+                               (dynamic_binding.sum - static_binding.sum) / samples_count);
+        }
+    }
+
+    while (true);
+}
@@ -0,0 +1,233 @@
+/*
+    Name: Biquad_cascade.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/dsp/Biquad_cascade.hpp>
+
+//std
+#include <cmath>
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::dsp;
+
+constexpr uint32_t post_shift = 1;
+
+// RBJ low-pass, fc = fs / 10, Q = 1/sqrt(2), CMSIS signs (feedback coefficients negated)
+struct Low_pass
+{
+    double b0, b1, b2, a1, a2;
+
+    Low_pass()
+    {
+        const double w0    = 2.0 * 3.14159265358979323846 * 0.1;
+        const double alpha = std::sin(w0) / std::sqrt(2.0);
+        const double a0    = 1.0 + alpha;
+
+        this->b0 = (1.0 - std::cos(w0)) / 2.0 / a0;
+        this->b1 = (1.0 - std::cos(w0)) / a0;
+        this->b2 = this->b0;
+        this->a1 = 2.0 * std::cos(w0) / a0;
+        this->a2 = -(1.0 - alpha) / a0;
+    }
+};
+
+template<typename Type_t>
+Type_t quantize(double a_coefficient)
+{
+    return static_cast<Type_t>(std::lround(a_coefficient * std::ldexp(1.0, fixed_point<Type_t>::fraction_bits - post_shift)));
+}
+
+template<typename Type_t>
+double dequantize(Type_t a_coefficient)
+{
+    return std::ldexp(static_cast<double>(a_coefficient), -static_cast<int>(fixed_point<Type_t>::fraction_bits - post_shift));
+}
+
+// same (quantized) coefficients, double arithmetic, output in the sample units
+template<typename Type_t>
+std::vector<double> reference(const std::vector<Type_t>& a_input,
+                              const typename Biquad_cascade<Type_t, 1>::Coefficients& a_coefficients,
+                              uint32_t a_stages)
+{
+    std::vector<double> ret(a_input.begin(), a_input.end());
+
+    const double b0 = dequantize(a_coefficients.b0);
+    const double b1 = dequantize(a_coefficients.b1);
+    const double b2 = dequantize(a_coefficients.b2);
+    const double a1 = dequantize(a_coefficients.a1);
+    const double a2 = dequantize(a_coefficients.a2);
+
+    for (uint32_t s = 0; s < a_stages; s++)
+    {
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        for (double& sample : ret)
+        {
+            const double y = b0 * sample + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2;
+
+            x2 = x1;
+            x1 = sample;
+            y2 = y1;
+            y1 = y;
+
+            sample = y;
+        }
+    }
+
+    return ret;
+}
+
+// half scale sine below the cut-off plus noise above it
+template<typename Type_t>
+std::vector<Type_t> test_signal(uint32_t a_count)
+{
+    const double scale = std::ldexp(1.0, fixed_point<Type_t>::fraction_bits);
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> noise(-0.1, 0.1);
+    std::vector<Type_t> ret(a_count);
+
+    for (uint32_t i = 0; i < a_count; i++)
+    {
+        ret[i] = static_cast<Type_t>(std::lround((0.4 * std::sin(0.05 * i) + noise(random)) * scale));
+    }
+
+    return ret;
+}
+
+template<typename Type_t, uint32_t stages>
+double get_max_error(uint32_t a_block)
+{
+    const Low_pass low_pass;
+
+    typename Biquad_cascade<Type_t, 1>::Coefficients coefficients_1 = { quantize<Type_t>(low_pass.b0),
+                                                                        quantize<Type_t>(low_pass.b1),
+                                                                        quantize<Type_t>(low_pass.b2),
+                                                                        quantize<Type_t>(low_pass.a1),
+                                                                        quantize<Type_t>(low_pass.a2) };
+
+    typename Biquad_cascade<Type_t, stages>::Coefficients coefficients[stages];
+
+    for (auto& stage : coefficients)
+    {
+        stage = { coefficients_1.b0, coefficients_1.b1, coefficients_1.b2, coefficients_1.a1, coefficients_1.a2 };
+    }
+
+    Biquad_cascade<Type_t, stages> filter;
+    filter.set_coefficients(coefficients, post_shift);
+
+    const std::vector<Type_t> input = test_signal<Type_t>(4096);
+    const std::vector<double> expected = reference(input, coefficients_1, stages);
+
+    std::vector<Type_t> output(input);
+
+    for (uint32_t i = 0; i < output.size(); i += a_block)
+    {
+        filter.process(&(output[i]), &(output[i]), a_block);
+    }
+
+    double ret = 0;
+
+    for (uint32_t i = 0; i < output.size(); i++)
+    {
+        ret = std::max(ret, std::abs(output[i] - expected[i]));
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("Biquad_cascade golden vectors", "[Biquad_cascade]")
+{
+    SECTION("q15 impulse response")
+    {
+        // y[n] = 0.5 * x[n] + 0.5 * y[n-1]
+        const Biquad_cascade<q15, 1>::Coefficients coefficients[] = { { 16384, 0, 0, 16384, 0 } };
+
+        Biquad_cascade<q15, 1> filter;
+        filter.set_coefficients(coefficients, 0);
+
+        q15 samples[8] = { 16384 };
+        const q15 expected[8] = { 8192, 4096, 2048, 1024, 512, 256, 128, 64 };
+
+        filter.process(samples, samples, 8);
+
+        REQUIRE(std::vector<q15>(samples, samples + 8) == std::vector<q15>(expected, expected + 8));
+    }
+
+    SECTION("q31 two stages impulse response")
+    {
+        // each stage: y[n] = 0.5 * x[n] + 0.5 * x[n-2]
+        const Biquad_cascade<q31, 2>::Coefficients coefficients[] = { { 0x40000000, 0, 0x40000000, 0, 0 },
+                                                                       { 0x40000000, 0, 0x40000000, 0, 0 } };
+
+        Biquad_cascade<q31, 2> filter;
+        filter.set_coefficients(coefficients, 0);
+
+        q31 samples[6] = { 0x40000000 };
+        const q31 expected[6] = { 0x10000000, 0, 0x20000000, 0, 0x10000000, 0 };
+
+        filter.process(samples, samples, 6);
+
+        REQUIRE(std::vector<q31>(samples, samples + 6) == std::vector<q31>(expected, expected + 6));
+    }
+
+    SECTION("q15 saturation")
+    {
+        // gain ~2 with post_shift 1
+        const Biquad_cascade<q15, 1>::Coefficients coefficients[] = { { 32767, 0, 0, 0, 0 } };
+
+        Biquad_cascade<q15, 1> filter;
+        filter.set_coefficients(coefficients, 1);
+
+        q15 samples[3] = { 20000, -20000, 1000 };
+        filter.process(samples, samples, 3);
+
+        REQUIRE(32767 == samples[0]);
+        REQUIRE(-32768 == samples[1]);
+        REQUIRE(1999 == samples[2]);
+    }
+}
+
+TEST_CASE("low-pass matches the double reference", "[Biquad_cascade]")
+{
+    // truncation of the accumulator, amplified by the feedback
+    REQUIRE(get_max_error<q15, 1>(4096) <= 4.0);
+    REQUIRE(get_max_error<q15, 2>(64) <= 8.0);
+    REQUIRE(get_max_error<q31, 1>(4096) <= 4.0);
+    REQUIRE(get_max_error<q31, 3>(1) <= 16.0);
+}
+
+TEST_CASE("Biquad_cascade of 1024 samples", "[.benchmark][Biquad_cascade]")
+{
+    const Low_pass low_pass;
+
+    const Biquad_cascade<q15, 2>::Coefficients coefficients_q15[] = {
+        { quantize<q15>(low_pass.b0), quantize<q15>(low_pass.b1), quantize<q15>(low_pass.b2),
+          quantize<q15>(low_pass.a1), quantize<q15>(low_pass.a2) },
+        { quantize<q15>(low_pass.b0), quantize<q15>(low_pass.b1), quantize<q15>(low_pass.b2),
+          quantize<q15>(low_pass.a1), quantize<q15>(low_pass.a2) }
+    };
+
+    const std::vector<q15> input = test_signal<q15>(1024);
+    std::vector<q15> output(input.size());
+
+    Biquad_cascade<q15, 2> filter;
+    filter.set_coefficients(coefficients_q15, post_shift);
+
+    BENCHMARK("q15, 2 stages")
+    {
+        return filter.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+    };
+}
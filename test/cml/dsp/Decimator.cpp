@@ -0,0 +1,82 @@
+/*
+    Name: Decimator.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/dsp/Decimator.hpp>
+
+//std
+#include <numeric>
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+using namespace cml::dsp;
+
+TEST_CASE("Decimator golden vector", "[Decimator]")
+{
+    Decimator<int16_t, 3> decimator;
+
+    const int16_t input[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    int16_t output[8];
+
+    // phase kept between the blocks: 0, 3 | 6
+    REQUIRE(2 == decimator.process(input, output, 5));
+    REQUIRE((0 == output[0] && 3 == output[1]));
+
+    REQUIRE(1 == decimator.process(input + 5, output, 3));
+    REQUIRE(6 == output[0]);
+
+    REQUIRE(0 == decimator.process(input, output, 1));
+    REQUIRE(0 == decimator.process(input, output, 0));
+
+    decimator.reset();
+
+    REQUIRE(1 == decimator.process(input + 7, output, 1));
+    REQUIRE(7 == output[0]);
+}
+
+TEST_CASE("random blocks in place keep every factor-th sample", "[Decimator]")
+{
+    std::vector<int32_t> samples(10000);
+    std::iota(samples.begin(), samples.end(), 0);
+
+    Decimator<int32_t, 7> decimator;
+    std::mt19937 random(1);
+
+    std::vector<int32_t> output;
+
+    for (uint32_t i = 0; i < samples.size();)
+    {
+        const uint32_t count = std::min<uint32_t>(random() % 20, static_cast<uint32_t>(samples.size()) - i);
+        const uint32_t ret   = decimator.process(&(samples[i]), &(samples[i]), count);
+
+        output.insert(output.end(), samples.begin() + i, samples.begin() + i + ret);
+        i += count;
+    }
+
+    REQUIRE(output.size() == (samples.size() + 6) / 7);
+
+    for (uint32_t i = 0; i < output.size(); i++)
+    {
+        REQUIRE(static_cast<int32_t>(i * 7) == output[i]);
+    }
+}
+
+TEST_CASE("Decimator of 1024 samples", "[.benchmark][Decimator]")
+{
+    std::vector<int16_t> input(1024);
+    std::vector<int16_t> output(input.size());
+
+    Decimator<int16_t, 4> decimator;
+
+    BENCHMARK("factor 4")
+    {
+        return decimator.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+    };
+}
@@ -0,0 +1,123 @@
+/*
+    Name: Median.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/dsp/Median.hpp>
+
+//std
+#include <algorithm>
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::dsp;
+
+// sorts the last (up to) a_window samples
+std::vector<int16_t> reference(const std::vector<int16_t>& a_input, uint32_t a_window)
+{
+    std::vector<int16_t> ret(a_input.size());
+
+    for (size_t i = 0; i < a_input.size(); i++)
+    {
+        const size_t first = i + 1 > a_window ? i + 1 - a_window : 0;
+        std::vector<int16_t> window(a_input.begin() + first, a_input.begin() + i + 1);
+
+        std::sort(window.begin(), window.end());
+        ret[i] = window[window.size() / 2];
+    }
+
+    return ret;
+}
+
+std::vector<int16_t> random_samples(uint32_t a_count, int16_t a_range, uint32_t a_seed)
+{
+    std::mt19937 random(a_seed);
+    std::uniform_int_distribution<int32_t> distribution(-a_range, a_range);
+    std::vector<int16_t> ret(a_count);
+
+    for (int16_t& sample : ret)
+    {
+        sample = static_cast<int16_t>(distribution(random));
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("Median golden vector", "[Median]")
+{
+    Median<int16_t, 5> median;
+
+    const int16_t input[]    = { 5, 1, 4, 2, 3, 9, 9, 0, 7, 7 };
+    const int16_t expected[] = { 5, 5, 4, 4, 3, 3, 4, 3, 7, 7 };
+
+    int16_t output[10];
+
+    REQUIRE(10 == median.process(input, output, 10));
+    REQUIRE(std::vector<int16_t>(output, output + 10) == std::vector<int16_t>(expected, expected + 10));
+
+    median.reset();
+
+    REQUIRE(1 == median.process(input + 1, output, 1));
+    REQUIRE(1 == output[0]);
+}
+
+TEST_CASE("Median random blocks match the reference", "[Median]")
+{
+    // small range: many duplicates in the window
+    const std::vector<int16_t> input = GENERATE(random_samples(4096, 3, 1), random_samples(4096, 32767, 2));
+
+    SECTION("window 3")
+    {
+        Median<int16_t, 3> median;
+        std::vector<int16_t> output(input);
+        std::mt19937 random(3);
+
+        for (uint32_t i = 0; i < output.size();)
+        {
+            const uint32_t count = std::min<uint32_t>(random() % 50, static_cast<uint32_t>(output.size()) - i);
+            median.process(&(output[i]), &(output[i]), count);
+            i += count;
+        }
+
+        REQUIRE(reference(input, 3) == output);
+    }
+
+    SECTION("window 63")
+    {
+        Median<int16_t, 63> median;
+        std::vector<int16_t> output(input.size());
+
+        median.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+
+        REQUIRE(reference(input, 63) == output);
+    }
+}
+
+TEST_CASE("Median of 1024 samples", "[.benchmark][Median]")
+{
+    const std::vector<int16_t> input = random_samples(1024, 32767, 4);
+    std::vector<int16_t> output(input.size());
+
+    Median<int16_t, 5> median_5;
+    Median<int16_t, 31> median_31;
+
+    BENCHMARK("window 5")
+    {
+        return median_5.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+    };
+
+    BENCHMARK("window 31")
+    {
+        return median_31.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+    };
+}
@@ -0,0 +1,126 @@
+/*
+    Name: Moving_average.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/dsp/Moving_average.hpp>
+
+//std
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::dsp;
+
+// floor of the mean of the last a_window samples, history starts with zeros
+template<typename Type_t>
+std::vector<Type_t> reference(const std::vector<Type_t>& a_input, uint32_t a_window)
+{
+    std::vector<Type_t> ret(a_input.size());
+
+    for (size_t i = 0; i < a_input.size(); i++)
+    {
+        int64_t sum = 0;
+
+        for (size_t j = 0; j < a_window && j <= i; j++)
+        {
+            sum += a_input[i - j];
+        }
+
+        ret[i] = static_cast<Type_t>(sum >= 0 ? sum / a_window : -((-sum + a_window - 1) / a_window));
+    }
+
+    return ret;
+}
+
+template<typename Type_t>
+std::vector<Type_t> random_samples(uint32_t a_count, uint32_t a_seed)
+{
+    std::mt19937 random(a_seed);
+    std::uniform_int_distribution<int64_t> distribution(cml::numeric_traits<Type_t>::get_min(),
+                                                        cml::numeric_traits<Type_t>::get_max());
+    std::vector<Type_t> ret(a_count);
+
+    for (Type_t& sample : ret)
+    {
+        sample = static_cast<Type_t>(distribution(random));
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("Moving_average golden vector", "[Moving_average]")
+{
+    Moving_average<q15, 4> average;
+
+    const q15 input[]    = { 4, 8, 12, 16, 20, -20, 0, 0, 0, 0 };
+    const q15 expected[] = { 1, 3, 6, 10, 14, 7, 4, 0, -5, 0 };
+
+    q15 output[10];
+
+    REQUIRE(10 == average.process(input, output, 10));
+    REQUIRE(std::vector<q15>(output, output + 10) == std::vector<q15>(expected, expected + 10));
+
+    average.reset();
+
+    REQUIRE(1 == average.process(input, output, 1));
+    REQUIRE(1 == output[0]);
+}
+
+TEST_CASE("Moving_average random blocks match the reference", "[Moving_average]")
+{
+    SECTION("q15, window 8")
+    {
+        const std::vector<q15> input = random_samples<q15>(4096, 1);
+        const std::vector<q15> expected = reference(input, 8);
+
+        Moving_average<q15, 8> average;
+        std::vector<q15> output(input);
+        std::mt19937 random(2);
+
+        // in place, blocks of random length
+        for (uint32_t i = 0; i < output.size();)
+        {
+            const uint32_t count = std::min<uint32_t>(random() % 100, static_cast<uint32_t>(output.size()) - i);
+            REQUIRE(count == average.process(&(output[i]), &(output[i]), count));
+            i += count;
+        }
+
+        REQUIRE(expected == output);
+    }
+
+    SECTION("q31, window 64")
+    {
+        const std::vector<q31> input = random_samples<q31>(4096, 3);
+        const std::vector<q31> expected = reference(input, 64);
+
+        Moving_average<q31, 64> average;
+        std::vector<q31> output(input.size());
+
+        average.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+
+        REQUIRE(expected == output);
+    }
+}
+
+TEST_CASE("Moving_average of 1024 samples", "[.benchmark][Moving_average]")
+{
+    const std::vector<q15> input = random_samples<q15>(1024, 4);
+    std::vector<q15> output(input.size());
+
+    Moving_average<q15, 16> average;
+
+    BENCHMARK("q15, window 16")
+    {
+        return average.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+    };
+}
@@ -0,0 +1,104 @@
+/*
+    Name: Pipeline.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/dsp/Pipeline.hpp>
+
+// before catch.hpp (<cassert>)
+//cml
+#include <cml/dsp/Decimator.hpp>
+#include <cml/dsp/Median.hpp>
+#include <cml/dsp/Moving_average.hpp>
+
+//std
+#include <random>
+#include <type_traits>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::dsp;
+
+using Chain = Pipeline<Median<q15, 5>, Moving_average<q15, 4>, Decimator<q15, 4>>;
+
+std::vector<q15> random_samples(uint32_t a_count)
+{
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int32_t> distribution(-32768, 32767);
+    std::vector<q15> ret(a_count);
+
+    for (q15& sample : ret)
+    {
+        sample = static_cast<q15>(distribution(random));
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("stages run in order, blocks split anywhere", "[Pipeline]")
+{
+    static_assert(std::is_same_v<Moving_average<q15, 4>&, decltype(std::declval<Chain&>().get<1>())>);
+
+    const std::vector<q15> input = random_samples(4096);
+
+    // each stage on the whole signal
+    std::vector<q15> expected(input.size());
+    Median<q15, 5>().process(input.data(), expected.data(), 4096);
+    Moving_average<q15, 4>().process(expected.data(), expected.data(), 4096);
+    expected.resize(Decimator<q15, 4>().process(expected.data(), expected.data(), 4096));
+
+    Chain chain;
+    std::mt19937 random(2);
+    std::vector<q15> output;
+    std::vector<q15> block(64);
+
+    for (uint32_t i = 0; i < input.size();)
+    {
+        const uint32_t count = std::min<uint32_t>(random() % 64, static_cast<uint32_t>(input.size()) - i);
+        const uint32_t ret   = chain.process(&(input[i]), block.data(), count);
+
+        output.insert(output.end(), block.begin(), block.begin() + ret);
+        i += count;
+    }
+
+    REQUIRE(expected == output);
+
+    chain.reset();
+    std::vector<q15> restarted(input.size());
+    restarted.resize(chain.process(input.data(), restarted.data(), 4096));
+
+    REQUIRE(expected == restarted);
+}
+
+TEST_CASE("empty pipeline copies", "[Pipeline]")
+{
+    const q15 input[3] = { 1, -2, 3 };
+    q15 output[3]      = {};
+
+    Pipeline<> pipeline;
+
+    REQUIRE(3 == pipeline.process(input, output, 3));
+    REQUIRE((1 == output[0] && -2 == output[1] && 3 == output[2]));
+}
+
+TEST_CASE("Pipeline of 1024 samples", "[.benchmark][Pipeline]")
+{
+    const std::vector<q15> input = random_samples(1024);
+    std::vector<q15> output(input.size());
+
+    Chain chain;
+
+    BENCHMARK("median 5, average 4, decimation 4")
+    {
+        return chain.process(input.data(), output.data(), static_cast<uint32_t>(input.size()));
+    };
+}
@@ -0,0 +1,207 @@
+/*
+    Name: Spectrum.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/dsp/Spectrum.hpp>
+
+//std
+#include <cmath>
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::dsp;
+
+constexpr double pi = 3.14159265358979323846;
+
+double get_window(Window a_window, uint32_t a_index, uint32_t a_size)
+{
+    const double s = std::sin(pi * a_index / a_size);
+
+    switch (a_window)
+    {
+        case Window::hann:
+            return s * s;
+
+        case Window::hamming:
+            return 0.08 + 0.92 * s * s;
+
+        default:
+            return 1.0;
+    }
+}
+
+// windowed DFT, |X[k]| * 2 / size (a sine of amplitude A gives A * coherent gain)
+std::vector<double> reference(const std::vector<q15>& a_samples, Window a_window)
+{
+    const uint32_t size = static_cast<uint32_t>(a_samples.size());
+    std::vector<double> ret(size / 2);
+
+    for (uint32_t k = 0; k < size / 2; k++)
+    {
+        double real = 0;
+        double imag = 0;
+
+        for (uint32_t n = 0; n < size; n++)
+        {
+            const double sample = a_samples[n] * get_window(a_window, n, size);
+
+            real += sample * std::cos(2 * pi * k * n / size);
+            imag -= sample * std::sin(2 * pi * k * n / size);
+        }
+
+        ret[k] = std::min(std::hypot(real, imag) * 2 / size, 32767.0);
+    }
+
+    return ret;
+}
+
+// sum of sines (bin, amplitude) and uniform noise
+std::vector<q15> get_signal(uint32_t a_size,
+                            const std::vector<std::pair<double, double>>& a_sines,
+                            double a_noise,
+                            uint32_t a_seed)
+{
+    std::mt19937 random(a_seed);
+    std::uniform_real_distribution<double> noise(-a_noise, a_noise);
+    std::vector<q15> ret(a_size);
+
+    for (uint32_t n = 0; n < a_size; n++)
+    {
+        double sample = 0 != a_noise ? noise(random) : 0.0;
+
+        for (const auto& sine : a_sines)
+        {
+            sample += sine.second * std::sin(2 * pi * sine.first * n / a_size + 0.3);
+        }
+
+        ret[n] = static_cast<q15>(std::lround(sample));
+    }
+
+    return ret;
+}
+
+template<uint32_t size, Window window>
+double get_max_error(const std::vector<q15>& a_samples)
+{
+    Spectrum<size, window> spectrum;
+    spectrum.process(a_samples.data());
+
+    const std::vector<double> expected = reference(a_samples, window);
+    double ret = 0;
+
+    for (uint32_t k = 0; k < Spectrum<size, window>::bins; k++)
+    {
+        ret = std::max(ret, std::abs(spectrum.get_magnitude(k) - expected[k]));
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("magnitudes match the double reference", "[Spectrum]")
+{
+    // truncation in every butterfly stage, about one LSB per stage
+    const std::vector<q15> tones = get_signal(256, { { 10, 12000 }, { 37.5, 6000 }, { 90, 800 } }, 0, 1);
+    const std::vector<q15> noisy = get_signal(256, { { 20, 16000 } }, 8000, 2);
+
+    REQUIRE((get_max_error<256, Window::rectangular>(tones) <= 16.0));
+    REQUIRE((get_max_error<256, Window::hann>(tones) <= 16.0));
+    REQUIRE((get_max_error<256, Window::hamming>(noisy) <= 16.0));
+    REQUIRE((get_max_error<1024, Window::hann>(get_signal(1024, { { 100, 20000 } }, 4000, 3)) <= 20.0));
+    REQUIRE((get_max_error<32, Window::rectangular>(get_signal(32, { { 3, 30000 } }, 0, 4)) <= 10.0));
+}
+
+TEST_CASE("ADC samples are centered and scaled", "[Spectrum]")
+{
+    const std::vector<q15> signal = get_signal(256, { { 12, 30000 } }, 1000, 5);
+
+    std::vector<uint16_t> adc_12(signal.size());
+    std::vector<q15> expected_12(signal.size());
+
+    for (uint32_t i = 0; i < signal.size(); i++)
+    {
+        adc_12[i]      = static_cast<uint16_t>((signal[i] >> 4) + 2048);
+        expected_12[i] = static_cast<q15>((signal[i] >> 4) * 16);
+    }
+
+    Spectrum<256> from_adc;
+    Spectrum<256> from_q15;
+
+    from_adc.process(adc_12.data(), 12);
+    from_q15.process(expected_12.data());
+
+    REQUIRE(std::vector<q15>(from_adc.get_magnitudes(), from_adc.get_magnitudes() + 128) ==
+            std::vector<q15>(from_q15.get_magnitudes(), from_q15.get_magnitudes() + 128));
+
+    // full range 16-bit samples: 0 -> -32768, 65535 -> 32767
+    std::vector<uint16_t> adc_16(signal.size());
+    std::vector<q15> expected_16(signal.size());
+
+    for (uint32_t i = 0; i < signal.size(); i++)
+    {
+        adc_16[i]      = 0 == (i & 0x1u) ? 0u : 0xFFFFu;
+        expected_16[i] = 0 == (i & 0x1u) ? -32768 : 32767;
+    }
+
+    from_adc.process(adc_16.data(), 16);
+    from_q15.process(expected_16.data());
+
+    REQUIRE(std::vector<q15>(from_adc.get_magnitudes(), from_adc.get_magnitudes() + 128) ==
+            std::vector<q15>(from_q15.get_magnitudes(), from_q15.get_magnitudes() + 128));
+}
+
+TEST_CASE("peaks sorted by magnitude", "[Spectrum]")
+{
+    Spectrum<256> spectrum;
+    spectrum.process(get_signal(256, { { 10, 12000 }, { 37.5, 6000 }, { 90, 800 } }, 0, 1).data());
+
+    Spectrum<256>::Peak peaks[4];
+
+    REQUIRE(3 == spectrum.find_peaks(peaks, 4, 200));
+    REQUIRE(10 == peaks[0].bin);
+    REQUIRE(std::abs(peaks[0].magnitude - 6000) <= 16);
+    REQUIRE((37 == peaks[1].bin || 38 == peaks[1].bin));
+    REQUIRE(90 == peaks[2].bin);
+    REQUIRE(std::abs(peaks[2].magnitude - 400) <= 16);
+
+    // capacity 1: the highest one, all counted
+    REQUIRE(1 == spectrum.find_peaks(peaks, 1, 200));
+    REQUIRE(10 == peaks[0].bin);
+
+    REQUIRE(1000 == Spectrum<256>::get_bin_frequency_hz(25600, 10));
+}
+
+TEST_CASE("Spectrum memory and time per block", "[.benchmark][Spectrum]")
+{
+    // portable build: work (size) and magnitudes (size / 2), tables are constexpr (flash)
+    STATIC_REQUIRE(sizeof(Spectrum<256>) == 256 * 3 / 2 * sizeof(q15));
+    STATIC_REQUIRE(sizeof(Spectrum<1024>) == 1024 * 3 / 2 * sizeof(q15));
+
+    const std::vector<q15> signal_256  = get_signal(256, { { 20, 16000 } }, 8000, 6);
+    const std::vector<q15> signal_1024 = get_signal(1024, { { 20, 16000 } }, 8000, 7);
+
+    Spectrum<256> spectrum_256;
+    Spectrum<1024> spectrum_1024;
+
+    BENCHMARK("256 samples, hann")
+    {
+        spectrum_256.process(signal_256.data());
+        return spectrum_256.get_magnitude(20);
+    };
+
+    BENCHMARK("1024 samples, hann")
+    {
+        spectrum_1024.process(signal_1024.data());
+        return spectrum_1024.get_magnitude(20);
+    };
+}
@@ -0,0 +1,91 @@
+/*
+    Name: ADC_converter.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/ADC_converter.hpp>
+
+//std
+#include <cmath>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::utils;
+
+using Calibration_data = ADC_converter<>::Calibration_data;
+
+// typical factory values (TS_CAL1, TS_CAL2, VREFINT_CAL)
+const Calibration_data calibration_data = { 1034, 1372, 1655 };
+
+double to_millivolts(uint16_t a_raw, uint16_t a_voltage_reference_raw)
+{
+    const double vdda_mV = 3000.0 * calibration_data.internal_voltage_reference / a_voltage_reference_raw;
+    return a_raw * vdda_mV / 4095.0;
+}
+
+double to_centidegrees(uint16_t a_raw, uint16_t a_voltage_reference_raw)
+{
+    // sample scaled to VDDA = 3000 mV (TS_CAL conditions)
+    const double raw_3000_mV = static_cast<double>(a_raw) * calibration_data.internal_voltage_reference /
+                               a_voltage_reference_raw;
+
+    return 100.0 * (30.0 + (raw_3000_mV - calibration_data.temperature_sensor_data_1) * 100.0 /
+                           (calibration_data.temperature_sensor_data_2 - calibration_data.temperature_sensor_data_1));
+}
+
+} // namespace ::
+
+TEST_CASE("conversions match the double reference", "[ADC_converter]")
+{
+    // VDDA from about 2.6 V to 3.5 V
+    for (uint16_t voltage_reference_raw = 1400; voltage_reference_raw <= 1900; voltage_reference_raw += 50)
+    {
+        const ADC_converter<> converter(calibration_data, voltage_reference_raw);
+
+        REQUIRE(std::abs(converter.get_vdda_mV() - 3000.0 * 1655 / voltage_reference_raw) <= 0.5);
+
+        for (uint16_t raw = 0; raw <= 0xFFFu; raw++)
+        {
+            REQUIRE(std::abs(converter.to_millivolts(raw) - to_millivolts(raw, voltage_reference_raw)) <= 1.0);
+
+            // sensor range (-40 C to 125 C), Q8 factor rounding grows with the sample
+            const double centidegrees = to_centidegrees(raw, voltage_reference_raw);
+
+            if (centidegrees >= -4000.0 && centidegrees <= 12500.0)
+            {
+                REQUIRE(std::abs(converter.to_temperature(raw) - centidegrees) <= 4.0);
+            }
+        }
+    }
+}
+
+TEST_CASE("batch conversion equals the single sample conversion", "[ADC_converter]")
+{
+    const ADC_converter<> converter(calibration_data, 1621);
+
+    std::vector<uint16_t> raw(0x1001u);
+
+    for (uint32_t i = 0; i < raw.size(); i++)
+    {
+        raw[i] = static_cast<uint16_t>((i * 2477u) & 0xFFFu);
+    }
+
+    std::vector<uint16_t> millivolts(raw.size());
+    std::vector<int16_t> centidegrees(raw.size());
+
+    converter.to_millivolts(raw.data(), millivolts.data(), static_cast<uint32_t>(raw.size()));
+    converter.to_temperature(raw.data(), centidegrees.data(), static_cast<uint32_t>(raw.size()));
+
+    for (uint32_t i = 0; i < raw.size(); i++)
+    {
+        REQUIRE(converter.to_millivolts(raw[i]) == millivolts[i]);
+        REQUIRE(converter.to_temperature(raw[i]) == centidegrees[i]);
+    }
+}
@@ -0,0 +1,211 @@
+/*
+    Name: Debouncer.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Debouncer.hpp>
+
+//std
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml;
+using namespace cml::utils;
+
+// update(sample, timestamp) never reads the port
+struct Port {};
+
+using Level = hal::peripherals::pin::Level;
+
+template<uint32_t capacity>
+using Test_debouncer = Debouncer<capacity, Port>;
+
+// one pin: the level changes after 4 consecutive samples different from it
+struct Reference_pin
+{
+    bool level     = false;
+    uint32_t count = 0;
+
+    bool update(bool a_sample)
+    {
+        bool ret = false;
+
+        if (a_sample == this->level)
+        {
+            this->count = 0;
+        }
+        else if (4 == ++(this->count))
+        {
+            this->level = a_sample;
+            this->count = 0;
+            ret         = true;
+        }
+
+        return ret;
+    }
+};
+
+template<uint32_t capacity>
+std::vector<uint32_t> run_script(Test_debouncer<capacity>* a_p_debouncer, const std::vector<uint16_t>& a_samples)
+{
+    std::vector<uint32_t> ret;
+
+    for (uint32_t i = 0; i < a_samples.size(); i++)
+    {
+        if (0 != a_p_debouncer->update(a_samples[i], i))
+        {
+            ret.push_back(i);
+        }
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("scripted bounce patterns", "[Debouncer]")
+{
+    Port port;
+    Test_debouncer<16> debouncer(&port, 0x0001u);
+    debouncer.reset(0x0000u);
+
+    SECTION("clean edge: the 4th sample changes the level")
+    {
+        REQUIRE(std::vector<uint32_t>{ 3 } == run_script(&debouncer, { 1, 1, 1, 1, 1, 1 }));
+        REQUIRE(Level::high == debouncer.get_level(0));
+    }
+
+    SECTION("bounce restarts the count")
+    {
+        REQUIRE(std::vector<uint32_t>{ 8 } == run_script(&debouncer, { 1, 0, 1, 1, 0, 1, 1, 1, 1, 1 }));
+    }
+
+    SECTION("glitches shorter than 4 samples are filtered")
+    {
+        REQUIRE(std::vector<uint32_t>{} == run_script(&debouncer, { 1, 1, 1, 0, 1, 1, 1, 0, 0, 1, 0 }));
+        REQUIRE(Level::low == debouncer.get_level(0));
+        REQUIRE(0 == debouncer.get_state());
+    }
+
+    SECTION("press and release")
+    {
+        REQUIRE(std::vector<uint32_t>{ 6, 13 } == run_script(&debouncer, { 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 0 }));
+
+        Test_debouncer<16>::Event event;
+
+        REQUIRE(true == debouncer.read_event(&event));
+        REQUIRE(0 == event.id);
+        REQUIRE(Level::high == event.level);
+        REQUIRE(6 == event.timestamp);
+
+        REQUIRE(true == debouncer.read_event(&event));
+        REQUIRE(Level::low == event.level);
+        REQUIRE(13 == event.timestamp);
+
+        REQUIRE(false == debouncer.read_event(&event));
+    }
+}
+
+TEST_CASE("pins outside of the mask are ignored", "[Debouncer]")
+{
+    Port port;
+    Test_debouncer<16> debouncer(&port, 0x00F0u);
+    debouncer.reset(0xFFFFu);
+
+    REQUIRE(0x00F0u == debouncer.get_state());
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        REQUIRE(0 == (debouncer.update(0xFF0Fu, i) & 0xFF0Fu));
+    }
+
+    REQUIRE(0x0000u == debouncer.get_state());
+    REQUIRE(0x00F0u == debouncer.get_mask());
+}
+
+TEST_CASE("full event queue drops events", "[Debouncer]")
+{
+    Port port;
+    Test_debouncer<2> debouncer(&port, 0x0007u);
+    debouncer.reset(0x0000u);
+
+    // three pins change on the same sample, one event does not fit
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        debouncer.update(0x0007u, i);
+    }
+
+    REQUIRE(1 == debouncer.get_dropped_events_count());
+
+    Test_debouncer<2>::Event event;
+
+    REQUIRE(true == debouncer.read_event(&event));
+    REQUIRE(0 == event.id);
+    REQUIRE(true == debouncer.read_event(&event));
+    REQUIRE(1 == event.id);
+    REQUIRE(false == debouncer.read_event(&event));
+
+    debouncer.reset(0x0000u);
+
+    REQUIRE(0 == debouncer.get_dropped_events_count());
+}
+
+TEST_CASE("16 pins match the per pin reference", "[Debouncer]")
+{
+    Port port;
+    Test_debouncer<64> debouncer(&port, 0xFFFFu);
+    debouncer.reset(0x0000u);
+
+    Reference_pin reference[16];
+    std::mt19937 random(5);
+    uint16_t sample = 0;
+
+    for (uint32_t tick = 0; tick < 100000; tick++)
+    {
+        // every pin: a bounce with probability 1 / 4, a new stable level with probability 1 / 64
+        for (uint32_t pin = 0; pin < 16; pin++)
+        {
+            if (0 == random() % 4 || 0 == random() % 64)
+            {
+                sample ^= static_cast<uint16_t>(1u << pin);
+            }
+        }
+
+        uint16_t changed = 0;
+
+        for (uint32_t pin = 0; pin < 16; pin++)
+        {
+            if (true == reference[pin].update(0 != (sample & (1u << pin))))
+            {
+                changed |= static_cast<uint16_t>(1u << pin);
+            }
+        }
+
+        REQUIRE(changed == debouncer.update(sample, tick));
+
+        Test_debouncer<64>::Event event;
+
+        for (uint32_t pin = 0; pin < 16; pin++)
+        {
+            if (0 != (changed & (1u << pin)))
+            {
+                REQUIRE(true == debouncer.read_event(&event));
+                REQUIRE(pin == event.id);
+                REQUIRE(tick == event.timestamp);
+                REQUIRE((true == reference[pin].level ? Level::high : Level::low) == event.level);
+            }
+        }
+
+        REQUIRE(false == debouncer.read_event(&event));
+    }
+
+    REQUIRE(0 == debouncer.get_dropped_events_count());
+}
@@ -0,0 +1,345 @@
+/*
+    Name: Edge_capture.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Edge_capture.hpp>
+
+//std
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::utils;
+
+using Level   = cml::hal::peripherals::pin::Level;
+using TIM     = cml::hal::peripherals::TIM;
+using Capture = TIM::Capture;
+
+struct Pushed_edge
+{
+    Level level;
+    uint32_t timestamp;
+};
+
+struct Averages
+{
+    bool has_period = false;
+    bool has_high   = false;
+
+    uint32_t period = 0;
+    uint32_t high   = 0;
+};
+
+// every complete interval among the last a_capacity edges, rounded averages
+Averages reference(const std::vector<Pushed_edge>& a_edges, uint32_t a_capacity, uint32_t a_counter_max)
+{
+    const size_t first = a_edges.size() > a_capacity ? a_edges.size() - a_capacity : 0;
+
+    uint64_t period_sum = 0;
+    uint64_t high_sum   = 0;
+    uint64_t periods    = 0;
+    uint64_t highs      = 0;
+
+    for (size_t i = first; i < a_edges.size(); i++)
+    {
+        if (Level::high != a_edges[i].level)
+        {
+            continue;
+        }
+
+        for (size_t j = i + 1; j < a_edges.size(); j++)
+        {
+            if (Level::high == a_edges[j].level)
+            {
+                period_sum += (a_edges[j].timestamp - a_edges[i].timestamp) & a_counter_max;
+                periods++;
+                break;
+            }
+        }
+
+        if (i + 1 < a_edges.size() && Level::low == a_edges[i + 1].level)
+        {
+            high_sum += (a_edges[i + 1].timestamp - a_edges[i].timestamp) & a_counter_max;
+            highs++;
+        }
+    }
+
+    Averages ret;
+
+    ret.has_period = periods > 0;
+    ret.has_high   = highs > 0;
+    ret.period     = periods > 0 ? static_cast<uint32_t>((period_sum + periods / 2) / periods) : 0;
+    ret.high       = highs > 0 ? static_cast<uint32_t>((high_sum + highs / 2) / highs) : 0;
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("PWM across the 16-bit counter wrap", "[Edge_capture]")
+{
+    Edge_capture<16> capture(0, 0xFFFFu);
+
+    uint32_t period = 0;
+    uint32_t high   = 0;
+    uint32_t duty   = 0;
+    cml::frequency frequency_hz = 0;
+
+    REQUIRE(false == capture.get_period(&period));
+    REQUIRE(false == capture.get_high_time(&high));
+    REQUIRE(false == capture.get_duty_cycle(&duty));
+
+    // 1000 ticks period, 250 ticks high, starting 3000 ticks before the wrap
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        const uint32_t rise = 0xFFFFu - 3000u + i * 1000u;
+
+        capture.push(Level::high, rise & 0xFFFFu);
+        capture.push(Level::low, (rise + 250u) & 0xFFFFu);
+    }
+
+    REQUIRE(16 == capture.get_count());
+    REQUIRE(true == capture.get_period(&period));
+    REQUIRE(1000 == period);
+    REQUIRE(true == capture.get_high_time(&high));
+    REQUIRE(250 == high);
+    REQUIRE(true == capture.get_duty_cycle(&duty));
+    REQUIRE(2500 == duty);
+    REQUIRE(true == capture.get_frequency_hz(1000000u, &frequency_hz));
+    REQUIRE(1000 == frequency_hz);
+
+    capture.clear();
+
+    REQUIRE(0 == capture.get_count());
+    REQUIRE(false == capture.get_period(&period));
+}
+
+TEST_CASE("latency, ring order and the first edges", "[Edge_capture]")
+{
+    Edge_capture<4> capture(14, 0xFFFFu);
+
+    // starts with a falling edge: no interval until a rising one
+    capture.push(Level::low, 5);
+
+    REQUIRE(0xFFF7u == capture.get_edge(0).timestamp);
+
+    uint32_t ticks = 0;
+
+    capture.push(Level::high, 114);
+
+    REQUIRE(false == capture.get_period(&ticks));
+    REQUIRE(false == capture.get_high_time(&ticks));
+
+    capture.push(Level::low, 164);
+    capture.push(Level::high, 314);
+    capture.push(Level::low, 330);
+
+    // the first (falling) edge is out of the ring
+    REQUIRE(4 == capture.get_count());
+    REQUIRE(Level::low == capture.get_edge(0).level);
+    REQUIRE(316 == capture.get_edge(0).timestamp);
+    REQUIRE(100 == capture.get_edge(3).timestamp);
+
+    REQUIRE(true == capture.get_period(&ticks));
+    REQUIRE(200 == ticks);
+    REQUIRE(true == capture.get_high_time(&ticks));
+    REQUIRE(33 == ticks); // (50 + 16) / 2
+}
+
+TEST_CASE("capture callback, both edges toggle the level", "[Edge_capture]")
+{
+    Edge_capture<8> capture(0);
+
+    // the first edge after a reset is taken as falling (level unknown), no interval starts at it
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        Edge_capture<8>::capture_callback(TIM::Channel::_1, 100u * i, Capture::Edge::both, &capture);
+    }
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        REQUIRE((0 == (i & 0x1u) ? Level::high : Level::low) == capture.get_edge(i).level);
+    }
+
+    uint32_t duty = 0;
+
+    REQUIRE(true == capture.get_duty_cycle(&duty));
+    REQUIRE(5000 == duty);
+
+    // PWM input: rising on one channel, falling on the other
+    Edge_capture<8> pwm_input(0);
+
+    Edge_capture<8>::capture_callback(TIM::Channel::_1, 0, Capture::Edge::rising, &pwm_input);
+    Edge_capture<8>::capture_callback(TIM::Channel::_2, 30, Capture::Edge::falling, &pwm_input);
+    Edge_capture<8>::capture_callback(TIM::Channel::_1, 100, Capture::Edge::rising, &pwm_input);
+
+    REQUIRE(true == pwm_input.get_duty_cycle(&duty));
+    REQUIRE(3000 == duty);
+}
+
+TEST_CASE("jittered streams match the brute force reference", "[Edge_capture]")
+{
+    const uint32_t counter_max = GENERATE(0xFFFFu, 0xFFFFFFFFu);
+
+    std::mt19937 random(counter_max);
+    std::uniform_int_distribution<int32_t> jitter(-20, 20);
+
+    Edge_capture<32> capture(0, counter_max);
+    std::vector<Pushed_edge> edges;
+
+    uint32_t now = counter_max - 5000u;
+
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        // glitches: repeated levels now and then
+        const Level level = 0 == random() % 7 ? (0 == random() % 2 ? Level::high : Level::low) :
+                                                (0 == (i & 0x1u) ? Level::high : Level::low);
+
+        now += static_cast<uint32_t>(static_cast<int32_t>(level == Level::high ? 700 : 300) + jitter(random));
+
+        capture.push(level, now & counter_max);
+        edges.push_back({ level, now & counter_max });
+
+        const Averages expected = reference(edges, 32, counter_max);
+
+        uint32_t period = 0;
+        uint32_t high   = 0;
+
+        REQUIRE(expected.has_period == capture.get_period(&period));
+        REQUIRE(expected.has_high == capture.get_high_time(&high));
+        REQUIRE(expected.period == (true == expected.has_period ? period : 0));
+        REQUIRE(expected.high == (true == expected.has_high ? high : 0));
+    }
+}
+
+namespace {
+
+// interrupt simulated at the memory barriers of the readers: a_pushes edges pushed at the a_barrier-th barrier
+struct Interrupt
+{
+    static inline Edge_capture<8>* p_capture = nullptr;
+    static inline uint32_t barrier           = 0;
+    static inline uint32_t pushes            = 0;
+    static inline uint32_t now               = 0;
+    static inline uint32_t barriers          = 0;
+    static inline bool masked                = false;
+
+    static void hook()
+    {
+        masked |= 0 != host_primask;
+
+        if (barrier == barriers++)
+        {
+            host_dmb_hook = nullptr;
+
+            for (uint32_t i = 0; i < pushes; i++)
+            {
+                now += 0 == (i & 0x1u) ? 40u : 60u;
+                p_capture->push(0 == (i & 0x1u) ? Level::low : Level::high, now);
+            }
+
+            host_dmb_hook = hook;
+        }
+    }
+
+    static void arm(Edge_capture<8>* a_p_capture, uint32_t a_barrier, uint32_t a_pushes)
+    {
+        p_capture = a_p_capture;
+        barrier   = a_barrier;
+        pushes    = a_pushes;
+        barriers  = 0;
+        masked    = false;
+
+        host_dmb_hook = hook;
+    }
+};
+
+} // namespace ::
+
+TEST_CASE("readers retry when the interrupt overwrites the read entries", "[Edge_capture]")
+{
+    Edge_capture<8> capture(0);
+
+    // period 100, high 30
+    Interrupt::now = 0;
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        Interrupt::now += 0 == (i & 0x1u) ? 70u : 30u;
+        capture.push(0 == (i & 0x1u) ? Level::high : Level::low, Interrupt::now);
+    }
+
+    uint32_t ticks = 0;
+
+    SECTION("statistics")
+    {
+        // 8 edges with period 100 and high 40 pushed after head is sampled, during the pass
+        Interrupt::arm(&capture, 0, 8);
+
+        REQUIRE(true == capture.get_high_time(&ticks));
+        REQUIRE(nullptr != host_dmb_hook);
+        host_dmb_hook = nullptr;
+
+        // first pass discarded, the second one sees the new edges only
+        REQUIRE(4 == Interrupt::barriers);
+        REQUIRE(false == Interrupt::masked);
+        REQUIRE(40 == ticks);
+    }
+
+    SECTION("newest edge")
+    {
+        // one push after the read of the newest entry: 7 slots to the overwrite
+        Interrupt::arm(&capture, 1, 1);
+
+        REQUIRE(Level::low == capture.get_edge(0).level);
+        host_dmb_hook = nullptr;
+
+        REQUIRE(2 == Interrupt::barriers);
+        REQUIRE(false == Interrupt::masked);
+    }
+
+    SECTION("oldest edge")
+    {
+        const uint32_t oldest = capture.get_edge(7).timestamp;
+
+        // the read of the oldest entry is lost with any push
+        Interrupt::arm(&capture, 1, 1);
+
+        const Edge_capture<8>::Edge edge = capture.get_edge(7);
+        host_dmb_hook = nullptr;
+
+        REQUIRE(4 == Interrupt::barriers);
+        REQUIRE(false == Interrupt::masked);
+        REQUIRE(oldest + 30u == edge.timestamp);
+    }
+}
+
+TEST_CASE("pushes into free slots do not repeat the read", "[Edge_capture]")
+{
+    Edge_capture<8> capture(0);
+
+    capture.push(Level::high, 0);
+    capture.push(Level::low, 30);
+    capture.push(Level::high, 100);
+
+    // 5 free slots
+    Interrupt::now = 100;
+    Interrupt::arm(&capture, 0, 5);
+
+    uint32_t ticks = 0;
+
+    REQUIRE(true == capture.get_period(&ticks));
+    host_dmb_hook = nullptr;
+
+    REQUIRE(2 == Interrupt::barriers);
+    REQUIRE(100 == ticks);
+    REQUIRE(8 == capture.get_count());
+}
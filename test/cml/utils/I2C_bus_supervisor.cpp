@@ -0,0 +1,276 @@
+/*
+    Name: I2C_bus_supervisor.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/I2C_bus_supervisor.hpp>
+
+//std
+#include <deque>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml;
+using namespace cml::utils;
+
+using Bus_status_flag = hal::peripherals::I2C_master::Bus_status_flag;
+using Result          = hal::peripherals::I2C_master::Result;
+
+struct Pin
+{
+};
+
+// returns the injected bus status of every transaction, ok when none is left
+struct Fake_master
+{
+    using Bus_status_flag = ::Bus_status_flag;
+    using Result          = ::Result;
+
+    std::deque<Bus_status_flag> faults;
+    std::vector<char> calls; // 't'ransmit, 'r'eceive, 'w'rite-read, 'R'ecover_bus
+
+    bool recovery_result = true;
+
+    Result next(char a_call, uint32_t a_size)
+    {
+        this->calls.push_back(a_call);
+
+        Bus_status_flag status = Bus_status_flag::ok;
+
+        if (false == this->faults.empty())
+        {
+            status = this->faults.front();
+            this->faults.pop_front();
+        }
+
+        return { status, Bus_status_flag::ok == status ? a_size : 0 };
+    }
+
+    Result transmit_bytes_polling(uint16_t, const void*, uint32_t a_data_size_in_bytes, time::tick)
+    {
+        return this->next('t', a_data_size_in_bytes);
+    }
+
+    Result receive_bytes_polling(uint16_t, void*, uint32_t a_data_size_in_bytes, time::tick)
+    {
+        return this->next('r', a_data_size_in_bytes);
+    }
+
+    Result write_read_polling(uint16_t, const void*, uint32_t, void*, uint32_t a_rx_data_size_in_bytes, time::tick)
+    {
+        return this->next('w', a_rx_data_size_in_bytes);
+    }
+
+    bool recover_bus(Pin* a_p_scl, Pin* a_p_sda)
+    {
+        REQUIRE(nullptr != a_p_scl);
+        REQUIRE(nullptr != a_p_sda);
+
+        this->calls.push_back('R');
+        return this->recovery_result;
+    }
+};
+
+std::vector<time::tick> backoffs;
+
+struct Recording_delay
+{
+    static void ms(time::tick a_time)
+    {
+        backoffs.push_back(a_time);
+    }
+};
+
+using Supervisor = I2C_bus_supervisor<Fake_master, Pin, Recording_delay>;
+using Policy     = Supervisor::Retry_policy;
+
+const uint8_t data[4] = { 1, 2, 3, 4 };
+
+struct Fixture
+{
+    Fake_master master;
+    Pin scl;
+    Pin sda;
+    Supervisor supervisor;
+
+    explicit Fixture(const Policy& a_policy)
+        : supervisor(&(this->master), &(this->scl), &(this->sda), a_policy)
+    {
+        backoffs.clear();
+    }
+
+    Result transmit()
+    {
+        return this->supervisor.transmit_bytes(0x50, data, sizeof(data), 10);
+    }
+};
+
+Policy get_policy(uint32_t a_attempts, time::tick a_backoff_ms, uint32_t a_factor, time::tick a_max_backoff_ms, bool a_retry_on_nack)
+{
+    Policy policy;
+
+    policy.attempts       = a_attempts;
+    policy.backoff_ms     = a_backoff_ms;
+    policy.backoff_factor = a_factor;
+    policy.max_backoff_ms = a_max_backoff_ms;
+    policy.retry_on_nack  = a_retry_on_nack;
+
+    return policy;
+}
+
+} // namespace ::
+
+TEST_CASE("NACK is retried with a growing backoff", "[I2C_bus_supervisor]")
+{
+    Fixture f(get_policy(4, 1, 2, 50, true));
+    f.master.faults = { Bus_status_flag::nack, Bus_status_flag::nack, Bus_status_flag::nack };
+
+    const Result result = f.transmit();
+
+    REQUIRE(Bus_status_flag::ok == result.bus_status);
+    REQUIRE(sizeof(data) == result.data_length);
+    REQUIRE(f.master.calls == std::vector<char> { 't', 't', 't', 't' });
+    REQUIRE(backoffs == std::vector<time::tick> { 1, 2, 4 });
+
+    const Supervisor::Error_counters& counters = f.supervisor.get_error_counters();
+
+    REQUIRE(3 == counters.nack);
+    REQUIRE(3 == counters.retries);
+    REQUIRE(0 == counters.recoveries);
+    REQUIRE(0 == counters.failed_transactions);
+    REQUIRE(0 == counters.timeout + counters.arbitration_lost + counters.misplaced);
+}
+
+TEST_CASE("NACK without retry_on_nack fails at once", "[I2C_bus_supervisor]")
+{
+    Fixture f(get_policy(4, 1, 2, 50, false));
+    f.master.faults = { Bus_status_flag::nack };
+
+    REQUIRE(Bus_status_flag::nack == f.transmit().bus_status);
+    REQUIRE(f.master.calls == std::vector<char> { 't' });
+    REQUIRE(true == backoffs.empty());
+
+    REQUIRE(1 == f.supervisor.get_error_counters().nack);
+    REQUIRE(0 == f.supervisor.get_error_counters().retries);
+    REQUIRE(1 == f.supervisor.get_error_counters().failed_transactions);
+
+    // other errors are still retried
+    f.master.calls.clear();
+    f.master.faults = { Bus_status_flag::arbitration_lost };
+
+    REQUIRE(Bus_status_flag::ok == f.transmit().bus_status);
+    REQUIRE(f.master.calls == std::vector<char> { 't', 't' });
+    REQUIRE(1 == f.supervisor.get_error_counters().arbitration_lost);
+}
+
+TEST_CASE("timeout recovers the bus before the retry", "[I2C_bus_supervisor]")
+{
+    Fixture f(get_policy(3, 2, 3, 50, true));
+    f.master.faults = { Bus_status_flag::timeout, Bus_status_flag::timeout };
+
+    std::vector<uint8_t> rx(3);
+    const Result result = f.supervisor.write_read(0x50, data, 1, rx.data(), rx.size(), 10);
+
+    REQUIRE(Bus_status_flag::ok == result.bus_status);
+    REQUIRE(f.master.calls == std::vector<char> { 'w', 'R', 'w', 'R', 'w' });
+    REQUIRE(backoffs == std::vector<time::tick> { 2, 6 });
+
+    const Supervisor::Error_counters& counters = f.supervisor.get_error_counters();
+
+    REQUIRE(2 == counters.timeout);
+    REQUIRE(2 == counters.retries);
+    REQUIRE(2 == counters.recoveries);
+    REQUIRE(0 == counters.failed_recoveries);
+    REQUIRE(0 == counters.failed_transactions);
+}
+
+TEST_CASE("arbitration lost is retried without a recovery", "[I2C_bus_supervisor]")
+{
+    Fixture f(get_policy(3, 1, 2, 50, true));
+
+    SECTION("ARLO only")
+    {
+        f.master.faults = { Bus_status_flag::arbitration_lost };
+
+        std::vector<uint8_t> rx(2);
+        REQUIRE(Bus_status_flag::ok == f.supervisor.receive_bytes(0x50, rx.data(), rx.size(), 10).bus_status);
+        REQUIRE(f.master.calls == std::vector<char> { 'r', 'r' });
+        REQUIRE(1 == f.supervisor.get_error_counters().arbitration_lost);
+        REQUIRE(0 == f.supervisor.get_error_counters().recoveries);
+    }
+
+    SECTION("ARLO with a misplaced START/STOP")
+    {
+        f.master.faults = { Bus_status_flag::arbitration_lost | Bus_status_flag::misplaced };
+
+        REQUIRE(Bus_status_flag::ok == f.transmit().bus_status);
+        REQUIRE(f.master.calls == std::vector<char> { 't', 'R', 't' });
+        REQUIRE(1 == f.supervisor.get_error_counters().arbitration_lost);
+        REQUIRE(1 == f.supervisor.get_error_counters().misplaced);
+        REQUIRE(1 == f.supervisor.get_error_counters().recoveries);
+    }
+
+    REQUIRE(1 == f.supervisor.get_error_counters().retries);
+    REQUIRE(backoffs == std::vector<time::tick> { 1 });
+}
+
+TEST_CASE("backoff is limited and all attempts can fail", "[I2C_bus_supervisor]")
+{
+    Fixture f(get_policy(6, 1, 2, 5, true));
+    f.master.faults = { Bus_status_flag::nack,
+                        Bus_status_flag::arbitration_lost,
+                        Bus_status_flag::timeout,
+                        Bus_status_flag::nack,
+                        Bus_status_flag::misplaced,
+                        Bus_status_flag::timeout };
+    f.master.recovery_result = false;
+
+    const Result result = f.transmit();
+
+    REQUIRE(Bus_status_flag::timeout == result.bus_status);
+    REQUIRE(0 == result.data_length);
+    REQUIRE(f.master.calls == std::vector<char> { 't', 't', 't', 'R', 't', 't', 'R', 't' });
+    REQUIRE(backoffs == std::vector<time::tick> { 1, 2, 4, 5, 5 });
+
+    const Supervisor::Error_counters& counters = f.supervisor.get_error_counters();
+
+    REQUIRE(2 == counters.nack);
+    REQUIRE(1 == counters.arbitration_lost);
+    REQUIRE(2 == counters.timeout);
+    REQUIRE(1 == counters.misplaced);
+    REQUIRE(5 == counters.retries);
+    REQUIRE(2 == counters.recoveries);
+    REQUIRE(2 == counters.failed_recoveries);
+    REQUIRE(1 == counters.failed_transactions);
+
+    f.supervisor.reset_error_counters();
+    REQUIRE(0 == f.supervisor.get_error_counters().retries);
+    REQUIRE(0 == f.supervisor.get_error_counters().failed_transactions);
+}
+
+TEST_CASE("zero backoff and the explicit recovery", "[I2C_bus_supervisor]")
+{
+    Fixture f(get_policy(2, 0, 2, 5, true));
+    f.master.faults = { Bus_status_flag::crc_error, Bus_status_flag::buffer_error };
+
+    REQUIRE(Bus_status_flag::buffer_error == f.transmit().bus_status);
+    REQUIRE(true == backoffs.empty());
+    REQUIRE(1 == f.supervisor.get_error_counters().crc_error);
+    REQUIRE(1 == f.supervisor.get_error_counters().buffer_error);
+    REQUIRE(1 == f.supervisor.get_error_counters().retries);
+
+    REQUIRE(true == f.supervisor.recover());
+    f.master.recovery_result = false;
+    REQUIRE(false == f.supervisor.recover());
+
+    REQUIRE(f.master.calls == std::vector<char> { 't', 't', 'R', 'R' });
+    REQUIRE(2 == f.supervisor.get_error_counters().recoveries);
+    REQUIRE(1 == f.supervisor.get_error_counters().failed_recoveries);
+}
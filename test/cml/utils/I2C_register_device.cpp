@@ -0,0 +1,296 @@
+/*
+    Name: I2C_register_device.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/I2C_register_device.hpp>
+
+//std
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::utils;
+
+// 0x20 - status, 0x21-0x2E - configuration, 0x2F - data
+struct Register_map
+{
+    static constexpr uint8_t first  = 0x20;
+    static constexpr uint32_t count = 16;
+
+    static constexpr bool is_volatile(uint8_t a_register)
+    {
+        return 0x20 == a_register || 0x2F == a_register;
+    }
+};
+
+// slave with 8-bit registers and auto-incremented register address, counts the bus transactions
+struct Fake_slave
+{
+    using Bus_status_flag = cml::hal::peripherals::I2C_master::Bus_status_flag;
+    using Result          = cml::hal::peripherals::I2C_master::Result;
+
+    struct Write
+    {
+        uint8_t first_register;
+        std::vector<uint8_t> data;
+    };
+
+    uint16_t address = 0x1E;
+    uint8_t registers[0x100];
+
+    uint32_t transmits   = 0;
+    uint32_t write_reads = 0;
+    std::vector<Write> writes;
+    std::vector<uint32_t> reads_of; // first register of every bus read
+
+    Bus_status_flag status = Bus_status_flag::ok;
+
+    Fake_slave()
+    {
+        for (uint32_t i = 0; i < sizeof(this->registers); i++)
+        {
+            this->registers[i] = static_cast<uint8_t>(i ^ 0xA5u);
+        }
+    }
+
+    Result transmit_bytes_polling(uint16_t a_slave_address, const void* a_p_data, uint32_t a_data_size_in_bytes, cml::time::tick)
+    {
+        REQUIRE(this->address == a_slave_address);
+        REQUIRE(a_data_size_in_bytes >= 2);
+
+        this->transmits++;
+
+        if (Bus_status_flag::ok != this->status)
+        {
+            return { this->status, 0 };
+        }
+
+        const uint8_t* p_data = static_cast<const uint8_t*>(a_p_data);
+        this->writes.push_back({ p_data[0], std::vector<uint8_t>(p_data + 1, p_data + a_data_size_in_bytes) });
+
+        for (uint32_t i = 1; i < a_data_size_in_bytes; i++)
+        {
+            this->registers[(p_data[0] + i - 1) & 0xFFu] = p_data[i];
+        }
+
+        return { Bus_status_flag::ok, a_data_size_in_bytes };
+    }
+
+    Result write_read_polling(uint16_t a_slave_address,
+                              const void* a_p_tx_data,
+                              uint32_t a_tx_data_size_in_bytes,
+                              void* a_p_rx_data,
+                              uint32_t a_rx_data_size_in_bytes,
+                              cml::time::tick)
+    {
+        REQUIRE(this->address == a_slave_address);
+        REQUIRE(1 == a_tx_data_size_in_bytes);
+
+        this->write_reads++;
+
+        if (Bus_status_flag::ok != this->status)
+        {
+            return { this->status, 0 };
+        }
+
+        const uint8_t first = *static_cast<const uint8_t*>(a_p_tx_data);
+        this->reads_of.push_back(first);
+
+        for (uint32_t i = 0; i < a_rx_data_size_in_bytes; i++)
+        {
+            static_cast<uint8_t*>(a_p_rx_data)[i] = this->registers[(first + i) & 0xFFu];
+        }
+
+        return { Bus_status_flag::ok, a_rx_data_size_in_bytes };
+    }
+
+    uint32_t get_bus_transactions() const
+    {
+        return this->transmits + this->write_reads;
+    }
+};
+
+using Device = I2C_register_device<Register_map, Fake_slave>;
+
+} // namespace ::
+
+TEST_CASE("non-volatile registers are cached", "[I2C_register_device]")
+{
+    Fake_slave slave;
+    Device device(&slave, slave.address, 10);
+    uint8_t value = 0;
+
+    REQUIRE(true == device.read(0x24, &value));
+    REQUIRE((0x24 ^ 0xA5) == value);
+    REQUIRE(1 == slave.write_reads);
+
+    slave.registers[0x24] = 0x00;
+
+    REQUIRE(true == device.read(0x24, &value));
+    REQUIRE((0x24 ^ 0xA5) == value);
+    REQUIRE(1 == slave.write_reads);
+
+    uint8_t values[4] = { 0 };
+
+    // 0x23 not cached yet, the whole range is read (and 0x24 refreshed)
+    REQUIRE(true == device.read(0x23, values, 2));
+    REQUIRE(2 == slave.write_reads);
+    REQUIRE((0x23 ^ 0xA5) == values[0]);
+    REQUIRE(0x00 == values[1]);
+
+    REQUIRE(true == device.read(0x23, values, 2));
+    REQUIRE(2 == slave.write_reads);
+
+    slave.registers[0x24] = 0x42;
+    device.invalidate();
+
+    REQUIRE(true == device.read(0x24, &value));
+    REQUIRE(0x42 == value);
+    REQUIRE(3 == slave.write_reads);
+    REQUIRE(slave.get_bus_transactions() == device.get_bus_transactions());
+}
+
+TEST_CASE("volatile registers are always read from the bus", "[I2C_register_device]")
+{
+    Fake_slave slave;
+    Device device(&slave, slave.address, 10);
+    uint8_t value = 0;
+
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        slave.registers[0x20] = i;
+
+        REQUIRE(true == device.read(0x20, &value));
+        REQUIRE(i == value);
+    }
+
+    REQUIRE(5 == slave.write_reads);
+
+    // a range with a volatile register is never served from the cache
+    uint8_t values[3] = { 0 };
+
+    REQUIRE(true == device.read(0x2D, values, 3));
+    slave.registers[0x2F] = 0x77;
+    REQUIRE(true == device.read(0x2D, values, 3));
+
+    REQUIRE(7 == slave.write_reads);
+    REQUIRE(0x77 == values[2]);
+
+    // the non-volatile part of the range is cached
+    REQUIRE(true == device.read(0x2E, &value));
+    REQUIRE(7 == slave.write_reads);
+
+    // volatile writes go straight to the bus, also when the value does not change
+    REQUIRE(true == device.write(0x2F, 0x11));
+    REQUIRE(true == device.write(0x2F, 0x11));
+    REQUIRE(2 == slave.transmits);
+    REQUIRE(false == device.is_dirty());
+
+    REQUIRE(slave.reads_of == std::vector<uint32_t> { 0x20, 0x20, 0x20, 0x20, 0x20, 0x2D, 0x2D });
+    REQUIRE(slave.get_bus_transactions() == device.get_bus_transactions());
+}
+
+TEST_CASE("unchanged shadow writes cause no bus transaction", "[I2C_register_device]")
+{
+    Fake_slave slave;
+    Device device(&slave, slave.address, 10);
+    uint8_t value = 0;
+
+    REQUIRE(true == device.read(0x22, &value));
+    REQUIRE(1 == device.get_bus_transactions());
+
+    // same value as read
+    REQUIRE(true == device.write(0x22, value));
+    REQUIRE(false == device.is_dirty());
+    REQUIRE(true == device.flush());
+    REQUIRE(1 == device.get_bus_transactions());
+
+    REQUIRE(true == device.write(0x22, 0x10));
+    REQUIRE(true == device.flush());
+    REQUIRE(2 == device.get_bus_transactions());
+
+    // written value is cached
+    REQUIRE(true == device.write(0x22, 0x10));
+    REQUIRE(true == device.modify(0x22, 0x00, 0x10));
+    REQUIRE(false == device.is_dirty());
+    REQUIRE(true == device.flush());
+    REQUIRE(2 == device.get_bus_transactions());
+
+    REQUIRE(true == device.modify(0x22, 0x10, 0x01));
+    REQUIRE(true == device.flush());
+    REQUIRE(3 == device.get_bus_transactions());
+    REQUIRE(0x01 == slave.registers[0x22]);
+    REQUIRE(slave.get_bus_transactions() == device.get_bus_transactions());
+}
+
+TEST_CASE("flush merges contiguous dirty runs", "[I2C_register_device]")
+{
+    Fake_slave slave;
+    Device device(&slave, slave.address, 10);
+
+    // runs: 0x21-0x23, 0x25, 0x2A-0x2E
+    const uint8_t dirty[] = { 0x23, 0x21, 0x22, 0x25, 0x2E, 0x2A, 0x2B, 0x2C, 0x2D };
+
+    for (uint8_t r : dirty)
+    {
+        REQUIRE(true == device.write(r, static_cast<uint8_t>(r + 1)));
+    }
+
+    REQUIRE(0 == device.get_bus_transactions());
+    REQUIRE(true == device.is_dirty());
+
+    REQUIRE(true == device.flush());
+
+    REQUIRE(3 == device.get_bus_transactions());
+    REQUIRE(3 == slave.writes.size());
+
+    REQUIRE(0x21 == slave.writes[0].first_register);
+    REQUIRE(slave.writes[0].data == std::vector<uint8_t> { 0x22, 0x23, 0x24 });
+    REQUIRE(0x25 == slave.writes[1].first_register);
+    REQUIRE(slave.writes[1].data == std::vector<uint8_t> { 0x26 });
+    REQUIRE(0x2A == slave.writes[2].first_register);
+    REQUIRE(slave.writes[2].data == std::vector<uint8_t> { 0x2B, 0x2C, 0x2D, 0x2E, 0x2F });
+
+    REQUIRE(false == device.is_dirty());
+    REQUIRE(true == device.flush());
+    REQUIRE(3 == device.get_bus_transactions());
+
+    // dirty values are not overwritten by a bus read of the same range
+    uint8_t values[3] = { 0 };
+
+    REQUIRE(true == device.write(0x27, 0x55));
+    REQUIRE(true == device.read(0x26, values, 3));
+    REQUIRE(0x55 == values[1]);
+    REQUIRE((0x28 ^ 0xA5) == values[2]);
+    REQUIRE(true == device.is_dirty());
+}
+
+TEST_CASE("failed flush keeps the registers dirty", "[I2C_register_device]")
+{
+    Fake_slave slave;
+    Device device(&slave, slave.address, 10);
+
+    REQUIRE(true == device.write(0x21, 0x01));
+    REQUIRE(true == device.write(0x24, 0x02));
+
+    slave.status = Fake_slave::Bus_status_flag::nack;
+
+    REQUIRE(false == device.flush());
+    REQUIRE(2 == device.get_bus_transactions());
+    REQUIRE(true == device.is_dirty());
+
+    slave.status = Fake_slave::Bus_status_flag::ok;
+
+    REQUIRE(true == device.flush());
+    REQUIRE(4 == device.get_bus_transactions());
+    REQUIRE(false == device.is_dirty());
+    REQUIRE(0x01 == slave.registers[0x21]);
+    REQUIRE(0x02 == slave.registers[0x24]);
+}
@@ -0,0 +1,348 @@
+/*
+    Name: I2C_register_file.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/I2C_register_file.hpp>
+
+//std
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml::utils;
+
+// drives the registered event callbacks as the slave interrupt does
+struct Fake_slave
+{
+    using Event_callback = cml::hal::peripherals::I2C_slave::Event_callback;
+
+    Event_callback callback;
+
+    void register_event_callback(const Event_callback& a_callback)
+    {
+        this->callback = a_callback;
+    }
+
+    void unregister_event_callback()
+    {
+        this->callback = {};
+    }
+
+    void address(uint16_t a_address, bool a_read)
+    {
+        this->callback.address(a_address, a_read, this->callback.p_user_data);
+    }
+
+    void stop(bool a_tx_discarded = false)
+    {
+        this->callback.stop(a_tx_discarded, this->callback.p_user_data);
+    }
+
+    // master write: register pointer followed by the data
+    void write(uint16_t a_address, const std::vector<uint8_t>& a_bytes, bool a_stop = true)
+    {
+        this->address(a_address, false);
+
+        for (uint8_t byte : a_bytes)
+        {
+            this->callback.receive(byte, this->callback.p_user_data);
+        }
+
+        if (true == a_stop)
+        {
+            this->stop();
+        }
+    }
+
+    // master read: the peripheral loads one byte ahead, the last one is discarded at stop
+    std::vector<uint8_t> read(uint16_t a_address, uint32_t a_count)
+    {
+        std::vector<uint8_t> ret;
+
+        this->address(a_address, true);
+
+        for (uint32_t i = 0; i < a_count + 1; i++)
+        {
+            const uint8_t byte = this->callback.transmit(this->callback.p_user_data);
+
+            if (i < a_count)
+            {
+                ret.push_back(byte);
+            }
+        }
+
+        this->stop(true);
+
+        return ret;
+    }
+};
+
+using Register_file = I2C_register_file<Fake_slave>;
+using Access        = Register_file::Access;
+
+struct Write
+{
+    uint32_t range;
+    uint8_t first;
+    uint32_t count;
+
+    bool operator == (const Write& a_other) const
+    {
+        return this->range == a_other.range && this->first == a_other.first && this->count == a_other.count;
+    }
+};
+
+std::vector<Write> writes;
+
+template<uint32_t range> void on_write(uint8_t a_first_register, uint32_t a_count, void*)
+{
+    writes.push_back({ range, a_first_register, a_count });
+}
+
+/*
+    0x00-0x01: read only, identification
+    0x02-0x03: write only, command
+    0x04-0x07: read only, measurement (snapshot)
+    0x08-0x0B: read-write, configuration
+    0x0C-0x0F: outside of the ranges
+*/
+struct Device_table
+{
+    uint8_t memory[16]  = { 0xA0, 0xA1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    uint8_t snapshot[4] = { 0 };
+    uint8_t memory_2[4] = { 0x10, 0x11, 0x12, 0x13 };
+
+    Register_file::Range ranges[4];
+    Register_file::Device devices[2];
+
+    Device_table()
+    {
+        this->ranges[0].first  = 0x00;
+        this->ranges[0].count  = 2;
+        this->ranges[0].access = Access::read_only;
+
+        this->ranges[1].first          = 0x02;
+        this->ranges[1].count          = 2;
+        this->ranges[1].access         = Access::write_only;
+        this->ranges[1].write_callback = { on_write<1>, nullptr };
+
+        this->ranges[2].first      = 0x04;
+        this->ranges[2].count      = 4;
+        this->ranges[2].access     = Access::read_only;
+        this->ranges[2].p_snapshot = this->snapshot;
+
+        this->ranges[3].first          = 0x08;
+        this->ranges[3].count          = 4;
+        this->ranges[3].write_callback = { on_write<3>, nullptr };
+
+        this->devices[0].address      = 0x40;
+        this->devices[0].p_memory     = this->memory;
+        this->devices[0].memory_size  = sizeof(this->memory);
+        this->devices[0].p_ranges     = this->ranges;
+        this->devices[0].ranges_count = 4;
+
+        this->devices[1].address     = 0x41;
+        this->devices[1].p_memory    = this->memory_2;
+        this->devices[1].memory_size = sizeof(this->memory_2);
+    }
+};
+
+struct Fixture : public Device_table
+{
+    Fake_slave slave;
+    Register_file register_file;
+
+    Fixture()
+        : register_file(&(this->slave), this->devices, 2)
+    {
+        writes.clear();
+        this->register_file.enable();
+    }
+};
+
+} // namespace ::
+
+TEST_CASE("register pointer auto-increment and wrap", "[I2C_register_file]")
+{
+    Fixture f;
+
+    f.slave.write(0x40, { 0x0C, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36 });
+
+    // 0x00, 0x01 are read only
+    REQUIRE(0x31 == f.memory[0x0C]);
+    REQUIRE(0x34 == f.memory[0x0F]);
+    REQUIRE(0xA0 == f.memory[0x00]);
+    REQUIRE(0xA1 == f.memory[0x01]);
+    REQUIRE(0x02 == f.devices[0].register_pointer);
+
+    // pointer persists between transactions
+    f.slave.write(0x40, { 0x0E });
+    REQUIRE(f.slave.read(0x40, 3) == std::vector<uint8_t> { 0x33, 0x34, 0xA0 });
+    REQUIRE(f.slave.read(0x40, 1) == std::vector<uint8_t> { 0xA1 });
+
+    // pointer byte outside of the device memory
+    f.slave.write(0x40, { 0x1D });
+    REQUIRE(0x0D == f.devices[0].register_pointer);
+
+    // second device, its own pointer and memory size
+    f.slave.write(0x41, { 0x03, 0x23, 0x20 });
+    REQUIRE(f.memory_2[3] == 0x23);
+    REQUIRE(f.memory_2[0] == 0x20);
+    REQUIRE(f.slave.read(0x41, 5) == std::vector<uint8_t> { 0x11, 0x12, 0x23, 0x20, 0x11 });
+    REQUIRE(0x0D == f.devices[0].register_pointer);
+
+    REQUIRE(true == writes.empty());
+}
+
+TEST_CASE("read only and write only ranges", "[I2C_register_file]")
+{
+    Fixture f;
+
+    f.slave.write(0x40, { 0x00, 0x55, 0x56, 0x57, 0x58 });
+
+    REQUIRE(0xA0 == f.memory[0x00]);
+    REQUIRE(0xA1 == f.memory[0x01]);
+    REQUIRE(0x57 == f.memory[0x02]);
+    REQUIRE(0x58 == f.memory[0x03]);
+
+    // write only registers read as 0xFF
+    f.slave.write(0x40, { 0x00 });
+    REQUIRE(f.slave.read(0x40, 5) == std::vector<uint8_t> { 0xA0, 0xA1, 0xFF, 0xFF, 0x00 });
+
+    REQUIRE(writes == std::vector<Write> { { 1, 0x02, 2 } });
+
+    // unknown address: nothing read or written
+    f.slave.write(0x42, { 0x00, 0x99 });
+    REQUIRE(f.slave.read(0x42, 2) == std::vector<uint8_t> { 0xFF, 0xFF });
+    REQUIRE(0xA0 == f.memory[0x00]);
+    REQUIRE(0x05 == f.devices[0].register_pointer);
+}
+
+TEST_CASE("write notify ranges", "[I2C_register_file]")
+{
+    Fixture f;
+
+    SECTION("called at stop with the written part of the range")
+    {
+        f.slave.write(0x40, { 0x09, 0x01, 0x02 });
+        REQUIRE(writes == std::vector<Write> { { 3, 0x09, 2 } });
+
+        // write spanning the configuration and the registers outside of the ranges
+        f.slave.write(0x40, { 0x0A, 0x01, 0x02, 0x03 });
+        REQUIRE(writes == std::vector<Write> { { 3, 0x09, 2 }, { 3, 0x0A, 2 } });
+
+        REQUIRE(0x03 == f.memory[0x0C]);
+    }
+
+    SECTION("write into a read only register ends the written run")
+    {
+        f.slave.write(0x40, { 0x02, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 });
+
+        REQUIRE(writes == std::vector<Write> { { 1, 0x02, 2 }, { 3, 0x08, 2 } });
+        REQUIRE(0 == f.memory[0x04]);
+    }
+
+    SECTION("called at the repeated start")
+    {
+        f.slave.write(0x40, { 0x08, 0x11 }, false);
+        REQUIRE(true == writes.empty());
+
+        f.slave.address(0x40, true);
+        REQUIRE(writes == std::vector<Write> { { 3, 0x08, 1 } });
+
+        f.slave.stop();
+        REQUIRE(1 == writes.size());
+    }
+
+    SECTION("called when the pointer wraps")
+    {
+        f.slave.write(0x40, { 0x0B, 0x01, 0x02, 0x03, 0x04, 0x05 }, false);
+        REQUIRE(writes == std::vector<Write> { { 3, 0x0B, 1 } });
+
+        f.slave.stop();
+        REQUIRE(1 == writes.size());
+    }
+
+    SECTION("pointer only transaction")
+    {
+        f.slave.write(0x40, { 0x08 });
+        REQUIRE(true == writes.empty());
+    }
+}
+
+TEST_CASE("snapshot publishing", "[I2C_register_file]")
+{
+    Fixture f;
+
+    f.snapshot[0] = 0x10;
+    f.snapshot[1] = 0x20;
+    f.snapshot[2] = 0x30;
+    f.snapshot[3] = 0x40;
+
+    REQUIRE(false == f.register_file.is_publish_pending(0, 2));
+
+    f.register_file.publish(0, 2);
+
+    REQUIRE(true == f.register_file.is_publish_pending(0, 2));
+    REQUIRE(0 == f.memory[0x04]);
+
+    // copied at the address match of the device
+    f.slave.address(0x41, false);
+    REQUIRE(true == f.register_file.is_publish_pending(0, 2));
+
+    f.slave.write(0x40, { 0x04 });
+    REQUIRE(false == f.register_file.is_publish_pending(0, 2));
+    REQUIRE(f.slave.read(0x40, 4) == std::vector<uint8_t> { 0x10, 0x20, 0x30, 0x40 });
+
+    // not published: the master keeps reading the previous values
+    f.snapshot[0] = 0x11;
+
+    f.slave.write(0x40, { 0x04 });
+    REQUIRE(f.slave.read(0x40, 1) == std::vector<uint8_t> { 0x10 });
+
+    f.register_file.publish(0, 2);
+
+    f.slave.write(0x40, { 0x04 });
+    REQUIRE(f.slave.read(0x40, 1) == std::vector<uint8_t> { 0x11 });
+}
+
+TEST_CASE("register pointer rollback on the discarded byte", "[I2C_register_file]")
+{
+    Fixture f;
+
+    f.memory[0x08] = 0x81;
+    f.memory[0x09] = 0x82;
+    f.memory[0x0A] = 0x83;
+
+    f.slave.write(0x40, { 0x08 });
+
+    // 3 bytes loaded, 2 sent
+    REQUIRE(f.slave.read(0x40, 2) == std::vector<uint8_t> { 0x81, 0x82 });
+    REQUIRE(0x0A == f.devices[0].register_pointer);
+    REQUIRE(f.slave.read(0x40, 1) == std::vector<uint8_t> { 0x83 });
+
+    // rollback over the end of the device memory
+    f.slave.write(0x40, { 0x0F });
+    REQUIRE(f.slave.read(0x40, 1) == std::vector<uint8_t> { 0x00 });
+    REQUIRE(0x00 == f.devices[0].register_pointer);
+
+    f.slave.write(0x40, { 0x0E });
+    REQUIRE(f.slave.read(0x40, 2) == std::vector<uint8_t> { 0x00, 0x00 });
+    REQUIRE(0x00 == f.devices[0].register_pointer);
+
+    // stop without a discarded byte keeps the pointer
+    f.slave.address(0x40, true);
+    f.slave.callback.transmit(f.slave.callback.p_user_data);
+    f.slave.stop(false);
+    REQUIRE(0x01 == f.devices[0].register_pointer);
+
+    f.register_file.disable();
+    REQUIRE(nullptr == f.slave.callback.address);
+}
@@ -0,0 +1,71 @@
+/*
+    Name: SMBus_PEC.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/SMBus_PEC.hpp>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using cml::utils::SMBus_PEC;
+
+constexpr uint8_t get_pec(const char* a_p_string, uint8_t a_pec = 0)
+{
+    return '\0' == *a_p_string ? a_pec : get_pec(a_p_string + 1, SMBus_PEC::update(a_pec, static_cast<uint8_t>(*a_p_string)));
+}
+
+// CRC-8/SMBUS check value
+static_assert(0xF4u == get_pec("123456789"));
+
+static_assert(0x16u == SMBus_PEC::get_address_byte(0x0B, false));
+static_assert(0x17u == SMBus_PEC::get_address_byte(0x0B, true));
+
+} // namespace ::
+
+TEST_CASE("CRC-8/SMBUS check value", "[SMBus_PEC]")
+{
+    const char data[] = "123456789";
+
+    REQUIRE(0xF4u == SMBus_PEC::update(0, data, sizeof(data) - 1));
+    REQUIRE(0x5Au == SMBus_PEC::update(0x5Au, nullptr, 0));
+
+    // byte by byte gives the same result as the block update
+    uint8_t pec = 0;
+
+    for (uint32_t i = 0; i < sizeof(data) - 1; i++)
+    {
+        pec = SMBus_PEC::update(pec, static_cast<uint8_t>(data[i]));
+    }
+
+    REQUIRE(0xF4u == pec);
+
+    // the frame followed by its PEC gives 0
+    REQUIRE(0 == SMBus_PEC::update(pec, pec));
+}
+
+TEST_CASE("PEC of a read word transaction", "[SMBus_PEC]")
+{
+    // smart battery at 0x0B, Voltage() (0x09) returning 0x3E10 (15888 mV, LSB first)
+    const uint8_t command = 0x09;
+    const uint8_t data[]  = { 0x10, 0x3E };
+
+    uint8_t pec = SMBus_PEC::update(0, SMBus_PEC::get_address_byte(0x0B, false));
+    pec         = SMBus_PEC::update(pec, &command, 1);
+    pec         = SMBus_PEC::update(pec, SMBus_PEC::get_address_byte(0x0B, true));
+    pec         = SMBus_PEC::update(pec, data, sizeof(data));
+
+    REQUIRE(0x86u == pec);
+
+    // the read address byte is part of the PEC
+    const uint8_t frame[]              = { 0x16, 0x09, 0x17, 0x10, 0x3E };
+    const uint8_t frame_without_read[] = { 0x16, 0x09, 0x10, 0x3E };
+
+    REQUIRE(0x86u == SMBus_PEC::update(0, frame, sizeof(frame)));
+    REQUIRE(0xC4u == SMBus_PEC::update(0, frame_without_read, sizeof(frame_without_read)));
+}
@@ -0,0 +1,284 @@
+/*
+    Name: Timer_wheel.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Timer_wheel.hpp>
+
+//std
+#include <algorithm>
+#include <random>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace cml;
+using namespace cml::utils;
+
+struct Expiration
+{
+    uint32_t id;
+    time::tick tick;
+
+    bool operator == (const Expiration& a_other) const
+    {
+        return this->id == a_other.id && this->tick == a_other.tick;
+    }
+};
+
+struct Probe
+{
+    uint32_t id                      = 0;
+    const time::tick* p_now          = nullptr;
+    std::vector<Expiration>* p_fired = nullptr;
+};
+
+void record(void* a_p_user_data)
+{
+    const Probe* p_probe = static_cast<const Probe*>(a_p_user_data);
+    p_probe->p_fired->push_back({ p_probe->id, *(p_probe->p_now) });
+}
+
+// brute force: every timer compared with the current tick on every tick
+struct Reference
+{
+    struct Entry
+    {
+        bool active        = false;
+        time::tick expires = 0;
+        time::tick period  = 0;
+    };
+
+    std::vector<Entry> entries;
+
+    void update(time::tick a_now, std::vector<Expiration>* a_p_fired)
+    {
+        for (uint32_t i = 0; i < this->entries.size(); i++)
+        {
+            Entry& entry = this->entries[i];
+
+            if (true == entry.active && entry.expires == a_now)
+            {
+                a_p_fired->push_back({ i, a_now });
+
+                if (entry.period > 0)
+                {
+                    entry.expires += entry.period;
+                }
+                else
+                {
+                    entry.active = false;
+                }
+            }
+        }
+    }
+};
+
+template<uint32_t levels, uint32_t slot_bits>
+void compare_with_reference(uint32_t a_timers_count, uint32_t a_ticks, uint32_t a_seed)
+{
+    using Wheel = Timer_wheel<levels, slot_bits>;
+
+    Wheel wheel;
+    Reference reference;
+    time::tick now = 0;
+
+    std::vector<Software_timer> timers(a_timers_count);
+    std::vector<Probe> probes(a_timers_count);
+    std::vector<Expiration> fired;
+    std::vector<Expiration> expected;
+
+    reference.entries.resize(a_timers_count);
+
+    std::mt19937 random(a_seed);
+
+    auto start = [&](uint32_t a_id) {
+        // up to 3 x max_delay: the longest delays are cascaded again from the last level
+        const time::tick delay  = random() % (3 * Wheel::max_delay);
+        const time::tick period = 0 == random() % 3 ? 1 + random() % (2 * Wheel::max_delay) : 0;
+
+        probes[a_id] = { a_id, &now, &fired };
+        wheel.start(&(timers[a_id]), delay, period, Software_timer::Context::interrupt, { record, &(probes[a_id]) });
+        reference.entries[a_id] = { true, now + (delay > 0 ? delay : 1), period };
+    };
+
+    for (uint32_t i = 0; i < a_timers_count; i++)
+    {
+        start(i);
+    }
+
+    for (uint32_t tick = 0; tick < a_ticks; tick++)
+    {
+        now++;
+        wheel.update();
+        reference.update(now, &expected);
+
+        const uint32_t id = random() % a_timers_count;
+
+        switch (random() % 16)
+        {
+            case 0:
+            {
+                wheel.stop(&(timers[id]));
+                reference.entries[id].active = false;
+            }
+            break;
+
+            case 1:
+            {
+                start(id);
+            }
+            break;
+        }
+
+        // callbacks run in the order of the slot list, the reference in the order of ids
+        std::sort(fired.begin(), fired.end(), [](const Expiration& a_l, const Expiration& a_r) { return a_l.id < a_r.id; });
+
+        REQUIRE(expected == fired);
+        REQUIRE(now == wheel.get_time());
+
+        fired.clear();
+        expected.clear();
+    }
+
+    for (uint32_t i = 0; i < a_timers_count; i++)
+    {
+        const Reference::Entry& entry = reference.entries[i];
+
+        REQUIRE(entry.active == timers[i].is_active());
+        REQUIRE((true == entry.active ? entry.expires - now : 0) == wheel.get_remaining(timers[i]));
+
+        wheel.stop(&(timers[i]));
+    }
+}
+
+} // namespace ::
+
+TEST_CASE("expirations match the brute force reference", "[Timer_wheel]")
+{
+    SECTION("2 levels, 16 slots")
+    {
+        compare_with_reference<2, 4>(128, 60000, 1);
+    }
+
+    SECTION("3 levels, 8 slots")
+    {
+        compare_with_reference<3, 3>(256, 60000, 2);
+    }
+
+    SECTION("4 levels, 4 slots")
+    {
+        compare_with_reference<4, 2>(256, 60000, 3);
+    }
+}
+
+TEST_CASE("delays above max_delay of the default wheel", "[Timer_wheel]")
+{
+    using Wheel = Timer_wheel<>;
+
+    Wheel wheel;
+    time::tick now = 0;
+
+    std::vector<Expiration> fired;
+
+    const time::tick delays[] = { 1, 63, 64, 4095, 4096, 262143, 262144, Wheel::max_delay, Wheel::max_delay + 1,
+                                  Wheel::max_delay + 4097, 2 * Wheel::max_delay + 7 };
+
+    const uint32_t count = sizeof(delays) / sizeof(delays[0]);
+
+    Software_timer timers[count];
+    Probe probes[count];
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        probes[i] = { i, &now, &fired };
+        wheel.start(&(timers[i]), delays[i], 0, Software_timer::Context::interrupt, { record, &(probes[i]) });
+    }
+
+    while (fired.size() < count && now <= 2 * Wheel::max_delay + 7)
+    {
+        now++;
+        wheel.update();
+    }
+
+    REQUIRE(count == fired.size());
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        REQUIRE(Expiration{ i, delays[i] } == fired[i]);
+        REQUIRE(false == timers[i].is_active());
+    }
+}
+
+TEST_CASE("deferred callbacks and overruns", "[Timer_wheel]")
+{
+    Timer_wheel<2, 4> wheel;
+    Software_timer timer;
+    uint32_t calls = 0;
+
+    wheel.start(&timer, 3, 2, Software_timer::Context::deferred, { [](void* a_p_calls) { (*static_cast<uint32_t*>(a_p_calls))++; }, &calls });
+
+    // expirations at 3, 5 and 7: one pending callback, two overruns
+    for (uint32_t i = 0; i < 7; i++)
+    {
+        wheel.update();
+    }
+
+    REQUIRE(0 == calls);
+    REQUIRE(true == timer.is_pending());
+    REQUIRE(2 == timer.get_overruns_count());
+
+    REQUIRE(1 == wheel.process_deferred());
+    REQUIRE(1 == calls);
+    REQUIRE(false == timer.is_pending());
+    REQUIRE(0 == wheel.process_deferred());
+
+    wheel.update();
+    wheel.stop(&timer);
+
+    // pending callback dropped by stop
+    REQUIRE(false == timer.is_active());
+    REQUIRE(false == timer.is_pending());
+    REQUIRE(0 == host_primask);
+}
+
+TEST_CASE("10k timers", "[.benchmark][Timer_wheel]")
+{
+    constexpr uint32_t timers_count = 10000;
+
+    Timer_wheel<> wheel;
+    std::vector<Software_timer> timers(timers_count);
+    std::mt19937 random(4);
+    uint32_t calls = 0;
+
+    const Software_timer::Callback callback = { [](void* a_p_calls) { (*static_cast<uint32_t*>(a_p_calls))++; }, &calls };
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        wheel.start(&(timers[i]), 1 + random() % 100000, 1 + random() % 10000, Software_timer::Context::interrupt, callback);
+    }
+
+    BENCHMARK("start + stop")
+    {
+        const uint32_t i = random() % timers_count;
+
+        wheel.stop(&(timers[i]));
+        wheel.start(&(timers[i]), 1 + random() % 100000, 1 + random() % 10000, Software_timer::Context::interrupt, callback);
+    };
+
+    BENCHMARK("update")
+    {
+        wheel.update();
+    };
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        wheel.stop(&(timers[i]));
+    }
+}
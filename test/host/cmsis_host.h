@@ -0,0 +1,119 @@
+#pragma once
+
+/*
+    Name: cmsis_host.h
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+/*
+    Host replacement of cmsis_gcc.h (force included, its include guard is defined first): the core
+    intrinsics used by the library, portable C++ instead of Cortex-M inline assembly. PRIMASK is
+    a plain variable, so tests can check the interrupt state.
+*/
+
+#define __CMSIS_GCC_H
+
+//std
+#include <cstdint>
+
+inline uint32_t host_primask = 0;
+
+static inline void __enable_irq()
+{
+    host_primask = 0;
+}
+
+static inline void __disable_irq()
+{
+    host_primask = 1;
+}
+
+static inline uint32_t __get_PRIMASK()
+{
+    return host_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t a_primask)
+{
+    host_primask = a_primask;
+}
+
+static inline uint32_t __get_BASEPRI()
+{
+    return 0;
+}
+
+static inline void __set_BASEPRI(uint32_t) {}
+
+static inline void __NOP() {}
+static inline void __WFI() {}
+static inline void __WFE() {}
+static inline void __SEV() {}
+static inline void __ISB() {}
+static inline void __DSB() {}
+
+// called from __DMB: tests run "interrupt" code at the barriers of the lock-free readers
+inline void (*host_dmb_hook)() = nullptr;
+
+static inline void __DMB()
+{
+    if (nullptr != host_dmb_hook)
+    {
+        host_dmb_hook();
+    }
+}
+
+#define __CLZ __builtin_clz
+
+static inline uint32_t __REV(uint32_t a_value)
+{
+    return __builtin_bswap32(a_value);
+}
+
+static inline uint32_t __RBIT(uint32_t a_value)
+{
+    uint32_t ret = 0;
+
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        ret |= ((a_value >> i) & 0x1u) << (31u - i);
+    }
+
+    return ret;
+}
+
+static inline int32_t __SSAT(int32_t a_value, uint32_t a_bits)
+{
+    const int32_t max = static_cast<int32_t>((1u << (a_bits - 1)) - 1u);
+    const int32_t min = -max - 1;
+
+    return a_value > max ? max : a_value < min ? min : a_value;
+}
+
+static inline uint32_t __USAT(int32_t a_value, uint32_t a_bits)
+{
+    const int32_t max = static_cast<int32_t>((1u << a_bits) - 1u);
+
+    return static_cast<uint32_t>(a_value > max ? max : a_value < 0 ? 0 : a_value);
+}
+
+static inline uint32_t __SMLAD(uint32_t a_op1, uint32_t a_op2, uint32_t a_op3)
+{
+    const int32_t low  = static_cast<int16_t>(a_op1) * static_cast<int16_t>(a_op2);
+    const int32_t high = static_cast<int16_t>(a_op1 >> 16u) * static_cast<int16_t>(a_op2 >> 16u);
+
+    return static_cast<uint32_t>(low) + static_cast<uint32_t>(high) + a_op3;
+}
+
+static inline uint32_t __SMUAD(uint32_t a_op1, uint32_t a_op2)
+{
+    return __SMLAD(a_op1, a_op2, 0);
+}
+
+#define __PKHBT(ARG1, ARG2, ARG3) \
+    ((((uint32_t)(ARG1))) & 0x0000FFFFu) | ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000u)
+
+#define __PKHTB(ARG1, ARG2, ARG3) \
+    ((((uint32_t)(ARG1))) & 0xFFFF0000u) | ((((uint32_t)(ARG2)) >> (ARG3)) & 0x0000FFFFu)
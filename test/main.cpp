@@ -1,6 +1,28 @@
+/*
+    Name: main.cpp
 
-//externals
-#include <gtest.h>
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#define CATCH_CONFIG_RUNNER
+
+// Catch 2.12 signal handler does not build with glibc >= 2.34 (MINSIGSTKSZ is not a constant)
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 
+// before <cassert> (catch.hpp), which defines the standard assert macro
+#include <cml/debug/assert.hpp>
+
+//std
+#include <stdexcept>
+
+//externals
+#include <catch.hpp>
 
+int main(int a_argc, char* a_argv[])
+{
+    // failed assert throws: fails the test case, or is checked with REQUIRE_THROWS
+    cml::debug::assert::register_halt({ [](void*) { throw std::logic_error("assert"); }, nullptr });
 
+    return Catch::Session().run(a_argc, a_argv);
+}
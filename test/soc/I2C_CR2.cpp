@@ -0,0 +1,121 @@
+/*
+    Name: I2C_CR2.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/I2C_CR2.hpp>
+
+//std
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using soc::I2C_CR2;
+
+constexpr uint32_t get_NBYTES(uint32_t a_bytes, bool a_pec)
+{
+    return I2C_CR2::get_NBYTES_PECBYTE(a_pec, &a_bytes);
+}
+
+static_assert(0 == get_NBYTES(0, false));
+static_assert(((1u << I2C_CR2_NBYTES_Pos) | I2C_CR2_PECBYTE) == get_NBYTES(0, true));
+static_assert(I2C_CR2_NBYTES == get_NBYTES(255, false));
+static_assert((I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_PECBYTE) == get_NBYTES(255, true));
+
+struct Segments
+{
+    std::vector<uint32_t> nbytes;
+    uint32_t cr2 = 0;
+};
+
+// first CR2 word of the transfer, reloaded at every TCR while RELOAD is set
+Segments get_segments(uint32_t a_size, bool a_pec)
+{
+    I2C_TypeDef registers = {};
+    Segments ret;
+
+    registers.CR1 = true == a_pec ? I2C_CR1_PECEN | I2C_CR1_PE : I2C_CR1_PE;
+
+    uint32_t bytes_to_reload = a_size;
+    registers.CR2            = (0x50u << 1) | I2C_CR2::get_NBYTES_PECBYTE(&registers, &bytes_to_reload) | I2C_CR2_AUTOEND;
+
+    ret.nbytes.push_back((registers.CR2 & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos);
+
+    while (true == cml::is_flag(registers.CR2, I2C_CR2_RELOAD))
+    {
+        REQUIRE(ret.nbytes.size() < 8);
+
+        I2C_CR2::reload_NBYTES(&registers, &bytes_to_reload);
+        ret.nbytes.push_back((registers.CR2 & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos);
+    }
+
+    REQUIRE(0 == bytes_to_reload);
+
+    ret.cr2 = registers.CR2;
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("NBYTES reload segments", "[I2C_CR2]")
+{
+    struct Row
+    {
+        uint32_t size;
+        bool pec;
+        std::vector<uint32_t> nbytes;
+    };
+
+    const Row rows[] = {
+        { 0, false, { 0 } },
+        { 0, true, { 1 } },
+        { 255, false, { 255 } },
+        { 255, true, { 255, 1 } },
+        { 256, false, { 255, 1 } },
+        { 256, true, { 255, 2 } },
+        { 511, false, { 255, 255, 1 } },
+        { 511, true, { 255, 255, 2 } },
+        { 1000, false, { 255, 255, 255, 235 } },
+        { 1000, true, { 255, 255, 255, 236 } }
+    };
+
+    for (const Row& row : rows)
+    {
+        INFO(row.size << " bytes, PEC: " << row.pec);
+
+        const Segments segments = get_segments(row.size, row.pec);
+
+        REQUIRE(row.nbytes == segments.nbytes);
+
+        // the other CR2 fields are kept by the reloads, PECBYTE included
+        REQUIRE((0x50u << 1) == (segments.cr2 & I2C_CR2_SADD));
+        REQUIRE(I2C_CR2_AUTOEND == (segments.cr2 & I2C_CR2_AUTOEND));
+        REQUIRE((true == row.pec ? I2C_CR2_PECBYTE : 0) == (segments.cr2 & I2C_CR2_PECBYTE));
+        REQUIRE(0 == (segments.cr2 & I2C_CR2_RELOAD));
+    }
+}
+
+TEST_CASE("RELOAD set while bytes are left", "[I2C_CR2]")
+{
+    uint32_t bytes_to_reload = 511;
+
+    REQUIRE(((255u << I2C_CR2_NBYTES_Pos) | I2C_CR2_RELOAD) == I2C_CR2::get_NBYTES(&bytes_to_reload));
+    REQUIRE(256 == bytes_to_reload);
+    REQUIRE(((255u << I2C_CR2_NBYTES_Pos) | I2C_CR2_RELOAD) == I2C_CR2::get_NBYTES(&bytes_to_reload));
+    REQUIRE(1 == bytes_to_reload);
+    REQUIRE((1u << I2C_CR2_NBYTES_Pos) == I2C_CR2::get_NBYTES(&bytes_to_reload));
+    REQUIRE(0 == bytes_to_reload);
+
+    // PEC enabled in CR1 only
+    I2C_TypeDef registers = {};
+    registers.CR1         = I2C_CR1_PECEN;
+    bytes_to_reload       = 10;
+
+    REQUIRE(((11u << I2C_CR2_NBYTES_Pos) | I2C_CR2_PECBYTE) == I2C_CR2::get_NBYTES_PECBYTE(&registers, &bytes_to_reload));
+}
@@ -0,0 +1,180 @@
+/*
+    Name: I2C_timing.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/I2C_timing.hpp>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using soc::I2C_timing;
+using Mode = I2C_timing::Mode;
+
+struct Limits
+{
+    double rate_min, rate_max, sudat_min, vddat_max, l_min, h_min;
+    double rise, fall; // defaults of the solver
+};
+
+Limits get_limits(Mode a_mode)
+{
+    switch (a_mode)
+    {
+        case Mode::standard:
+            return { 80e3, 100e3, 250, 3450, 4700, 4000, 640, 20 };
+
+        case Mode::fast:
+            return { 320e3, 400e3, 100, 900, 1300, 600, 250, 100 };
+
+        default:
+            return { 800e3, 1e6, 50, 450, 500, 260, 60, 100 };
+    }
+}
+
+struct Bus
+{
+    double t_low  = 0;
+    double t_high = 0;
+    double t_scl  = 0;
+
+    bool valid = false;
+};
+
+// RM0394 "I2C timings" equations evaluated independently of the solver, double ns
+Bus check(uint32_t a_timingr, double a_clock_hz, Mode a_mode, double a_rise, double a_fall, bool a_analog_filter, uint32_t a_dnf)
+{
+    const Limits limits = get_limits(a_mode);
+
+    const double clock        = 1e9 / a_clock_hz;
+    const double presc        = ((a_timingr >> 28) + 1) * clock;
+    const double scldel       = (((a_timingr >> 20) & 0xF) + 1) * presc;
+    const double sdadel       = ((a_timingr >> 16) & 0xF) * presc;
+    const double af_delay_min = true == a_analog_filter ? 50 : 0;
+    const double af_delay_max = true == a_analog_filter ? 260 : 0;
+    const double dnf_delay    = a_dnf * clock;
+    const double tsync        = af_delay_min + dnf_delay + 2 * clock;
+    const double margin       = 1e-6;
+
+    Bus ret;
+
+    ret.t_low  = ((a_timingr & 0xFF) + 1) * presc + tsync;
+    ret.t_high = (((a_timingr >> 8) & 0xFF) + 1) * presc + tsync;
+    ret.t_scl  = ret.t_low + ret.t_high + a_rise + a_fall;
+
+    ret.valid = ret.t_low + margin >= limits.l_min && ret.t_high + margin >= limits.h_min &&
+                4 * clock < ret.t_low - af_delay_min - dnf_delay && clock < ret.t_high &&
+                scldel + margin >= a_rise + limits.sudat_min &&
+                sdadel + margin >= a_fall - af_delay_min - (a_dnf + 3) * clock &&
+                sdadel <= limits.vddat_max - a_rise - af_delay_max - (a_dnf + 4) * clock + margin &&
+                ret.t_scl + margin >= 1e9 / limits.rate_max && ret.t_scl <= 1e9 / limits.rate_min + margin;
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("tI2CCLK is not rounded", "[I2C_timing]")
+{
+    // 12.5 ns and 20.83 ns kernel clock periods, were rounded to 13 ns and 21 ns
+    const Bus standard_80 = check(I2C_timing::calculate(cml::MHz(80), Mode::standard, 0, 0).get_TIMINGR(),
+                                  80e6, Mode::standard, 0, 0, true, 0);
+    const Bus fast_80     = check(I2C_timing::calculate(cml::MHz(80), Mode::fast, 0, 0).get_TIMINGR(),
+                                  80e6, Mode::fast, 0, 0, true, 0);
+    const Bus standard_48 = check(I2C_timing::calculate(cml::MHz(48), Mode::standard, 0, 0).get_TIMINGR(),
+                                  48e6, Mode::standard, 0, 0, true, 0);
+
+    REQUIRE(0x1090C8B1u != I2C_timing::calculate(cml::MHz(80), Mode::standard, 0, 0).get_TIMINGR());
+
+    REQUIRE(true == standard_80.valid);
+    REQUIRE(standard_80.t_low >= 4700.0);
+    REQUIRE(true == fast_80.valid);
+    REQUIRE(fast_80.t_low >= 1300.0);
+    REQUIRE(true == standard_48.valid);
+    REQUIRE(standard_48.t_low >= 4700.0);
+}
+
+TEST_CASE("same SCL period as the CubeMX values", "[I2C_timing]")
+{
+    // CubeMX, 80 MHz kernel clock, analog filter, rise and fall times 0 ns
+    constexpr uint32_t cube_mx[] = { 0x10909CECu, 0x00702991u, 0x00300F33u };
+    constexpr Mode modes[]       = { Mode::standard, Mode::fast, Mode::fast_plus };
+
+    STATIC_REQUIRE(100000u == I2C_timing::calculate(cml::MHz(80), Mode::standard, 0, 0).scl_frequency_hz);
+    STATIC_REQUIRE(400000u == I2C_timing::calculate(cml::MHz(80), Mode::fast, 0, 0).scl_frequency_hz);
+    STATIC_REQUIRE(1000000u == I2C_timing::calculate(cml::MHz(80), Mode::fast_plus, 0, 0).scl_frequency_hz);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        const Bus expected = check(cube_mx[i], 80e6, modes[i], 0, 0, true, 0);
+        const Bus solved   = check(I2C_timing::calculate(cml::MHz(80), modes[i], 0, 0).get_TIMINGR(),
+                                   80e6, modes[i], 0, 0, true, 0);
+
+        REQUIRE(true == expected.valid);
+        REQUIRE(true == solved.valid);
+        REQUIRE(expected.t_scl == Approx(solved.t_scl));
+    }
+}
+
+TEST_CASE("every kernel clock meets the mode limits", "[I2C_timing]")
+{
+    const Mode mode           = GENERATE(Mode::standard, Mode::fast, Mode::fast_plus);
+    const bool analog_filter  = GENERATE(true, false);
+    const uint32_t dnf        = GENERATE(0u, 3u);
+    const bool default_timing = GENERATE(true, false);
+
+    const Limits limits = get_limits(mode);
+
+    cml::frequency last_invalid = 0;
+
+    for (cml::frequency clock_hz = cml::MHz(1); clock_hz <= cml::MHz(80); clock_hz += cml::kHz(250))
+    {
+        const I2C_timing::Result result = true == default_timing ?
+            I2C_timing::calculate(clock_hz, mode, static_cast<uint32_t>(limits.rise), static_cast<uint32_t>(limits.fall),
+                                  analog_filter, dnf) :
+            I2C_timing::calculate(clock_hz, mode, 0, 0, analog_filter, dnf);
+
+        if (true == result.valid)
+        {
+            const double rise = true == default_timing ? limits.rise : 0;
+            const double fall = true == default_timing ? limits.fall : 0;
+            const Bus bus     = check(result.get_TIMINGR(), clock_hz, mode, rise, fall, analog_filter, dnf);
+
+            INFO(clock_hz);
+            REQUIRE(true == bus.valid);
+            REQUIRE(std::abs(1e9 / bus.t_scl - result.scl_frequency_hz) <= 1.0);
+        }
+        else
+        {
+            last_invalid = clock_hz;
+        }
+    }
+
+    // enough kernel clock cycles for the filters and the tVD;DAT window, in all the combinations above
+    const cml::frequency clock_min_hz = Mode::standard == mode ? cml::MHz(4) :
+                                        Mode::fast == mode     ? cml::MHz(18) :
+                                                                 cml::MHz(54);
+    REQUIRE(last_invalid < clock_min_hz);
+}
+
+TEST_CASE("default rise and fall times", "[I2C_timing]")
+{
+    STATIC_REQUIRE(I2C_timing::calculate(cml::MHz(16), Mode::fast).get_TIMINGR() ==
+                   I2C_timing::calculate(cml::MHz(16), Mode::fast, 250, 100).get_TIMINGR());
+
+    const I2C_timing::Result result = I2C_timing::calculate(cml::MHz(16), Mode::standard);
+
+    REQUIRE(true == result.valid);
+    REQUIRE(true == check(result.get_TIMINGR(), 16e6, Mode::standard, 640, 20, true, 0).valid);
+    REQUIRE(result.scl_frequency_hz <= 100000u);
+    REQUIRE(result.scl_frequency_hz >= 95000u);
+
+    // no SDADEL meets tVD;DAT with the analog filter at 16 MHz (RM0394 uses tr = 0 and SDADEL = 0)
+    REQUIRE(false == I2C_timing::calculate(cml::MHz(16), Mode::fast_plus).valid);
+    REQUIRE(true == I2C_timing::calculate(cml::MHz(16), Mode::fast_plus, 60, 100, false).valid);
+}
@@ -0,0 +1,246 @@
+/*
+    Name: exti_lines.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/exti_lines.hpp>
+
+//std
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using soc::exti_lines;
+
+struct Event
+{
+    uint8_t line       = 0xFF;
+    bool level         = false;
+    uint32_t timestamp = 0;
+};
+
+// EXTI pending register (write 1 to clear) and the handlers of the 16 GPIO lines
+struct Exti
+{
+    uint32_t pr    = 0;
+    uint32_t lines = 0; // lines with a registered handler
+
+    uint32_t deferred     = 0;
+    uint32_t keep_pending = 0; // callbacks returning false
+    uint32_t callbacks    = 0;
+    uint32_t pr_writes    = 0;
+    uint32_t tick         = 0;
+    std::vector<uint32_t> visited;
+
+    exti_lines::Event_queue<Event, 8> queue;
+
+    // interrupt_handler of the exti_controllers
+    void interrupt(uint32_t a_group)
+    {
+        const uint32_t clear = exti_lines::dispatch(this->pr & this->lines & a_group, [this](uint32_t a_line) {
+            this->visited.push_back(a_line);
+
+            if (0 != (this->deferred & (0x1u << a_line)))
+            {
+                this->queue.push({ static_cast<uint8_t>(a_line), true, this->tick });
+                return true;
+            }
+
+            this->callbacks++;
+            return 0 == (this->keep_pending & (0x1u << a_line));
+        });
+
+        if (0 != clear)
+        {
+            this->pr &= ~clear;
+            this->pr_writes++;
+        }
+    }
+};
+
+} // namespace ::
+
+TEST_CASE("only the set bits are visited, highest first", "[exti_lines]")
+{
+    std::vector<uint32_t> visited;
+
+    const uint32_t clear = exti_lines::dispatch(0x8421u, [&](uint32_t a_line) {
+        visited.push_back(a_line);
+        return 10 != a_line;
+    });
+
+    REQUIRE(visited == std::vector<uint32_t> { 15, 10, 5, 0 });
+    REQUIRE(0x8021u == clear);
+    REQUIRE(0 == exti_lines::dispatch(0, [](uint32_t) { return true; }));
+}
+
+TEST_CASE("simulated EXTI block", "[exti_lines]")
+{
+    Exti exti;
+    exti.lines = 0x0FE1u; // 0, 5-11
+
+    SECTION("lines of other handlers stay pending")
+    {
+        exti.pr = 0x0C21u; // 0, 5, 10, 11
+
+        // EXTI9_5
+        exti.interrupt(0x03E0u);
+
+        REQUIRE(exti.visited == std::vector<uint32_t> { 5 });
+        REQUIRE(0x0C01u == exti.pr);
+        REQUIRE(1 == exti.pr_writes);
+
+        // EXTI15_10
+        exti.interrupt(0xFC00u);
+
+        REQUIRE(exti.visited == std::vector<uint32_t> { 5, 11, 10 });
+        REQUIRE(0x0001u == exti.pr);
+        REQUIRE(2 == exti.pr_writes);
+    }
+
+    SECTION("lines without a handler are not visited")
+    {
+        exti.pr = 0x0016u; // 1, 2, 4
+
+        exti.interrupt(0x0002u);
+        exti.interrupt(0x0010u);
+
+        REQUIRE(true == exti.visited.empty());
+        REQUIRE(0x0016u == exti.pr);
+        REQUIRE(0 == exti.pr_writes);
+    }
+
+    SECTION("callback returning false keeps the line pending")
+    {
+        exti.pr           = 0x03E0u;
+        exti.keep_pending = 0x0040u;
+
+        exti.interrupt(0x03E0u);
+
+        REQUIRE(5 == exti.callbacks);
+        REQUIRE(0x0040u == exti.pr);
+        REQUIRE(1 == exti.pr_writes);
+    }
+
+    SECTION("deferred lines are queued instead of calling back")
+    {
+        exti.deferred = 0x0120u; // 5, 8
+        exti.pr       = 0x03E0u;
+        exti.tick     = 42;
+
+        exti.interrupt(0x03E0u);
+
+        REQUIRE(3 == exti.callbacks);
+        REQUIRE(0 == exti.pr);
+
+        Event event;
+
+        REQUIRE(true == exti.queue.read(&event));
+        REQUIRE(8 == event.line);
+        REQUIRE(42 == event.timestamp);
+        REQUIRE(true == exti.queue.read(&event));
+        REQUIRE(5 == event.line);
+        REQUIRE(false == exti.queue.read(&event));
+    }
+}
+
+TEST_CASE("deferred events queue", "[exti_lines]")
+{
+    exti_lines::Event_queue<Event, 8> queue;
+    Event event;
+
+    REQUIRE(false == queue.read(&event));
+
+    // wraps around the buffer a few times, up to 3 events in flight
+    uint32_t next_read = 0;
+
+    for (uint32_t i = 0; i < 40; i++)
+    {
+        REQUIRE(true == queue.push({ static_cast<uint8_t>(i % 16), 0 == i % 2, i }));
+
+        if (2 == i % 3)
+        {
+            while (true == queue.read(&event))
+            {
+                REQUIRE(next_read++ == event.timestamp);
+            }
+        }
+    }
+
+    while (true == queue.read(&event))
+    {
+        REQUIRE(next_read++ == event.timestamp);
+    }
+
+    REQUIRE(40 == next_read);
+    REQUIRE(0 == queue.get_dropped_count());
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        REQUIRE((i < 8) == queue.push({ 0, false, 100 + i }));
+    }
+
+    REQUIRE(2 == queue.get_dropped_count());
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        REQUIRE(true == queue.read(&event));
+        REQUIRE(100 + i == event.timestamp);
+    }
+
+    REQUIRE(false == queue.read(&event));
+}
+
+TEST_CASE("EXTI dispatch latency", "[.benchmark][exti_lines]")
+{
+    Exti exti;
+    exti.lines = 0xFFFFu;
+
+    // previous dispatch: every line of the group checked, pending register read per line
+    auto per_line = [&](uint32_t a_group) {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            if (0 != (a_group & (0x1u << i)) && 0 != (*static_cast<volatile uint32_t*>(&(exti.pr)) & (0x1u << i)))
+            {
+                exti.callbacks++;
+                exti.pr &= ~(0x1u << i);
+            }
+        }
+    };
+
+    BENCHMARK("EXTI15_10, 1 line pending, pending mask")
+    {
+        exti.pr = 0x2000u;
+        exti.visited.clear();
+        exti.interrupt(0xFC00u);
+        return exti.pr;
+    };
+
+    BENCHMARK("EXTI15_10, 1 line pending, per line loop")
+    {
+        exti.pr = 0x2000u;
+        per_line(0xFC00u);
+        return exti.pr;
+    };
+
+    BENCHMARK("EXTI15_10, 6 lines pending, pending mask")
+    {
+        exti.pr = 0xFC00u;
+        exti.visited.clear();
+        exti.interrupt(0xFC00u);
+        return exti.pr;
+    };
+
+    BENCHMARK("EXTI15_10, 6 lines pending, per line loop")
+    {
+        exti.pr = 0xFC00u;
+        per_line(0xFC00u);
+        return exti.pr;
+    };
+}
@@ -0,0 +1,355 @@
+/*
+    Name: ADC.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/stm32l452xx/peripherals/ADC.hpp>
+
+//std
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace soc::stm32l452xx::peripherals;
+
+// DMA1 channel 1 in circular mode: HT after the first half of the buffer, TC after the second one
+struct Fake_DMA
+{
+    std::vector<uint16_t> buffer;
+    uint32_t index = 0;
+    uint32_t isr   = 0;
+
+    explicit Fake_DMA(uint32_t a_capacity)
+        : buffer(a_capacity, 0xFFFFu)
+    {
+    }
+
+    void transfer(uint16_t a_value)
+    {
+        this->buffer[this->index++] = a_value;
+
+        if (this->buffer.size() / 2 == this->index)
+        {
+            this->isr |= DMA_ISR_GIF1 | DMA_ISR_HTIF1;
+        }
+
+        if (this->buffer.size() == this->index)
+        {
+            this->isr |= DMA_ISR_GIF1 | DMA_ISR_TCIF1;
+            this->index = 0;
+        }
+    }
+
+    // adc_dma_interrupt_handler: ISR read, flags cleared, halves dispatched
+    bool interrupt(const ADC::DMA_callback& a_callback)
+    {
+        const uint32_t isr = this->isr;
+        this->isr          = 0;
+
+        return ADC::dispatch_read_dma(isr, this->buffer.data(), static_cast<uint32_t>(this->buffer.size()), a_callback);
+    }
+};
+
+struct Half
+{
+    uint32_t offset;
+    uint32_t count;
+    bool second_half;
+    std::vector<uint16_t> data;
+};
+
+struct Consumer
+{
+    const uint16_t* p_buffer = nullptr;
+    std::vector<Half> halves;
+    uint32_t stop_after      = 0xFFFFFFFFu;
+};
+
+bool record(const uint16_t* a_p_data, uint32_t a_count, bool a_second_half, void* a_p_user_data)
+{
+    Consumer* p_consumer = static_cast<Consumer*>(a_p_user_data);
+
+    p_consumer->halves.push_back({ static_cast<uint32_t>(a_p_data - p_consumer->p_buffer),
+                                   a_count,
+                                   a_second_half,
+                                   std::vector<uint16_t>(a_p_data, a_p_data + a_count) });
+
+    return p_consumer->halves.size() < p_consumer->stop_after;
+}
+
+// conversion n of channel c of the 3 channels sequence
+uint16_t get_sample(uint32_t a_conversion)
+{
+    return static_cast<uint16_t>(((a_conversion / 3) << 2) | (a_conversion % 3));
+}
+
+} // namespace ::
+
+TEST_CASE("DMA read halves in order", "[ADC]")
+{
+    // 2 x 4 scans of 3 channels
+    Fake_DMA dma(24);
+    Consumer consumer;
+    consumer.p_buffer = dma.buffer.data();
+
+    const ADC::DMA_callback callback = { record, &consumer };
+
+    uint32_t conversion = 0;
+
+    SECTION("interrupt after every half")
+    {
+        for (uint32_t i = 0; i < 60; i++)
+        {
+            dma.transfer(get_sample(conversion++));
+
+            if (0 != dma.isr)
+            {
+                REQUIRE(true == dma.interrupt(callback));
+            }
+        }
+
+        REQUIRE(5 == consumer.halves.size());
+    }
+
+    SECTION("late interrupt with both halves pending")
+    {
+        for (uint32_t i = 0; i < 24; i++)
+        {
+            dma.transfer(get_sample(conversion++));
+        }
+
+        REQUIRE((DMA_ISR_GIF1 | DMA_ISR_HTIF1 | DMA_ISR_TCIF1) == dma.isr);
+        REQUIRE(true == dma.interrupt(callback));
+
+        REQUIRE(2 == consumer.halves.size());
+    }
+
+    // every half starts with the first channel, consecutive scans, no sample lost or repeated
+    uint32_t expected = 0;
+
+    for (uint32_t h = 0; h < consumer.halves.size(); h++)
+    {
+        const Half& half = consumer.halves[h];
+
+        REQUIRE(12 == half.count);
+        REQUIRE((1 == h % 2) == half.second_half);
+        REQUIRE((true == half.second_half ? 12u : 0u) == half.offset);
+        REQUIRE(0 == (half.data[0] & 0x3u));
+
+        for (uint16_t sample : half.data)
+        {
+            REQUIRE(get_sample(expected++) == sample);
+        }
+    }
+}
+
+TEST_CASE("DMA read stop conditions", "[ADC]")
+{
+    Fake_DMA dma(8);
+    Consumer consumer;
+    consumer.p_buffer = dma.buffer.data();
+
+    const ADC::DMA_callback callback = { record, &consumer };
+
+    SECTION("callback returning false skips the pending second half")
+    {
+        consumer.stop_after = 1;
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            dma.transfer(static_cast<uint16_t>(i));
+        }
+
+        REQUIRE(false == dma.interrupt(callback));
+        REQUIRE(1 == consumer.halves.size());
+        REQUIRE(false == consumer.halves[0].second_half);
+    }
+
+    SECTION("transfer error")
+    {
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            dma.transfer(static_cast<uint16_t>(i));
+        }
+
+        dma.isr |= DMA_ISR_TEIF1;
+
+        REQUIRE(false == dma.interrupt(callback));
+        REQUIRE(true == consumer.halves.empty());
+    }
+
+    SECTION("no half flagged")
+    {
+        dma.isr = DMA_ISR_GIF1;
+
+        REQUIRE(true == dma.interrupt(callback));
+        REQUIRE(true == consumer.halves.empty());
+    }
+}
+
+TEST_CASE("DMA read throughput", "[.benchmark][ADC]")
+{
+    // 2 x 512 samples buffer, the consumer sums every half
+    Fake_DMA dma(1024);
+    uint32_t sum = 0;
+
+    const ADC::DMA_callback callback = {
+        [](const uint16_t* a_p_data, uint32_t a_count, bool, void* a_p_user_data) {
+            uint32_t* p_sum = static_cast<uint32_t*>(a_p_user_data);
+
+            for (uint32_t i = 0; i < a_count; i++)
+            {
+                (*p_sum) += a_p_data[i];
+            }
+
+            return true;
+        },
+        &sum
+    };
+
+    BENCHMARK("65536 samples, interrupt per half")
+    {
+        for (uint32_t i = 0; i < 65536; i++)
+        {
+            dma.transfer(static_cast<uint16_t>(i & 0xFFFu));
+
+            if (0 != dma.isr)
+            {
+                dma.interrupt(callback);
+            }
+        }
+
+        return sum;
+    };
+}
+
+TEST_CASE("oversampling CFGR2 encoding", "[ADC]")
+{
+    using Ratio = ADC::Oversampling::Ratio;
+
+    const uint32_t ratio = GENERATE(range(0u, 8u));
+    const uint32_t shift = GENERATE(range(0u, 9u));
+    const bool triggered = GENERATE(false, true);
+
+    const uint32_t cfgr2 = ADC::get_CFGR2_oversampling({ static_cast<Ratio>(ratio), shift, triggered });
+
+    REQUIRE(ratio == (cfgr2 & ADC_CFGR2_OVSR) >> ADC_CFGR2_OVSR_Pos);
+    REQUIRE(shift == (cfgr2 & ADC_CFGR2_OVSS) >> ADC_CFGR2_OVSS_Pos);
+    REQUIRE(triggered == (0 != (cfgr2 & ADC_CFGR2_TROVS)));
+    REQUIRE(ADC_CFGR2_ROVSE == (cfgr2 & ADC_CFGR2_ROVSE));
+    REQUIRE(0 == (cfgr2 & ~(ADC_CFGR2_OVSR | ADC_CFGR2_OVSS | ADC_CFGR2_TROVS | ADC_CFGR2_ROVSE)));
+}
+
+TEST_CASE("oversampled result fits 16 bits", "[ADC]")
+{
+    using Ratio      = ADC::Oversampling::Ratio;
+    using Resolution = ADC::Resolution;
+
+    STATIC_REQUIRE(12 == ADC::get_resolution_bits(Resolution::_12_bit));
+    STATIC_REQUIRE(10 == ADC::get_resolution_bits(Resolution::_10_bit));
+    STATIC_REQUIRE(8 == ADC::get_resolution_bits(Resolution::_8_bit));
+    STATIC_REQUIRE(6 == ADC::get_resolution_bits(Resolution::_6_bit));
+
+    STATIC_REQUIRE(true == ADC::is_oversampling_in_range(Resolution::_12_bit, { Ratio::_16, 0, false }));
+    STATIC_REQUIRE(false == ADC::is_oversampling_in_range(Resolution::_12_bit, { Ratio::_32, 0, false }));
+    STATIC_REQUIRE(true == ADC::is_oversampling_in_range(Resolution::_12_bit, { Ratio::_256, 4, false }));
+    STATIC_REQUIRE(false == ADC::is_oversampling_in_range(Resolution::_12_bit, { Ratio::_256, 3, false }));
+    STATIC_REQUIRE(true == ADC::is_oversampling_in_range(Resolution::_6_bit, { Ratio::_256, 0, false }));
+
+    // largest accumulated value shifted right against the 16-bit data register
+    const Resolution resolution = GENERATE(Resolution::_12_bit, Resolution::_10_bit, Resolution::_8_bit, Resolution::_6_bit);
+    const uint32_t ratio        = GENERATE(range(0u, 8u));
+    const uint32_t shift        = GENERATE(range(0u, 9u));
+
+    const uint32_t max_sample = (1u << ADC::get_resolution_bits(resolution)) - 1u;
+    const uint32_t max_result = (max_sample << (ratio + 1)) >> shift;
+
+    REQUIRE((max_result <= 0xFFFFu) == ADC::is_oversampling_in_range(resolution, { static_cast<Ratio>(ratio), shift, false }));
+}
+
+TEST_CASE("analog watchdog 2 and 3 thresholds", "[ADC]")
+{
+    ADC::Analog_watchdog config;
+
+    REQUIRE(((0xFFu << ADC_TR2_HT2_Pos) | (0x00u << ADC_TR2_LT2_Pos)) == ADC::get_TR2_TR3(config));
+
+    config.low_threshold  = 0x123u;
+    config.high_threshold = 0xABCu;
+
+    const uint32_t tr = ADC::get_TR2_TR3(config);
+
+    REQUIRE(0x12u == (tr & ADC_TR2_LT2) >> ADC_TR2_LT2_Pos);
+    REQUIRE(0xABu == (tr & ADC_TR2_HT2) >> ADC_TR2_HT2_Pos);
+    REQUIRE(0 == (tr & ~(ADC_TR2_LT2 | ADC_TR2_HT2)));
+    REQUIRE(ADC_TR3_LT3 == ADC_TR2_LT2);
+    REQUIRE(ADC_TR3_HT3 == ADC_TR2_HT2);
+
+    // a conversion inside the 12-bit window never leaves the 8 MSBs window
+    const uint16_t thresholds[] = { 0x000u, 0x00Fu, 0x010u, 0x7FFu, 0x800u, 0xFF0u, 0xFFFu };
+
+    for (uint16_t low : thresholds)
+    {
+        for (uint16_t high : thresholds)
+        {
+            if (low <= high)
+            {
+                config.low_threshold  = low;
+                config.high_threshold = high;
+
+                const uint32_t value  = ADC::get_TR2_TR3(config);
+                const uint32_t low_8  = (value & ADC_TR2_LT2) >> ADC_TR2_LT2_Pos;
+                const uint32_t high_8 = (value & ADC_TR2_HT2) >> ADC_TR2_HT2_Pos;
+
+                for (uint32_t data = low; data <= high; data++)
+                {
+                    REQUIRE(((data >> 4u) >= low_8 && (data >> 4u) <= high_8));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("injected sequence JSQR encoding", "[ADC]")
+{
+    using Id       = ADC::Channel::Id;
+    using Sampling = ADC::Channel::Sampling_time;
+    using Source   = ADC::Injected_trigger::Source;
+    using Edge     = ADC::Trigger::Edge;
+
+    static constexpr ADC::Channel channels[] = { { Id::_5, Sampling::_2_5_clock_cycles },
+                                                 { Id::temperature_sensor, Sampling::_640_5_clock_cycles },
+                                                 { Id::voltage_reference, Sampling::_247_5_clock_cycles },
+                                                 { Id::_16, Sampling::_2_5_clock_cycles } };
+
+    // RM0394: JL[1:0], JEXTSEL[5:2], JEXTEN[7:6], JSQ1[12:8], JSQ2[18:14], JSQ3[24:20], JSQ4[30:26]
+    STATIC_REQUIRE((0u | (5u << 8)) == ADC::get_JSQR_channels(channels, 1));
+    STATIC_REQUIRE((1u | (5u << 8) | (17u << 14)) == ADC::get_JSQR_channels(channels, 2));
+    STATIC_REQUIRE((3u | (5u << 8) | (17u << 14) | (0u << 20) | (16u << 26)) == ADC::get_JSQR_channels(channels, 4));
+
+    STATIC_REQUIRE(((0xEu << 2) | (1u << 6)) == ADC::get_JSQR_trigger({ Source::tim6_trgo, Edge::rising }));
+    STATIC_REQUIRE(((0x0u << 2) | (2u << 6)) == ADC::get_JSQR_trigger({ Source::tim1_trgo, Edge::falling }));
+    STATIC_REQUIRE(((0xFu << 2) | (3u << 6)) == ADC::get_JSQR_trigger({ Source::tim15_trgo, Edge::both }));
+
+    const uint32_t count = GENERATE(1u, 2u, 3u, 4u);
+    const uint32_t jsqr  = ADC::get_JSQR_channels(channels, count) |
+                          ADC::get_JSQR_trigger({ Source::exti_15, Edge::both });
+
+    // ADC::get_injected_channels_count
+    REQUIRE(count == (jsqr & ADC_JSQR_JL) + 1);
+    REQUIRE(0x6u == (jsqr & ADC_JSQR_JEXTSEL) >> ADC_JSQR_JEXTSEL_Pos);
+    REQUIRE(0x3u == (jsqr & ADC_JSQR_JEXTEN) >> ADC_JSQR_JEXTEN_Pos);
+
+    const uint32_t positions[] = { ADC_JSQR_JSQ1_Pos, ADC_JSQR_JSQ2_Pos, ADC_JSQR_JSQ3_Pos, ADC_JSQR_JSQ4_Pos };
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        const uint32_t expected = i < count ? static_cast<uint32_t>(channels[i].id) : 0u;
+        REQUIRE(expected == ((jsqr >> positions[i]) & 0x1Fu));
+    }
+}
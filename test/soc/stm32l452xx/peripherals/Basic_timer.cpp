@@ -0,0 +1,128 @@
+/*
+    Name: Basic_timer.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/stm32l452xx/peripherals/Basic_timer.hpp>
+
+//std
+#include <cmath>
+
+//soc
+#include <soc/stm32l452xx/peripherals/ADC.hpp>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace soc::stm32l452xx::peripherals;
+using Config = Basic_timer::Config;
+
+constexpr Config config_1kHz = Basic_timer::calculate_config(80000000u, 1000u);
+static_assert(1 == config_1kHz.prescaler && 39999u == config_1kHz.auto_reload);
+static_assert(1000u == Basic_timer::get_update_frequency_hz(80000000u, config_1kHz));
+
+// smallest prescaler with the rounded period in the 16-bit counter range
+Config get_reference(uint32_t a_clock_hz, uint32_t a_rate_hz)
+{
+    const double ticks = static_cast<double>(a_clock_hz) / a_rate_hz;
+    uint32_t prescaler = 0;
+
+    while (std::round(ticks / (prescaler + 1)) > 0x10000u)
+    {
+        prescaler++;
+    }
+
+    const uint32_t period = static_cast<uint32_t>(std::round(ticks / (prescaler + 1)));
+
+    return { static_cast<uint16_t>(prescaler), static_cast<uint16_t>(period > 1 ? period - 1 : 1) };
+}
+
+} // namespace ::
+
+TEST_CASE("calculate_config table", "[Basic_timer]")
+{
+    struct Row
+    {
+        uint32_t clock_hz, rate_hz;
+    };
+
+    const Row rows[] = {
+        { 80000000, 1 },      { 80000000, 10 },     { 80000000, 1221 },   { 80000000, 44100 },
+        { 80000000, 48000 },  { 80000000, 1000000 }, { 4000000, 1 },      { 4000000, 61 },
+        { 4000000, 62 },      { 16000000, 8000 },   { 16000000, 245 },    { 24000000, 366 },
+        { 48000000, 732 },    { 48000000, 733 },    { 100000, 3 },        { 65536, 1 },
+        { 65537, 1 },         { 131072, 1 },        { 131073, 1 },        { 1000000, 16 }
+    };
+
+    for (const Row& row : rows)
+    {
+        INFO(row.clock_hz << " Hz / " << row.rate_hz << " Hz");
+
+        const Config config    = Basic_timer::calculate_config(row.clock_hz, row.rate_hz);
+        const Config reference = get_reference(row.clock_hz, row.rate_hz);
+
+        REQUIRE(reference.prescaler == config.prescaler);
+        REQUIRE(reference.auto_reload == config.auto_reload);
+        REQUIRE(Basic_timer::Trigger_output::update == config.trigger_output);
+
+        // period rounded to the nearest count of the prescaled clock
+        const double period_s = (config.prescaler + 1.0) * (config.auto_reload + 1.0) / row.clock_hz;
+        REQUIRE(std::fabs(period_s - 1.0 / row.rate_hz) <= (config.prescaler + 1.0) / (2.0 * row.clock_hz) + 1e-12);
+    }
+}
+
+TEST_CASE("calculate_config at the counter limits", "[Basic_timer]")
+{
+    // 65536 ticks still fit without the prescaler
+    REQUIRE(0 == Basic_timer::calculate_config(65536u, 1u).prescaler);
+    REQUIRE(0xFFFFu == Basic_timer::calculate_config(65536u, 1u).auto_reload);
+    REQUIRE(1 == Basic_timer::calculate_config(65537u, 1u).prescaler);
+
+    // update rate at or above half of the clock: the shortest period (auto-reload 0 stops the counter)
+    REQUIRE(1 == Basic_timer::calculate_config(1000000u, 500000u).auto_reload);
+    REQUIRE(1 == Basic_timer::calculate_config(1000000u, 1000000u).auto_reload);
+    REQUIRE(1 == Basic_timer::calculate_config(1000000u, 3000000u).auto_reload);
+    REQUIRE(500000u == Basic_timer::get_update_frequency_hz(1000000u, Basic_timer::calculate_config(1000000u, 3000000u)));
+}
+
+TEST_CASE("TIM6 TRGO paces the ADC", "[Basic_timer]")
+{
+    TIM_TypeDef tim = {};
+    ADC_TypeDef adc = {};
+
+    tim.SR   = TIM_SR_UIF;
+    adc.CFGR = ADC_CFGR_RES_1 | ADC_CFGR_JQDIS;
+
+    const Config config = Basic_timer::calculate_config(80000000u, 48000u);
+    Basic_timer::configure(&tim, config);
+
+    REQUIRE((TIM_CR1_ARPE | TIM_CR1_URS) == tim.CR1);
+    REQUIRE((0x2u << TIM_CR2_MMS_Pos) == tim.CR2);
+    REQUIRE(config.prescaler == tim.PSC);
+    REQUIRE(1666u == tim.ARR);
+    REQUIRE(TIM_EGR_UG == tim.EGR);
+    REQUIRE(0 == tim.SR);
+    REQUIRE(0 == tim.DIER);
+
+    // ADC::set_trigger, regular conversions on the rising edge of TIM6 TRGO (EXT13)
+    cml::set_flag(&(adc.CFGR),
+                  ADC_CFGR_EXTSEL | ADC_CFGR_EXTEN,
+                  ADC::get_CFGR_trigger({ ADC::Trigger::Source::tim6_trgo, ADC::Trigger::Edge::rising }));
+
+    REQUIRE(13u == (adc.CFGR & ADC_CFGR_EXTSEL) >> ADC_CFGR_EXTSEL_Pos);
+    REQUIRE(1u == (adc.CFGR & ADC_CFGR_EXTEN) >> ADC_CFGR_EXTEN_Pos);
+    REQUIRE((ADC_CFGR_RES_1 | ADC_CFGR_JQDIS) == (adc.CFGR & ~(ADC_CFGR_EXTSEL | ADC_CFGR_EXTEN)));
+
+    // ADC::clear_trigger
+    cml::clear_flag(&(adc.CFGR), ADC_CFGR_EXTSEL | ADC_CFGR_EXTEN);
+    REQUIRE((ADC_CFGR_RES_1 | ADC_CFGR_JQDIS) == adc.CFGR);
+
+    REQUIRE((ADC_CFGR_EXTSEL_3 | ADC_CFGR_EXTSEL_2 | ADC_CFGR_EXTSEL_1 | ADC_CFGR_EXTEN) ==
+            ADC::get_CFGR_trigger({ ADC::Trigger::Source::tim15_trgo, ADC::Trigger::Edge::both }));
+    REQUIRE(ADC_CFGR_EXTEN_1 == ADC::get_CFGR_trigger({ ADC::Trigger::Source::tim1_cc1, ADC::Trigger::Edge::falling }));
+}
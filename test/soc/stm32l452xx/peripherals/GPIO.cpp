@@ -0,0 +1,418 @@
+/*
+    Name: GPIO.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/stm32l452xx/peripherals/GPIO.hpp>
+
+//std
+#include <string>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace soc::stm32l452xx::peripherals;
+
+using Led    = Static_out<GPIO::Id::a, 5>;
+using Button = Static_in<GPIO::Id::c, 13>;
+using Sda    = Static_out<GPIO::Id::b, 5>;
+using Input  = Static_in<GPIO::Id::a, 5>;
+
+static_assert(Led::mask == 0x20u && Led::key == 5u && Button::key == 2u * 16u + 13u);
+
+static_assert(true == unique_pins_v<>);
+static_assert(true == unique_pins_v<Led>);
+static_assert(true == unique_pins_v<Led, Button, Sda>);
+static_assert(false == unique_pins_v<Led, Led>);
+static_assert(false == unique_pins_v<Led, Button, Input>);
+static_assert(2u == pins_count_v<Led::key, Led, Button, Input>);
+
+using Type  = pin::table::Type;
+using Entry = pin::table::Entry;
+using Image = pin::table::Image;
+
+constexpr Entry entries[] = {
+    { 5,  Type::out,    pin::Mode::push_pull,  pin::Pull::none, pin::Speed::low,  pin::Level::high, 0 },
+    { 9,  Type::af,     pin::Mode::open_drain, pin::Pull::up,   pin::Speed::high, pin::Level::low,  4 },
+    { 0,  Type::analog, pin::Mode::push_pull,  pin::Pull::none, pin::Speed::low,  pin::Level::low,  0 },
+    { 13, Type::in,     pin::Mode::push_pull,  pin::Pull::down, pin::Speed::low,  pin::Level::low,  0 },
+    { 2,  Type::out,    pin::Mode::push_pull,  pin::Pull::none, pin::Speed::low,  pin::Level::low,  0 }
+};
+
+constexpr Image image = pin::table::get_image(entries);
+
+static_assert(true == image.valid);
+static_assert(0x00002225u == image.pins);
+static_assert(0x00080413u == image.moder);
+static_assert(0x00000200u == image.otyper);
+static_assert(0x00080000u == image.ospeedr);
+static_assert(0x08040000u == image.pupdr);
+static_assert(0x00040020u == image.bsrr);
+static_assert(0x00000000u == image.afr[0] && 0x00000040u == image.afr[1]);
+static_assert(0x00000000u == image.afr_mask[0] && 0x000000F0u == image.afr_mask[1]);
+
+constexpr bool is_valid(const Entry* a_p_entries, uint32_t a_count)
+{
+    return pin::table::get_image(a_p_entries, a_count).valid;
+}
+
+constexpr Entry duplicate[]        = { { 3, Type::out }, { 4, Type::in }, { 3, Type::analog } };
+constexpr Entry id_out_of_range[]  = { { 16, Type::in } };
+constexpr Entry function_too_big[] = { { 1, Type::af, pin::Mode::push_pull, pin::Pull::none, pin::Speed::low, pin::Level::low, 16 } };
+constexpr Entry unknown_pull[]     = { { 1, Type::in, pin::Mode::push_pull, pin::Pull::unknown } };
+constexpr Entry unknown_mode[]     = { { 1, Type::out, pin::Mode::unknown } };
+constexpr Entry unknown_speed[]    = { { 1, Type::out, pin::Mode::push_pull, pin::Pull::none, pin::Speed::unknown } };
+
+static_assert(false == is_valid(duplicate, 3));
+static_assert(true == is_valid(duplicate, 2));
+static_assert(false == is_valid(id_out_of_range, 1));
+static_assert(false == is_valid(function_too_big, 1));
+static_assert(false == is_valid(unknown_pull, 1));
+static_assert(false == is_valid(unknown_mode, 1));
+static_assert(false == is_valid(unknown_speed, 1));
+
+constexpr Image empty = pin::table::get_image(entries, 0);
+
+static_assert(true == empty.valid && 0 == empty.pins && 0 == empty.moder && 0 == empty.bsrr);
+
+} // namespace ::
+
+TEST_CASE("pin table image of a runtime table", "[GPIO]")
+{
+    Entry runtime_entries[16];
+
+    // every pin an alternate function, AFR nibbles 0 - 15
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        runtime_entries[i] = { i, Type::af, pin::Mode::push_pull, pin::Pull::none, pin::Speed::ultra, pin::Level::low, i };
+    }
+
+    const Image runtime_image = pin::table::get_image(runtime_entries);
+
+    REQUIRE(true == runtime_image.valid);
+    REQUIRE(0xFFFFu == runtime_image.pins);
+    REQUIRE(0xAAAAAAAAu == runtime_image.moder);
+    REQUIRE(0xFFFFFFFFu == runtime_image.ospeedr);
+    REQUIRE(0x76543210u == runtime_image.afr[0]);
+    REQUIRE(0xFEDCBA98u == runtime_image.afr[1]);
+    REQUIRE(0xFFFFFFFFu == runtime_image.afr_mask[0]);
+    REQUIRE(0xFFFFFFFFu == runtime_image.afr_mask[1]);
+    REQUIRE(0u == runtime_image.bsrr);
+
+    // the first invalid entry stops the fold
+    runtime_entries[7].id = 3;
+
+    REQUIRE(false == pin::table::get_image(runtime_entries).valid);
+}
+
+TEST_CASE("typed pin keys", "[GPIO]")
+{
+    REQUIRE(GPIO::Id::c == Button::get_port_id());
+    REQUIRE(13u == Button::get_id());
+}
+
+namespace {
+
+// ODR after the BSRR store, as the port applies it (set wins over reset)
+uint32_t apply_BSRR(uint32_t a_odr, uint32_t a_bsrr)
+{
+    return ((a_odr & ~(a_bsrr >> 16u)) | a_bsrr) & 0xFFFFu;
+}
+
+} // namespace ::
+
+TEST_CASE("pin bus write", "[GPIO]")
+{
+    GPIO_TypeDef registers = {};
+    pin::Bus bus;
+
+    SECTION("contiguous pins")
+    {
+        const uint8_t ids[] = { 4, 5, 6, 7 };
+        pin::bus::bind(&registers, ids, 4, &bus);
+
+        REQUIRE(0x00F0u == bus.get_mask());
+        REQUIRE(4u == bus.get_width());
+
+        bus.write(0xA);
+        REQUIRE(((0x5u << 4) << 16u | (0xAu << 4)) == registers.BSRR);
+
+        bus.write(0x0);
+        REQUIRE((0x00F0u << 16u) == registers.BSRR);
+
+        // bits above the width are dropped
+        bus.write(0x1F);
+        REQUIRE(0x00F0u == registers.BSRR);
+    }
+
+    SECTION("scattered pins")
+    {
+        const uint8_t ids[] = { 15, 0, 9, 3 };
+        pin::bus::bind(&registers, ids, 4, &bus);
+
+        REQUIRE(0x8209u == bus.get_mask());
+
+        // bit i of the value is the pin ids[i]
+        bus.write(0x5);
+        REQUIRE((0x0009u << 16u | 0x8200u) == registers.BSRR);
+
+        bus.write(0xA);
+        REQUIRE((0x8200u << 16u | 0x0009u) == registers.BSRR);
+    }
+
+    SECTION("every value on the port")
+    {
+        const uint8_t ids[] = { 1, 2, 8, 11, 12, 13 };
+        pin::bus::bind(&registers, ids, 6, &bus);
+
+        // pins outside of the bus keep their level
+        uint32_t odr = 0x4001u;
+
+        for (uint32_t value = 0; value < 64; value++)
+        {
+            bus.write(value);
+
+            const uint32_t bsrr = registers.BSRR;
+
+            // every bus pin is either set or reset in the same word
+            REQUIRE(bus.get_mask() == ((bsrr & 0xFFFFu) | (bsrr >> 16u)));
+            REQUIRE(0 == ((bsrr & 0xFFFFu) & (bsrr >> 16u)));
+
+            odr           = apply_BSRR(odr, bsrr);
+            registers.IDR = odr;
+
+            REQUIRE(0x4001u == (odr & ~bus.get_mask()));
+            REQUIRE(value == bus.read());
+        }
+    }
+
+    // no read-modify-write of the other registers
+    REQUIRE(0 == registers.ODR);
+    REQUIRE(0 == registers.MODER);
+}
+
+TEST_CASE("pin bus read", "[GPIO]")
+{
+    GPIO_TypeDef registers = {};
+    pin::Bus bus;
+
+    SECTION("contiguous pins")
+    {
+        const uint8_t ids[] = { 8, 9, 10, 11, 12, 13, 14, 15 };
+        pin::bus::bind(&registers, ids, 8, &bus);
+
+        registers.IDR = 0xA5FFu;
+        REQUIRE(0xA5u == bus.read());
+
+        registers.IDR = 0x00FFu;
+        REQUIRE(0x00u == bus.read());
+    }
+
+    SECTION("scattered pins")
+    {
+        const uint8_t ids[] = { 15, 0, 9, 3 };
+        pin::bus::bind(&registers, ids, 4, &bus);
+
+        registers.IDR = 0x8000u;
+        REQUIRE(0x1u == bus.read());
+
+        registers.IDR = 0x0009u;
+        REQUIRE(0xAu == bus.read());
+
+        registers.IDR = 0x7DF6u;
+        REQUIRE(0x0u == bus.read());
+    }
+}
+
+TEST_CASE("pin bus direction", "[GPIO]")
+{
+    GPIO_TypeDef registers = {};
+    pin::Bus bus;
+
+    const uint8_t ids[] = { 0, 7, 15 };
+    pin::bus::bind(&registers, ids, 3, &bus);
+
+    // other pins: analog and alternate function
+    registers.MODER = 0xFFFFFFFFu;
+
+    bus.set_direction(pin::Bus::Direction::in);
+    REQUIRE(0x3FFF3FFCu == registers.MODER);
+
+    bus.set_direction(pin::Bus::Direction::out);
+    REQUIRE(0x7FFF7FFDu == registers.MODER);
+
+    registers.MODER = 0xAAAAAAAAu;
+
+    bus.set_direction(pin::Bus::Direction::out);
+    REQUIRE(0x6AAA6AA9u == registers.MODER);
+}
+
+TEST_CASE("pin bus map", "[GPIO]")
+{
+    GPIO_TypeDef registers = {};
+    pin::Bus bus;
+
+    const uint8_t duplicate[]       = { 1, 2, 1 };
+    const uint8_t id_out_of_range[] = { 3, 16 };
+
+    REQUIRE_THROWS(pin::bus::bind(&registers, duplicate, 3, &bus));
+    REQUIRE_THROWS(pin::bus::bind(&registers, id_out_of_range, 2, &bus));
+    REQUIRE_THROWS(pin::bus::bind(&registers, duplicate, 0, &bus));
+}
+
+TEST_CASE("pin bus throughput", "[.benchmark][GPIO]")
+{
+    GPIO_TypeDef registers = {};
+
+    const uint8_t contiguous_ids[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    const uint8_t scattered_ids[]  = { 0, 2, 3, 6, 9, 10, 13, 15 };
+
+    pin::Bus contiguous;
+    pin::Bus scattered;
+
+    pin::bus::bind(&registers, contiguous_ids, 8, &contiguous);
+    pin::bus::bind(&registers, scattered_ids, 8, &scattered);
+
+    // 64 KiB byte stream, bytes/s = 65536 / mean
+    BENCHMARK("65536 bytes, contiguous pins")
+    {
+        for (uint32_t i = 0; i < 65536; i++)
+        {
+            contiguous.write(i & 0xFFu);
+        }
+
+        return registers.BSRR;
+    };
+
+    BENCHMARK("65536 bytes, scattered pins")
+    {
+        for (uint32_t i = 0; i < 65536; i++)
+        {
+            scattered.write(i & 0xFFu);
+        }
+
+        return registers.BSRR;
+    };
+}
+
+namespace {
+
+std::string write_order;
+
+// register counting its reads and writes, the writes are logged by name
+struct Counting_register
+{
+    char name      = ' ';
+    uint32_t value = 0;
+
+    mutable uint32_t reads = 0;
+    uint32_t writes        = 0;
+
+    operator uint32_t() const
+    {
+        this->reads++;
+        return this->value;
+    }
+
+    Counting_register& operator = (uint32_t a_value)
+    {
+        this->writes++;
+        this->value = a_value;
+        write_order.push_back(this->name);
+
+        return *this;
+    }
+};
+
+struct Counting_registers
+{
+    Counting_register MODER;
+    Counting_register OTYPER;
+    Counting_register OSPEEDR;
+    Counting_register PUPDR;
+    Counting_register BSRR;
+    Counting_register AFR[2];
+
+    Counting_registers()
+    {
+        this->MODER.name   = 'M';
+        this->OTYPER.name  = 'T';
+        this->OSPEEDR.name = 'S';
+        this->PUPDR.name   = 'P';
+        this->BSRR.name    = 'B';
+        this->AFR[0].name  = 'L';
+        this->AFR[1].name  = 'H';
+
+        // reset values of port A
+        this->MODER.value   = 0xABFFFFFFu;
+        this->OSPEEDR.value = 0x0C000000u;
+        this->PUPDR.value   = 0x64000000u;
+
+        write_order.clear();
+    }
+};
+
+} // namespace ::
+
+TEST_CASE("pin table register writes", "[GPIO]")
+{
+    Counting_registers registers;
+
+    // pin 3 already taken, bit 31: port enabled
+    const uint32_t taken = pin::table::apply(&registers, 0x80000008u, image);
+
+    REQUIRE((0x80000008u | image.pins) == taken);
+
+    // one store of BSRR, one read-modify-write of the others, AFRL not used by the table
+    REQUIRE("BTSPHM" == write_order);
+    REQUIRE(0 == registers.BSRR.reads);
+    REQUIRE(1 == registers.BSRR.writes);
+
+    for (const Counting_register* p_register : { &registers.MODER, &registers.OTYPER, &registers.OSPEEDR, &registers.PUPDR, &registers.AFR[1] })
+    {
+        INFO(p_register->name);
+
+        REQUIRE(1 == p_register->reads);
+        REQUIRE(1 == p_register->writes);
+    }
+
+    REQUIRE(0 == registers.AFR[0].reads + registers.AFR[0].writes);
+
+    // pins 0, 2, 5, 9, 13 replaced, the rest keeps the reset values
+    REQUIRE(0x00040020u == registers.BSRR.value);
+    REQUIRE(0xA3FBF7DFu == registers.MODER.value);
+    REQUIRE(0x00000200u == registers.OTYPER.value);
+    REQUIRE(0x00080000u == registers.OSPEEDR.value);
+    REQUIRE(0x68040000u == registers.PUPDR.value);
+    REQUIRE(0x00000040u == registers.AFR[1].value);
+}
+
+TEST_CASE("pin table conflicts with taken pins", "[GPIO]")
+{
+    Counting_registers registers;
+
+    // pin 9 taken by a pin::af or pin::bus
+    REQUIRE_THROWS(pin::table::apply(&registers, 0x80000200u, image));
+
+    // invalid image
+    constexpr Entry duplicate_pin[] = { { 3, Type::out }, { 3, Type::in } };
+    REQUIRE_THROWS(pin::table::apply(&registers, 0x80000000u, pin::table::get_image(duplicate_pin)));
+
+    // nothing written
+    REQUIRE(true == write_order.empty());
+
+    // table after table on the same port
+    constexpr Entry first[]  = { { 0, Type::out }, { 1, Type::out } };
+    constexpr Entry second[] = { { 2, Type::in }, { 1, Type::in } };
+
+    const uint32_t taken = pin::table::apply(&registers, 0x80000000u, pin::table::get_image(first));
+
+    REQUIRE(0x80000003u == taken);
+    REQUIRE_THROWS(pin::table::apply(&registers, taken, pin::table::get_image(second)));
+    REQUIRE(0x80000007u == pin::table::apply(&registers, taken, pin::table::get_image(second, 1)));
+}
@@ -0,0 +1,361 @@
+/*
+    Name: I2C_transaction_queue.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/stm32l452xx/peripherals/I2C_transaction_queue.hpp>
+
+//std
+#include <algorithm>
+#include <vector>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using namespace soc::stm32l452xx::peripherals;
+
+using Priority    = I2C_transaction_queue::Priority;
+using Statistics  = I2C_transaction_queue::Statistics;
+using Transaction = I2C_transaction_queue::Transaction;
+using Entry       = I2C_transaction_queue::Entry;
+
+uint8_t tx_data[64];
+uint8_t rx_data[64];
+
+Transaction get_transaction(uint16_t a_address, Priority a_priority, uint32_t a_tx_size = 1, uint32_t a_rx_size = 0)
+{
+    Transaction ret;
+
+    ret.address               = a_address;
+    ret.priority              = a_priority;
+    ret.p_tx_data             = tx_data;
+    ret.tx_data_size_in_bytes = a_tx_size;
+    ret.p_rx_data             = rx_data;
+    ret.rx_data_size_in_bytes = a_rx_size;
+
+    return ret;
+}
+
+std::vector<uint16_t> pop_all(I2C_transaction_queue* a_p_queue)
+{
+    std::vector<uint16_t> ret;
+
+    for (const Entry* p_entry = a_p_queue->pop(); nullptr != p_entry; p_entry = a_p_queue->pop())
+    {
+        REQUIRE(p_entry == a_p_queue->get_active());
+        ret.push_back(p_entry->transaction.address);
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("priority first, FIFO within a priority", "[I2C_transaction_queue]")
+{
+    Entry buffer[8];
+    I2C_transaction_queue queue(buffer, 8);
+
+    REQUIRE(nullptr == queue.pop());
+
+    queue.push(get_transaction(0x10, Priority::low), 0);
+    queue.push(get_transaction(0x20, Priority::normal), 0);
+    queue.push(get_transaction(0x30, Priority::high), 0);
+    queue.push(get_transaction(0x21, Priority::normal), 0);
+    queue.push(get_transaction(0x11, Priority::low), 0);
+    queue.push(get_transaction(0x31, Priority::high), 0);
+
+    REQUIRE(6 == queue.get_pending_count());
+    REQUIRE(pop_all(&queue) == std::vector<uint16_t> { 0x30, 0x31, 0x20, 0x21, 0x10, 0x11 });
+    REQUIRE(0 == queue.get_pending_count());
+    REQUIRE(nullptr == queue.get_active());
+
+    // entries freed by pop are reused, the order does not depend on the slot
+    queue.push(get_transaction(0x12, Priority::low), 0);
+    queue.push(get_transaction(0x13, Priority::low), 0);
+    queue.pop();
+    queue.push(get_transaction(0x14, Priority::low), 0);
+    queue.push(get_transaction(0x22, Priority::normal), 0);
+
+    REQUIRE(pop_all(&queue) == std::vector<uint16_t> { 0x22, 0x13, 0x14 });
+}
+
+TEST_CASE("the active entry is not reused", "[I2C_transaction_queue]")
+{
+    Entry buffer[3];
+    I2C_transaction_queue queue(buffer, 3);
+
+    REQUIRE(&(buffer[0]) == queue.push(get_transaction(0x10, Priority::normal), 100));
+    REQUIRE(&(buffer[1]) == queue.push(get_transaction(0x11, Priority::normal), 101));
+    REQUIRE(&(buffer[2]) == queue.push(get_transaction(0x12, Priority::normal), 102));
+    REQUIRE(nullptr == queue.push(get_transaction(0x13, Priority::high), 103));
+
+    REQUIRE(&(buffer[0]) == queue.pop());
+    REQUIRE(100 == buffer[0].submit_cycles);
+
+    // 2 pending, 1 active
+    REQUIRE(nullptr == queue.push(get_transaction(0x13, Priority::high), 104));
+
+    REQUIRE(&(buffer[1]) == queue.pop());
+    REQUIRE(&(buffer[0]) == queue.push(get_transaction(0x13, Priority::high), 105));
+
+    // cancel keeps the active transaction
+    queue.cancel_pending();
+
+    REQUIRE(0 == queue.get_pending_count());
+    REQUIRE(&(buffer[1]) == queue.get_active());
+    REQUIRE(nullptr == queue.pop());
+}
+
+TEST_CASE("sequence wrap around", "[I2C_transaction_queue]")
+{
+    Entry left;
+    Entry right;
+
+    left.sequence  = 0xFFFFFFFFu;
+    right.sequence = 0;
+
+    REQUIRE(true == I2C_transaction_queue::is_before(left, right));
+    REQUIRE(false == I2C_transaction_queue::is_before(right, left));
+    REQUIRE(false == I2C_transaction_queue::is_before(left, left));
+
+    right.transaction.priority = Priority::high;
+
+    REQUIRE(false == I2C_transaction_queue::is_before(left, right));
+    REQUIRE(true == I2C_transaction_queue::is_before(right, left));
+}
+
+TEST_CASE("transaction statistics", "[I2C_transaction_queue]")
+{
+    Statistics statistics;
+
+    I2C_transaction_queue::update_statistics(&statistics, false, 4, 300, 1000);
+    I2C_transaction_queue::update_statistics(&statistics, true, 1, 700, 200);
+    I2C_transaction_queue::update_statistics(&statistics, false, 2, 100, 500);
+
+    REQUIRE(3 == statistics.transactions);
+    REQUIRE(1 == statistics.errors);
+    REQUIRE(7 == statistics.bytes);
+    REQUIRE(1100 == statistics.wait_cycles);
+    REQUIRE(1700 == statistics.bus_cycles);
+    REQUIRE(700 == statistics.max_wait_cycles);
+}
+
+namespace {
+
+// 80 MHz SYSCLK, 400 kHz bus
+constexpr uint32_t cycles_per_bit = 200;
+constexpr uint32_t cycles_per_ms  = 80000;
+
+// START, address and data bytes with ACK, repeated START between write and read, STOP
+uint32_t get_bus_cycles(const Transaction& a_transaction)
+{
+    const uint32_t tx = a_transaction.tx_data_size_in_bytes;
+    const uint32_t rx = a_transaction.rx_data_size_in_bytes;
+
+    const uint32_t bits = 2 + (tx > 0 ? 9 * (1 + tx) : 0) + (rx > 0 ? 9 * (1 + rx) : 0) + (tx > 0 && rx > 0 ? 1 : 0);
+
+    return bits * cycles_per_bit;
+}
+
+struct Source
+{
+    Priority priority;
+
+    uint32_t period_cycles;
+    uint32_t phase_cycles;
+    uint32_t burst;
+
+    uint32_t tx_size;
+    uint32_t rx_size;
+
+    Statistics statistics;
+};
+
+struct Arrival
+{
+    uint32_t cycles;
+    uint32_t source;
+};
+
+struct Simulation
+{
+    uint32_t end_cycles     = 0;
+    uint64_t offered_cycles = 0;
+
+    Statistics total;
+    uint32_t max_pending = 0;
+};
+
+/*
+    Sources submit at their period, the bus runs the active transaction for get_bus_cycles() and the
+    next one is popped at its completion, as I2C_scheduler does from the DMA interrupt.
+    a_prioritized == false: every source submits with Priority::normal (plain FIFO).
+*/
+Simulation simulate(std::vector<Source>* a_p_sources, uint32_t a_duration_cycles, bool a_prioritized)
+{
+    Entry buffer[16];
+    I2C_transaction_queue queue(buffer, 16);
+
+    Simulation ret;
+    std::vector<Arrival> arrivals;
+
+    for (uint32_t i = 0; i < a_p_sources->size(); i++)
+    {
+        const Source& source = (*a_p_sources)[i];
+
+        for (uint32_t cycles = source.phase_cycles; cycles < a_duration_cycles; cycles += source.period_cycles)
+        {
+            for (uint32_t j = 0; j < source.burst; j++)
+            {
+                arrivals.push_back({ cycles, i });
+            }
+        }
+    }
+
+    std::stable_sort(arrivals.begin(), arrivals.end(), [](const Arrival& a_left, const Arrival& a_right) {
+        return a_left.cycles < a_right.cycles;
+    });
+
+    uint32_t now              = 0;
+    uint32_t active_start     = 0;
+    uint32_t active_end       = 0;
+    uint32_t last_sequence[3] = { 0, 0, 0 };
+    bool first[3]             = { true, true, true };
+    size_t next_arrival       = 0;
+
+    auto start_next = [&]() {
+        const Entry* p_next = queue.pop();
+
+        if (nullptr != p_next)
+        {
+            active_start = now;
+            active_end   = now + get_bus_cycles(p_next->transaction);
+        }
+    };
+
+    while (next_arrival < arrivals.size() || nullptr != queue.get_active())
+    {
+        const bool completion = nullptr != queue.get_active() &&
+                                (next_arrival == arrivals.size() || active_end <= arrivals[next_arrival].cycles);
+
+        if (true == completion)
+        {
+            now = active_end;
+
+            const Entry* p_finished = queue.get_active();
+            const uint32_t priority = static_cast<uint32_t>(p_finished->transaction.priority);
+            const uint32_t bytes    = p_finished->transaction.tx_data_size_in_bytes + p_finished->transaction.rx_data_size_in_bytes;
+            const uint32_t wait     = active_start - p_finished->submit_cycles;
+            const uint32_t bus      = now - active_start;
+
+            // FIFO within a priority
+            REQUIRE((true == first[priority] || p_finished->sequence > last_sequence[priority]));
+
+            first[priority]         = false;
+            last_sequence[priority] = p_finished->sequence;
+
+            I2C_transaction_queue::update_statistics(&(ret.total), false, bytes, wait, bus);
+            I2C_transaction_queue::update_statistics(p_finished->transaction.p_statistics, false, bytes, wait, bus);
+
+            start_next();
+        }
+        else
+        {
+            const Arrival& arrival = arrivals[next_arrival++];
+            Source* p_source       = &((*a_p_sources)[arrival.source]);
+
+            now = arrival.cycles;
+
+            Transaction transaction = get_transaction(0x10 + arrival.source,
+                                                      true == a_prioritized ? p_source->priority : Priority::normal,
+                                                      p_source->tx_size,
+                                                      p_source->rx_size);
+            transaction.p_statistics = &(p_source->statistics);
+
+            ret.offered_cycles += get_bus_cycles(transaction);
+
+            REQUIRE(nullptr != queue.push(transaction, now));
+
+            if (nullptr == queue.get_active())
+            {
+                start_next();
+            }
+        }
+
+        // the bus is never idle with a transaction pending
+        REQUIRE((0 == queue.get_pending_count() || nullptr != queue.get_active()));
+
+        ret.max_pending = std::max(ret.max_pending, queue.get_pending_count());
+    }
+
+    ret.end_cycles = now;
+
+    return ret;
+}
+
+std::vector<Source> get_mixed_workload()
+{
+    return {
+        // sensor: register pointer write, 2 bytes read every 1 ms
+        { Priority::high, 1 * cycles_per_ms, 0, 1, 1, 2 },
+        // actuator: 4 bytes write every 2.5 ms
+        { Priority::normal, 5 * cycles_per_ms / 2, cycles_per_ms / 4, 1, 4, 0 },
+        // EEPROM: 4 pages of 32 bytes (+ 2 address bytes) every 10 ms
+        { Priority::low, 10 * cycles_per_ms, cycles_per_ms / 10, 4, 34, 0 },
+        // log: 16 bytes read every 5 ms
+        { Priority::low, 5 * cycles_per_ms, 3 * cycles_per_ms / 10, 1, 0, 16 }
+    };
+}
+
+} // namespace ::
+
+TEST_CASE("bus utilisation under a mixed workload", "[I2C_transaction_queue]")
+{
+    const uint32_t duration = 1000 * cycles_per_ms;
+
+    std::vector<Source> prioritized = get_mixed_workload();
+    std::vector<Source> fifo        = get_mixed_workload();
+
+    const Simulation with_priorities    = simulate(&prioritized, duration, true);
+    const Simulation without_priorities = simulate(&fifo, duration, false);
+
+    const uint32_t longest = get_bus_cycles(get_transaction(0, Priority::low, 34, 0));
+
+    const double utilisation = static_cast<double>(with_priorities.total.bus_cycles) / with_priorities.end_cycles;
+
+    INFO("bus utilisation: " << utilisation);
+    INFO("sensor max wait, prioritized: " << prioritized[0].statistics.max_wait_cycles
+         << " cycles, FIFO: " << fifo[0].statistics.max_wait_cycles << " cycles");
+
+    // every submitted transaction ran, the bus is busy only for the transactions
+    REQUIRE(1000 + 400 + 400 + 200 == with_priorities.total.transactions);
+    REQUIRE(with_priorities.offered_cycles == with_priorities.total.bus_cycles);
+    REQUIRE(with_priorities.total.bus_cycles == without_priorities.total.bus_cycles);
+    REQUIRE(utilisation > 0.5);
+    REQUIRE(utilisation < 0.6);
+
+    // ordering does not change the utilisation, only who waits
+    REQUIRE(with_priorities.end_cycles == without_priorities.end_cycles);
+
+    // the high priority source waits at most for the transaction on the bus
+    REQUIRE(prioritized[0].statistics.max_wait_cycles < longest);
+    REQUIRE(fifo[0].statistics.max_wait_cycles > 2 * longest);
+    REQUIRE(prioritized[0].statistics.wait_cycles < fifo[0].statistics.wait_cycles);
+
+    // the EEPROM bursts pay for it
+    REQUIRE(prioritized[2].statistics.wait_cycles > fifo[2].statistics.wait_cycles);
+
+    for (const Source& source : prioritized)
+    {
+        REQUIRE(source.statistics.transactions == (duration - source.phase_cycles + source.period_cycles - 1) / source.period_cycles * source.burst);
+        REQUIRE(source.statistics.bytes == source.statistics.transactions * (source.tx_size + source.rx_size));
+    }
+
+    REQUIRE(with_priorities.max_pending < 16);
+}
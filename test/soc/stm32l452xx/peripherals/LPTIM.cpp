@@ -0,0 +1,102 @@
+/*
+    Name: LPTIM.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/stm32l452xx/peripherals/LPTIM.hpp>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using soc::stm32l452xx::peripherals::LPTIM;
+using Config    = LPTIM::Config;
+using Prescaler = LPTIM::Prescaler;
+
+static_assert(Prescaler::_1 == LPTIM::calculate_config(32768u, 1u, LPTIM::Clock_source::lse).prescaler);
+static_assert(32767u == LPTIM::calculate_config(32768u, 1u, LPTIM::Clock_source::lse).auto_reload);
+
+} // namespace ::
+
+TEST_CASE("LPTIM calculate_config table", "[LPTIM]")
+{
+    struct Row
+    {
+        uint32_t clock_hz, rate_hz;
+        Prescaler prescaler;
+        uint16_t auto_reload;
+        uint32_t update_frequency_hz; // truncated
+    };
+
+    const Row rows[] = {
+        { 32768,    1,       Prescaler::_1,   32767,  1 },
+        { 32768,    1000,    Prescaler::_1,   32,     992 },
+        { 32000,    1,       Prescaler::_1,   31999,  1 },
+        { 80000000, 1000,    Prescaler::_2,   39999,  1000 },
+        { 80000000, 1221,    Prescaler::_1,   65519,  1221 },
+        { 80000000, 1220,    Prescaler::_2,   32786,  1219 },
+        { 16000000, 2,       Prescaler::_128, 62499,  2 },
+        { 16000000, 3,       Prescaler::_128, 41666,  2 },
+        { 16000000, 31,      Prescaler::_8,   64515,  31 },
+        { 4000000,  1000000, Prescaler::_1,   3,      1000000 },
+    };
+
+    for (const Row& row : rows)
+    {
+        INFO(row.clock_hz << " Hz / " << row.rate_hz << " Hz");
+
+        const Config config = LPTIM::calculate_config(row.clock_hz, row.rate_hz);
+
+        REQUIRE(row.prescaler == config.prescaler);
+        REQUIRE(row.auto_reload == config.auto_reload);
+        REQUIRE(LPTIM::Clock_source::pclk == config.clock_source);
+        REQUIRE(LPTIM::Polarity::active_high == config.polarity);
+        REQUIRE(row.update_frequency_hz == LPTIM::get_update_frequency_hz(row.clock_hz, config));
+    }
+}
+
+TEST_CASE("LPTIM period limits", "[LPTIM]")
+{
+    // slower than clock / 128 / 65536: the longest period
+    const Config slowest = LPTIM::calculate_config(cml::MHz(80), 1u);
+
+    REQUIRE(Prescaler::_128 == slowest.prescaler);
+    REQUIRE(0xFFFFu == slowest.auto_reload);
+    REQUIRE(9u == LPTIM::get_update_frequency_hz(cml::MHz(80), slowest));
+
+    // one tick or less: the shortest period, compare has to stay below auto-reload
+    const uint32_t rate_hz = GENERATE(2000000u, 3000000u, 4000000u, 9000000u);
+    const Config fastest   = LPTIM::calculate_config(cml::MHz(4), rate_hz);
+
+    INFO(rate_hz);
+    REQUIRE(Prescaler::_1 == fastest.prescaler);
+    REQUIRE(1 == fastest.auto_reload);
+    REQUIRE(2000000u == LPTIM::get_update_frequency_hz(cml::MHz(4), fastest));
+    REQUIRE(0 == LPTIM::calculate_compare(fastest, 5000));
+}
+
+TEST_CASE("LPTIM calculate_compare", "[LPTIM]")
+{
+    Config config;
+
+    config.auto_reload = 99;
+
+    // active from the compare match to the auto-reload match
+    REQUIRE(74 == LPTIM::calculate_compare(config, 2500));
+    REQUIRE(49 == LPTIM::calculate_compare(config, 5000));
+    REQUIRE(98 == LPTIM::calculate_compare(config, 100));
+    REQUIRE(1 == LPTIM::calculate_compare(config, 9800));
+
+    // at least 1 tick active, compare below auto-reload
+    REQUIRE(98 == LPTIM::calculate_compare(config, 0));
+    REQUIRE(0 == LPTIM::calculate_compare(config, 9900));
+    REQUIRE(0 == LPTIM::calculate_compare(config, 10000));
+
+    config.auto_reload = 0xFFFFu;
+
+    REQUIRE(0x7FFFu == LPTIM::calculate_compare(config, 5000));
+}
@@ -0,0 +1,124 @@
+/*
+    Name: TIM.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/stm32l452xx/peripherals/TIM.hpp>
+
+//std
+#include <cmath>
+
+//externals
+#include <catch.hpp>
+
+namespace {
+
+using soc::stm32l452xx::peripherals::TIM;
+using Config = TIM::Config;
+
+constexpr uint32_t tim_2_max  = 0xFFFFFFFFu;
+constexpr uint32_t tim_15_max = 0xFFFFu;
+
+static_assert(0 == TIM::calculate_config(cml::MHz(80), 1u, tim_2_max).prescaler);
+static_assert(79999999u == TIM::calculate_config(cml::MHz(80), 1u, tim_2_max).auto_reload);
+static_assert(1u == TIM::get_update_frequency_hz(cml::MHz(80), TIM::calculate_config(cml::MHz(80), 1u, tim_2_max)));
+
+} // namespace ::
+
+TEST_CASE("TIM calculate_config table", "[TIM]")
+{
+    struct Row
+    {
+        uint32_t clock_hz, rate_hz, counter_max;
+        uint16_t prescaler;
+        uint32_t auto_reload;
+        uint32_t update_frequency_hz; // truncated
+    };
+
+    const Row rows[] = {
+        { 80000000,   1,       tim_2_max,  0,     79999999, 1 },
+        { 80000000,   1,       tim_15_max, 1220,  65519,    1 },
+        { 80000000,   1000,    tim_15_max, 1,     39999,    1000 },
+        { 80000000,   20000,   tim_15_max, 0,     3999,     20000 },
+        { 80000000,   3,       tim_15_max, 406,   65519,    3 },
+        { 16000000,   50,      tim_15_max, 4,     63999,    50 },
+        { 16000000,   244,     tim_15_max, 1,     32786,    243 },
+        { 32768,      1,       tim_15_max, 0,     32767,    1 },
+        { 4000000,    7,       tim_2_max,  0,     571428,   6 },
+        { 1000000,    333333,  tim_15_max, 0,     2,        333333 },
+    };
+
+    for (const Row& row : rows)
+    {
+        INFO(row.clock_hz << " Hz / " << row.rate_hz << " Hz, counter max " << row.counter_max);
+
+        const Config config = TIM::calculate_config(row.clock_hz, row.rate_hz, row.counter_max);
+
+        REQUIRE(row.prescaler == config.prescaler);
+        REQUIRE(row.auto_reload == config.auto_reload);
+        REQUIRE(config.auto_reload <= row.counter_max);
+        REQUIRE(false == config.one_pulse);
+        REQUIRE(row.update_frequency_hz == TIM::get_update_frequency_hz(row.clock_hz, config));
+
+        // period rounded to the nearest count of the prescaled clock
+        const double period_s = (config.prescaler + 1.0) * (config.auto_reload + 1.0) / row.clock_hz;
+        REQUIRE(std::fabs(period_s - 1.0 / row.rate_hz) <= (config.prescaler + 1.0) / (2.0 * row.clock_hz) + 1e-12);
+    }
+}
+
+TEST_CASE("TIM15 prescaler stays in 16 bits", "[TIM]")
+{
+    // the slowest rate of the widest clocks: ticks up to 2^32, TIM15 needs the whole 16-bit prescaler
+    const uint32_t clock_hz = GENERATE(cml::MHz(80), 0x80000000u, 0xFFFFFFFEu, 0xFFFFFFFFu);
+    const uint32_t rate_hz  = GENERATE(1u, 2u, 3u);
+
+    INFO(clock_hz << " Hz / " << rate_hz << " Hz");
+
+    const Config config = TIM::calculate_config(clock_hz, rate_hz, tim_15_max);
+
+    const uint64_t ticks     = (static_cast<uint64_t>(clock_hz) + rate_hz / 2) / rate_hz;
+    const uint64_t prescaler = (ticks - 1) / 0x10000u;
+
+    REQUIRE(prescaler <= 0xFFFFu);
+    REQUIRE(prescaler == config.prescaler);
+    REQUIRE(config.auto_reload <= tim_15_max);
+    REQUIRE(std::fabs((config.prescaler + 1.0) * (config.auto_reload + 1.0) - static_cast<double>(clock_hz) / rate_hz) <=
+            (config.prescaler + 1.0) / 2.0 + 0.5);
+}
+
+TEST_CASE("TIM period of one tick or less", "[TIM]")
+{
+    // rate at or above half of the clock: the shortest period, auto-reload 0 stops the counter
+    const uint32_t rate_hz = GENERATE(500000u, 666666u, 1000000u, 1500000u, 3000000u, 0xFFFFFFFFu);
+
+    INFO(rate_hz);
+
+    const Config config = TIM::calculate_config(cml::MHz(1), rate_hz, tim_15_max);
+
+    REQUIRE(0 == config.prescaler);
+    REQUIRE(1 == config.auto_reload);
+    REQUIRE(500000u == TIM::get_update_frequency_hz(cml::MHz(1), config));
+}
+
+TEST_CASE("TIM calculate_compare", "[TIM]")
+{
+    Config config;
+
+    config.auto_reload = 999;
+
+    REQUIRE(0 == TIM::calculate_compare(config, 0));
+    REQUIRE(1 == TIM::calculate_compare(config, 10));
+    REQUIRE(0 == TIM::calculate_compare(config, 4));
+    REQUIRE(1 == TIM::calculate_compare(config, 5));
+    REQUIRE(250 == TIM::calculate_compare(config, 2500));
+    REQUIRE(1000 == TIM::calculate_compare(config, 10000));
+
+    // 32-bit TIM2 auto-reload, no overflow of the product
+    config.auto_reload = 0xFFFFFFFEu;
+
+    REQUIRE(0x80000000u == TIM::calculate_compare(config, 5000));
+    REQUIRE(0xFFFFFFFFu == TIM::calculate_compare(config, 10000));
+}